@@ -0,0 +1,67 @@
+#ifndef VIREALIS_BENCHMARK_H
+#define VIREALIS_BENCHMARK_H
+
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <string>
+
+namespace virealis::benchmark {
+
+// Runs func once to warm up, then returns the average wall time of one call in milliseconds
+template <typename Func>
+double measureMilliseconds(int iterations, Func&& func) {
+    func();
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        func();
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::milli>(end - start).count() / iterations;
+}
+
+// Like measureMilliseconds, but runs setup before every call without timing it
+template <typename Setup, typename Func>
+double measureMilliseconds(int iterations, Setup&& setup, Func&& func) {
+    setup();
+    func();
+
+    double total = 0.0;
+    for (int i = 0; i < iterations; ++i) {
+        setup();
+        auto start = std::chrono::steady_clock::now();
+        func();
+        auto end = std::chrono::steady_clock::now();
+        total += std::chrono::duration<double, std::milli>(end - start).count();
+    }
+    return total / iterations;
+}
+
+inline void report(const std::string& name, size_t count, double milliseconds) {
+    std::cout << std::left << std::setw(40) << name
+              << std::right << std::setw(10) << count
+              << std::setw(14) << std::fixed << std::setprecision(3) << milliseconds << " ms"
+              << std::endl;
+}
+
+// Reports how many items per second were processed when count items took the given time
+inline void reportThroughput(const std::string& name, size_t count, double milliseconds) {
+    double perSecond = count / (milliseconds / 1000.0);
+    std::cout << std::left << std::setw(40) << name
+              << std::right << std::setw(10) << count
+              << std::setw(14) << std::fixed << std::setprecision(3) << milliseconds << " ms"
+              << std::setw(12) << std::setprecision(2) << perSecond / 1.0e6 << " M/s"
+              << std::endl;
+}
+
+// Keeps the optimizer from discarding a computed value
+template <typename T>
+inline void doNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+} // namespace virealis::benchmark
+
+#endif // VIREALIS_BENCHMARK_H
@@ -0,0 +1,64 @@
+#include "Benchmark.hpp"
+#include <virealis/Scene/Scene.hpp>
+#include <algorithm>
+#include <deque>
+
+using namespace virealis;
+
+/*
+Spawns and destroys short-lived entities the way particle and debris systems do.
+
+A scene holds a steady population of live entities. Each frame the oldest batch is
+destroyed and a fresh batch is spawned, so indices are recycled continuously. The
+benchmark churns 1M entities through the scene and reports spawn+destroy pairs per
+second, once for bare entities and once with transform and material components.
+*/
+
+namespace {
+
+constexpr size_t Population = 100'000;
+constexpr size_t BatchSize = 16'384;
+constexpr size_t TotalChurn = 1'000'000;
+
+template <typename Spawn>
+double churn(Scene& scene, Spawn&& spawn) {
+    std::deque<Entity> live;
+    for (size_t i = 0; i < Population; ++i) {
+        live.push_back(spawn(scene));
+    }
+
+    return benchmark::measureMilliseconds(1, [&] {
+        // The last batch is shorter, so exactly TotalChurn pairs are timed
+        for (size_t done = 0; done < TotalChurn; done += BatchSize) {
+            const size_t count = std::min(BatchSize, TotalChurn - done);
+            for (size_t i = 0; i < count; ++i) {
+                scene.destroyEntity(live.front());
+                live.pop_front();
+            }
+            for (size_t i = 0; i < count; ++i) {
+                live.push_back(spawn(scene));
+            }
+        }
+    });
+}
+
+} // namespace
+
+int main() {
+    {
+        Scene scene;
+        double time = churn(scene, [](Scene& s) { return s.createEntity(); });
+        benchmark::reportThroughput("spawn+destroy entity", TotalChurn, time);
+    }
+    {
+        Scene scene;
+        double time = churn(scene, [](Scene& s) {
+            Entity entity = s.createEntity();
+            s.getTransformManager().create(entity, Matrix4x4::identity());
+            s.getMaterialManager().create(entity, {1.0f, 1.0f, 1.0f}, {1.0f, 1.0f, 1.0f}, 8.0f);
+            return entity;
+        });
+        benchmark::reportThroughput("spawn+destroy with transform+material", TotalChurn, time);
+    }
+    return 0;
+}
@@ -0,0 +1,349 @@
+#include "Benchmark.hpp"
+#include <virealis/Math/FastMath.hpp>
+#include <virealis/Math/Matrix3x4.hpp>
+#include <virealis/Math/Matrix4x4.hpp>
+#include <virealis/Math/Quaternion.hpp>
+#include <virealis/Math/Simd.hpp>
+#include <virealis/Math/Vec3Packet.hpp>
+#include <virealis/Math/Vector3A.hpp>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace virealis;
+
+/*
+Throughput of the math operations on every SIMD path this CPU supports.
+
+Works on arrays of 4096 random matrices or vectors (small enough to stay in cache, so
+the kernels rather than memory are measured): pairwise Matrix4x4 and Matrix3x4 products,
+one Matrix4x4 times an array as the renderer does for MVP matrices, point transforms,
+normalization, inverses, and quaternion slerp and conversion to matrices. Inverses are
+taken of rigid transforms, so that the general, affine and rigid paths all apply and can
+be compared. Vector3 normalization is also timed through the Vec3x4 and Vec3x8 packets,
+and the FastMath batch functions, at both precisions, against loops calling <cmath>.
+The batch kernels run on each runtime path; the loops over the inline operations and
+packets run on the path the build targets (see VIREALIS_SIMD in CMakeLists.txt) and are
+the baseline.
+*/
+
+namespace {
+
+constexpr size_t MatrixCount = 4096;
+constexpr int Iterations = 200;
+
+template <typename Matrix, int Rows>
+std::vector<Matrix> randomMatrices(std::mt19937& rng) {
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    std::vector<Matrix> matrices(MatrixCount);
+    for (Matrix& matrix : matrices) {
+        for (int row = 0; row < Rows; ++row) {
+            for (int col = 0; col < 4; ++col) {
+                matrix(row, col) = distribution(rng);
+            }
+        }
+    }
+    return matrices;
+}
+
+template <typename Matrix>
+void benchmarkOperator(const std::string& name, const std::vector<Matrix>& a, const std::vector<Matrix>& b,
+                       std::vector<Matrix>& out) {
+    double time = benchmark::measureMilliseconds(Iterations, [&] {
+        for (size_t i = 0; i < MatrixCount; ++i) {
+            out[i] = a[i] * b[i];
+        }
+        benchmark::doNotOptimize(out.data());
+    });
+    benchmark::reportThroughput(name + ", operator* (" + SimdBuildTarget + ")", MatrixCount, time);
+}
+
+std::vector<Matrix4x4> randomRigidTransforms(std::mt19937& rng) {
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    std::vector<Matrix4x4> matrices(MatrixCount);
+    for (Matrix4x4& matrix : matrices) {
+        const Vector3 axis = Vector3(distribution(rng), distribution(rng), distribution(rng) + 2.0f).normalized();
+        const Vector3 translation(distribution(rng), distribution(rng), distribution(rng));
+        matrix = Matrix3x4::fromTranslationRotationScale(translation, Quaternion::fromAxisAngle(axis, distribution(rng)),
+                                                         Vector3(1.0f, 1.0f, 1.0f)).toMatrix4x4();
+    }
+    return matrices;
+}
+
+template <typename Inverse>
+void benchmarkInverse(const std::string& name, const std::vector<Matrix4x4>& in, std::vector<Matrix4x4>& out,
+                      Inverse inverse) {
+    double time = benchmark::measureMilliseconds(Iterations, [&] {
+        for (size_t i = 0; i < MatrixCount; ++i) {
+            out[i] = inverse(in[i]);
+        }
+        benchmark::doNotOptimize(out.data());
+    });
+    benchmark::reportThroughput(name, MatrixCount, time);
+}
+
+std::vector<Quaternion> randomRotations(std::mt19937& rng) {
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    std::vector<Quaternion> rotations(MatrixCount);
+    for (Quaternion& rotation : rotations) {
+        rotation = Quaternion(distribution(rng), distribution(rng), distribution(rng), distribution(rng) + 2.0f).normalized();
+    }
+    return rotations;
+}
+
+std::vector<Vector3A> randomPoints(std::mt19937& rng) {
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    std::vector<Vector3A> points(MatrixCount);
+    for (Vector3A& point : points) {
+        point = Vector3A(distribution(rng), distribution(rng), distribution(rng));
+    }
+    return points;
+}
+
+template <typename Packet>
+void benchmarkPacketNormalize(const std::string& name, const std::vector<Vector3>& in, std::vector<Vector3>& out) {
+    double time = benchmark::measureMilliseconds(Iterations, [&] {
+        for (size_t i = 0; i < MatrixCount; i += Packet::Width) {
+            Packet::load(&in[i]).normalized().store(&out[i]);
+        }
+        benchmark::doNotOptimize(out.data());
+    });
+    benchmark::reportThroughput(name, MatrixCount, time);
+}
+
+struct FunctionInputs {
+    std::vector<float> angles;    // [-10, 10], a few turns either way
+    std::vector<float> exponents; // [-10, 10]
+    std::vector<float> positives; // (0, 100]
+    std::vector<float> ys, xs;    // [-1, 1]
+    std::vector<float> cosines;   // [-1, 1]
+};
+
+FunctionInputs randomFunctionInputs(std::mt19937& rng) {
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    FunctionInputs inputs;
+    for (size_t i = 0; i < MatrixCount; ++i) {
+        inputs.angles.push_back(10.0f * distribution(rng));
+        inputs.exponents.push_back(10.0f * distribution(rng));
+        inputs.positives.push_back(50.0f * (distribution(rng) + 1.0f) + 1e-3f);
+        inputs.ys.push_back(distribution(rng));
+        inputs.xs.push_back(distribution(rng));
+        inputs.cosines.push_back(distribution(rng));
+    }
+    return inputs;
+}
+
+void benchmarkStandardFunctions(const FunctionInputs& in, std::vector<float>& a, std::vector<float>& b) {
+    double timeSincos = benchmark::measureMilliseconds(Iterations, [&] {
+        for (size_t i = 0; i < MatrixCount; ++i) {
+            a[i] = std::sin(in.angles[i]);
+            b[i] = std::cos(in.angles[i]);
+        }
+        benchmark::doNotOptimize(a.data());
+        benchmark::doNotOptimize(b.data());
+    });
+    benchmark::reportThroughput("std::sin + std::cos", MatrixCount, timeSincos);
+
+    double timeExp = benchmark::measureMilliseconds(Iterations, [&] {
+        for (size_t i = 0; i < MatrixCount; ++i) {
+            a[i] = std::exp(in.exponents[i]);
+        }
+        benchmark::doNotOptimize(a.data());
+    });
+    benchmark::reportThroughput("std::exp", MatrixCount, timeExp);
+
+    double timeRsqrt = benchmark::measureMilliseconds(Iterations, [&] {
+        for (size_t i = 0; i < MatrixCount; ++i) {
+            a[i] = 1.0f / std::sqrt(in.positives[i]);
+        }
+        benchmark::doNotOptimize(a.data());
+    });
+    benchmark::reportThroughput("1 / std::sqrt", MatrixCount, timeRsqrt);
+
+    double timeAtan2 = benchmark::measureMilliseconds(Iterations, [&] {
+        for (size_t i = 0; i < MatrixCount; ++i) {
+            a[i] = std::atan2(in.ys[i], in.xs[i]);
+        }
+        benchmark::doNotOptimize(a.data());
+    });
+    benchmark::reportThroughput("std::atan2", MatrixCount, timeAtan2);
+
+    double timeAcos = benchmark::measureMilliseconds(Iterations, [&] {
+        for (size_t i = 0; i < MatrixCount; ++i) {
+            a[i] = std::acos(in.cosines[i]);
+        }
+        benchmark::doNotOptimize(a.data());
+    });
+    benchmark::reportThroughput("std::acos", MatrixCount, timeAcos);
+}
+
+void benchmarkFastFunctions(const std::string& suffix, FastMath::Precision precision, const FunctionInputs& in,
+                            std::vector<float>& a, std::vector<float>& b) {
+    double timeSincos = benchmark::measureMilliseconds(Iterations, [&] {
+        FastMath::sincos(in.angles, a, b, precision);
+        benchmark::doNotOptimize(a.data());
+        benchmark::doNotOptimize(b.data());
+    });
+    benchmark::reportThroughput("FastMath::sincos, " + suffix, MatrixCount, timeSincos);
+
+    double timeExp = benchmark::measureMilliseconds(Iterations, [&] {
+        FastMath::exp(in.exponents, a, precision);
+        benchmark::doNotOptimize(a.data());
+    });
+    benchmark::reportThroughput("FastMath::exp, " + suffix, MatrixCount, timeExp);
+
+    double timeRsqrt = benchmark::measureMilliseconds(Iterations, [&] {
+        FastMath::rsqrt(in.positives, a, precision);
+        benchmark::doNotOptimize(a.data());
+    });
+    benchmark::reportThroughput("FastMath::rsqrt, " + suffix, MatrixCount, timeRsqrt);
+
+    double timeAtan2 = benchmark::measureMilliseconds(Iterations, [&] {
+        FastMath::atan2(in.ys, in.xs, a, precision);
+        benchmark::doNotOptimize(a.data());
+    });
+    benchmark::reportThroughput("FastMath::atan2, " + suffix, MatrixCount, timeAtan2);
+
+    double timeAcos = benchmark::measureMilliseconds(Iterations, [&] {
+        FastMath::acos(in.cosines, a, precision);
+        benchmark::doNotOptimize(a.data());
+    });
+    benchmark::reportThroughput("FastMath::acos, " + suffix, MatrixCount, timeAcos);
+}
+
+} // namespace
+
+int main() {
+    std::mt19937 rng(11);
+    std::vector<Matrix4x4> a4 = randomMatrices<Matrix4x4, 4>(rng);
+    std::vector<Matrix4x4> b4 = randomMatrices<Matrix4x4, 4>(rng);
+    std::vector<Matrix4x4> out4(MatrixCount);
+    std::vector<Matrix3x4> a3 = randomMatrices<Matrix3x4, 3>(rng);
+    std::vector<Matrix3x4> b3 = randomMatrices<Matrix3x4, 3>(rng);
+    std::vector<Matrix3x4> out3(MatrixCount);
+
+    benchmarkOperator("Matrix4x4", a4, b4, out4);
+    benchmarkOperator("Matrix3x4", a3, b3, out3);
+
+    std::vector<Vector3A> points = randomPoints(rng);
+    std::vector<Vector3A> outPoints(MatrixCount);
+    const std::string buildTarget = SimdBuildTarget;
+
+    double timeTransform = benchmark::measureMilliseconds(Iterations, [&] {
+        for (size_t i = 0; i < MatrixCount; ++i) {
+            outPoints[i] = a4[0].transformPoint(points[i]);
+        }
+        benchmark::doNotOptimize(outPoints.data());
+    });
+    benchmark::reportThroughput("transformPoint (" + buildTarget + ")", MatrixCount, timeTransform);
+
+    double timeNormalize = benchmark::measureMilliseconds(Iterations, [&] {
+        for (size_t i = 0; i < MatrixCount; ++i) {
+            outPoints[i] = points[i].normalized();
+        }
+        benchmark::doNotOptimize(outPoints.data());
+    });
+    benchmark::reportThroughput("normalized (" + buildTarget + ")", MatrixCount, timeNormalize);
+
+    std::vector<Vector3> vectors(MatrixCount);
+    std::vector<Vector3> outVectors(MatrixCount);
+    for (size_t i = 0; i < MatrixCount; ++i) {
+        vectors[i] = Vector3(points[i].x, points[i].y, points[i].z);
+    }
+
+    double timeVector3 = benchmark::measureMilliseconds(Iterations, [&] {
+        for (size_t i = 0; i < MatrixCount; ++i) {
+            outVectors[i] = vectors[i].normalized();
+        }
+        benchmark::doNotOptimize(outVectors.data());
+    });
+    benchmark::reportThroughput("Vector3::normalized", MatrixCount, timeVector3);
+
+    benchmarkPacketNormalize<Vec3x4>("Vec3x4::normalized (" + buildTarget + ")", vectors, outVectors);
+    benchmarkPacketNormalize<Vec3x8>("Vec3x8::normalized (" + buildTarget + ")", vectors, outVectors);
+
+    std::vector<Matrix4x4> rigid = randomRigidTransforms(rng);
+    benchmarkInverse("inverse()", rigid, out4, [](const Matrix4x4& m) { return m.inverse(); });
+    benchmarkInverse("inverseAffine() (" + buildTarget + ")", rigid, out4,
+                     [](const Matrix4x4& m) { return m.inverseAffine(); });
+    benchmarkInverse("inverseRigid() (" + buildTarget + ")", rigid, out4,
+                     [](const Matrix4x4& m) { return m.inverseRigid(); });
+
+    std::vector<Quaternion> rotationsA = randomRotations(rng);
+    std::vector<Quaternion> rotationsB = randomRotations(rng);
+    std::vector<Quaternion> outRotations(MatrixCount);
+
+    double timeSlerp = benchmark::measureMilliseconds(Iterations, [&] {
+        for (size_t i = 0; i < MatrixCount; ++i) {
+            outRotations[i] = Quaternion::slerp(rotationsA[i], rotationsB[i], 0.3f);
+        }
+        benchmark::doNotOptimize(outRotations.data());
+    });
+    benchmark::reportThroughput("Quaternion::slerp", MatrixCount, timeSlerp);
+
+    const FunctionInputs functionInputs = randomFunctionInputs(rng);
+    std::vector<float> outA(MatrixCount);
+    std::vector<float> outB(MatrixCount);
+    benchmarkStandardFunctions(functionInputs, outA, outB);
+
+    for (SimdPath path : { SimdPath::Scalar, SimdPath::SSE, SimdPath::AVX2 }) {
+        if (setSimdPath(path) != path) {
+            continue; // Not supported by this CPU
+        }
+        const std::string pathName = getSimdPathName(path);
+
+        double time4 = benchmark::measureMilliseconds(Iterations, [&] {
+            Matrix4x4::multiplyArrays(a4.data(), b4.data(), out4.data(), MatrixCount);
+            benchmark::doNotOptimize(out4.data());
+        });
+        benchmark::reportThroughput("Matrix4x4, " + pathName, MatrixCount, time4);
+
+        double timeSingle = benchmark::measureMilliseconds(Iterations, [&] {
+            Matrix4x4::multiplyArrays(a4[0], b4.data(), out4.data(), MatrixCount);
+            benchmark::doNotOptimize(out4.data());
+        });
+        benchmark::reportThroughput("Matrix4x4 one-to-many, " + pathName, MatrixCount, timeSingle);
+
+        double time3 = benchmark::measureMilliseconds(Iterations, [&] {
+            Matrix3x4::multiplyArrays(a3.data(), b3.data(), out3.data(), MatrixCount);
+            benchmark::doNotOptimize(out3.data());
+        });
+        benchmark::reportThroughput("Matrix3x4, " + pathName, MatrixCount, time3);
+
+        double timePoints = benchmark::measureMilliseconds(Iterations, [&] {
+            Matrix4x4::transformPoints(a4[0], points.data(), outPoints.data(), MatrixCount);
+            benchmark::doNotOptimize(outPoints.data());
+        });
+        benchmark::reportThroughput("transformPoints, " + pathName, MatrixCount, timePoints);
+
+        double timeNormalizeArray = benchmark::measureMilliseconds(Iterations, [&] {
+            Vector3A::normalizeArray(points.data(), outPoints.data(), MatrixCount);
+            benchmark::doNotOptimize(outPoints.data());
+        });
+        benchmark::reportThroughput("normalizeArray, " + pathName, MatrixCount, timeNormalizeArray);
+
+        double timeInverse = benchmark::measureMilliseconds(Iterations, [&] {
+            Matrix4x4::inverseArrays(rigid.data(), out4.data(), MatrixCount);
+            benchmark::doNotOptimize(out4.data());
+        });
+        benchmark::reportThroughput("inverseArrays, " + pathName, MatrixCount, timeInverse);
+
+        double timeSlerpArrays = benchmark::measureMilliseconds(Iterations, [&] {
+            Quaternion::slerpArrays(rotationsA.data(), rotationsB.data(), 0.3f, outRotations.data(), MatrixCount);
+            benchmark::doNotOptimize(outRotations.data());
+        });
+        benchmark::reportThroughput("slerpArrays, " + pathName, MatrixCount, timeSlerpArrays);
+
+        double timeToMatrices = benchmark::measureMilliseconds(Iterations, [&] {
+            Quaternion::toRotationMatrices(rotationsA.data(), out3.data(), MatrixCount);
+            benchmark::doNotOptimize(out3.data());
+        });
+        benchmark::reportThroughput("toRotationMatrices, " + pathName, MatrixCount, timeToMatrices);
+
+        benchmarkFastFunctions(pathName + " precise", FastMath::Precision::Precise, functionInputs, outA, outB);
+        benchmarkFastFunctions(pathName + " fast", FastMath::Precision::Fast, functionInputs, outA, outB);
+    }
+    setSimdPath(getSupportedSimdPath());
+    return 0;
+}
@@ -0,0 +1,146 @@
+#include "Benchmark.hpp"
+#include <virealis/Scene/Scene.hpp>
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace virealis;
+
+/*
+World transform propagation over a skeleton-style hierarchy of 100-bone skeletons.
+Each bone usually continues the chain of the previous bone and sometimes branches off an
+earlier one, like limbs off a spine. Transforms are created in shuffled order so storage
+order says nothing about the hierarchy.
+
+With 1000 skeletons (100k bones): every skeleton animated, 1% of skeletons animated
+(only their subtrees are rebuilt), and a settled scene where nothing moved. With 10000
+skeletons (1M bones): a full update on a thread pool of increasing size, timing only
+updateTransforms. Last, Scene::destroySubtree on 100k pieces of debris under one parent
+and on every skeleton in turn.
+*/
+
+namespace {
+
+constexpr size_t BonesPerSkeleton = 100;
+
+std::vector<Entity> buildSkeletons(Scene& scene, size_t skeletonCount) {
+    const size_t count = skeletonCount * BonesPerSkeleton;
+    std::span<const Entity> created = scene.createEntities(count);
+    std::vector<Entity> bones(created.begin(), created.end());
+    TransformComponentManager& transforms = scene.getTransformManager();
+
+    std::mt19937 rng(7);
+    std::vector<Entity> shuffled = bones;
+    std::shuffle(shuffled.begin(), shuffled.end(), rng);
+    transforms.reserve(count);
+    for (const Entity& bone : shuffled) {
+        transforms.create(bone, Vector3(0.0f, 0.1f, 0.0f));
+    }
+
+    for (size_t skeleton = 0; skeleton < skeletonCount; ++skeleton) {
+        const size_t first = skeleton * BonesPerSkeleton;
+        for (size_t bone = 1; bone < BonesPerSkeleton; ++bone) {
+            size_t parent = (rng() % 5 != 0) ? bone - 1 : rng() % bone;
+            transforms.setParent(bones[first + bone], bones[first + parent]);
+        }
+    }
+    return bones;
+}
+
+// Animating a skeleton rewrites the local position of every bone
+void animate(TransformComponentManager& transforms, const std::vector<Entity>& bones, size_t skeletonCount) {
+    for (size_t bone = 0; bone < skeletonCount * BonesPerSkeleton; ++bone) {
+        transforms.setPosition(bones[bone], Vector3(0.0f, 0.1f, 0.0f));
+    }
+}
+
+void benchmarkDirtyUpdates() {
+    constexpr size_t SkeletonCount = 1000;
+    Scene scene;
+    std::vector<Entity> bones = buildSkeletons(scene, SkeletonCount);
+    TransformComponentManager& transforms = scene.getTransformManager();
+
+    size_t touched = 0;
+    double allTime = benchmark::measureMilliseconds(20, [&] {
+        animate(transforms, bones, SkeletonCount);
+        touched = transforms.updateTransforms();
+    });
+    benchmark::reportThroughput("all skeletons animated", touched, allTime);
+
+    double someTime = benchmark::measureMilliseconds(20, [&] {
+        animate(transforms, bones, SkeletonCount / 100);
+        touched = transforms.updateTransforms();
+    });
+    benchmark::reportThroughput("1% of skeletons animated", touched, someTime);
+
+    double staticTime = benchmark::measureMilliseconds(20, [&] {
+        touched = transforms.updateTransforms();
+    });
+    benchmark::report("settled, nothing moved", touched, staticTime);
+}
+
+void benchmarkParallelUpdates() {
+    constexpr size_t SkeletonCount = 10000;
+    Scene scene;
+    std::vector<Entity> bones = buildSkeletons(scene, SkeletonCount);
+    TransformComponentManager& transforms = scene.getTransformManager();
+
+    for (size_t threadCount : {1, 2, 4, 8, 16}) {
+        ThreadPool threadPool(threadCount - 1); // The calling thread works too
+        size_t touched = 0;
+        double time = benchmark::measureMilliseconds(5, [&] {
+            animate(transforms, bones, SkeletonCount);
+        }, [&] {
+            touched = transforms.updateTransforms(threadPool);
+        });
+        benchmark::reportThroughput("full update, " + std::to_string(threadCount) + " threads", touched, time);
+    }
+}
+
+// Destroying a subtree unlinks each node in O(1), so even a flat one with a single
+// parent and many children is linear
+void benchmarkSubtreeDestroy() {
+    constexpr size_t DebrisCount = 100000;
+    constexpr size_t SkeletonCount = 1000;
+
+    std::unique_ptr<Scene> scene;
+    std::vector<Entity> debris;
+    double debrisTime = benchmark::measureMilliseconds(5, [&] {
+        scene = std::make_unique<Scene>();
+        std::span<const Entity> created = scene->createEntities(DebrisCount + 1);
+        debris.assign(created.begin(), created.end());
+        TransformComponentManager& transforms = scene->getTransformManager();
+        transforms.reserve(debris.size());
+        for (const Entity& piece : debris) {
+            transforms.create(piece, Vector3(0.0f, 0.0f, 0.0f));
+        }
+        for (size_t piece = 1; piece < debris.size(); ++piece) {
+            transforms.setParent(debris[piece], debris[0]);
+        }
+    }, [&] {
+        scene->destroySubtree(debris[0]);
+    });
+    benchmark::report("destroy debris subtree (flat)", DebrisCount + 1, debrisTime);
+
+    std::vector<Entity> bones;
+    double ragdollTime = benchmark::measureMilliseconds(5, [&] {
+        scene = std::make_unique<Scene>();
+        bones = buildSkeletons(*scene, SkeletonCount);
+    }, [&] {
+        for (size_t skeleton = 0; skeleton < SkeletonCount; ++skeleton) {
+            scene->destroySubtree(bones[skeleton * BonesPerSkeleton]);
+        }
+    });
+    benchmark::report("destroy every ragdoll subtree", bones.size(), ragdollTime);
+}
+
+} // namespace
+
+int main() {
+    benchmarkDirtyUpdates();
+    benchmarkParallelUpdates();
+    benchmarkSubtreeDestroy();
+    return 0;
+}
@@ -0,0 +1,108 @@
+#include "Benchmark.hpp"
+#include <virealis/Scene/Scene.hpp>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace virealis;
+
+/*
+Compares the per-entity triple isValid() probe that RenderingSystem used to do against
+scene.view<Mesh, Transform, Material>() and the owning group over the same managers.
+
+Every entity gets a transform, half get a material and a quarter get a mesh. Components
+are added in shuffled order so the dense arrays of the managers do not line up.
+*/
+
+namespace {
+
+void populate(Scene& scene, size_t count) {
+    std::vector<Entity> entities;
+    entities.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        entities.push_back(scene.createEntity());
+    }
+
+    std::mt19937 rng(42);
+    std::shuffle(entities.begin(), entities.end(), rng);
+    for (size_t i = 0; i < count; ++i) {
+        scene.getTransformManager().create(entities[i], Matrix4x4::translation({float(i), 0.0f, 0.0f}));
+    }
+
+    std::shuffle(entities.begin(), entities.end(), rng);
+    for (size_t i = 0; i < count / 2; ++i) {
+        scene.getMaterialManager().create(entities[i], {1.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 1.0f}, 32.0f);
+    }
+
+    std::shuffle(entities.begin(), entities.end(), rng);
+    for (size_t i = 0; i < count / 4; ++i) {
+        scene.getMeshManager().create(entities[i], {}, {}, {});
+    }
+}
+
+float iterateWithLookups(const Scene& scene) {
+    const MeshComponentManager& meshManager = scene.getMeshManager();
+    const MaterialComponentManager& materialManager = scene.getMaterialManager();
+    const TransformComponentManager& transformManager = scene.getTransformManager();
+
+    float sum = 0.0f;
+    for (const Entity& entity : scene.getEntities()) {
+        if (!meshManager.isValid(entity) || !transformManager.isValid(entity) || !materialManager.isValid(entity)) {
+            continue;
+        }
+        sum += transformManager.getWorldTransform(entity)(0, 3) + materialManager.getDiffuseColor(entity).x;
+    }
+    return sum;
+}
+
+float iterateWithView(const Scene& scene) {
+    const MaterialComponentManager& materialManager = scene.getMaterialManager();
+    const TransformComponentManager& transformManager = scene.getTransformManager();
+
+    float sum = 0.0f;
+    scene.view<MeshComponentManager, TransformComponentManager, MaterialComponentManager>().each(
+        [&](Entity, size_t, size_t transformIndex, size_t materialIndex) {
+        sum += transformManager.getWorldTransformAt(transformIndex)(0, 3) + materialManager.getDiffuseColorAt(materialIndex).x;
+    });
+    return sum;
+}
+
+float iterateWithGroup(const Scene& scene) {
+    const MaterialComponentManager& materialManager = scene.getMaterialManager();
+    const TransformComponentManager& transformManager = scene.getTransformManager();
+
+    float sum = 0.0f;
+    scene.findGroup<MeshComponentManager, TransformComponentManager, MaterialComponentManager>()->each(
+        [&](Entity, size_t index) {
+        sum += transformManager.getWorldTransformAt(index)(0, 3) + materialManager.getDiffuseColorAt(index).x;
+    });
+    return sum;
+}
+
+} // namespace
+
+int main() {
+    for (size_t count : {10'000, 100'000, 1'000'000}) {
+        Scene scene;
+        populate(scene, count);
+
+        int iterations = count >= 1'000'000 ? 10 : 100;
+        double lookupTime = benchmark::measureMilliseconds(iterations, [&] {
+            benchmark::doNotOptimize(iterateWithLookups(scene));
+        });
+        double viewTime = benchmark::measureMilliseconds(iterations, [&] {
+            benchmark::doNotOptimize(iterateWithView(scene));
+        });
+
+
+        scene.group<MeshComponentManager, TransformComponentManager, MaterialComponentManager>();
+        double groupTime = benchmark::measureMilliseconds(iterations, [&] {
+            benchmark::doNotOptimize(iterateWithGroup(scene));
+        });
+
+        benchmark::report("per-entity triple lookup", count, lookupTime);
+        benchmark::report("view<Mesh, Transform, Material>", count, viewTime);
+        benchmark::report("group<Mesh, Transform, Material>", count, groupTime);
+    }
+    return 0;
+}
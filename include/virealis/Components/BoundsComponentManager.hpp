@@ -0,0 +1,74 @@
+#ifndef VIREALIS_BOUNDS_COMPONENT_MANAGER_H
+#define VIREALIS_BOUNDS_COMPONENT_MANAGER_H
+
+#include <virealis/Core/Entity.hpp>
+#include <virealis/Core/ComponentStorage.hpp>
+#include <virealis/Core/SoA.hpp>
+#include <virealis/Math/AABB.hpp>
+#include <virealis/Math/BoundingSphere.hpp>
+#include <virealis/Math/Matrix3x4.hpp>
+#include <span>
+
+namespace virealis {
+
+/*
+World-space bounding volumes for culling, broadphase and picking.
+
+An entity's world bounds are its local bounds (usually its mesh's, see
+MeshComponentManager::getLocalBounds) under its world transform. TransformComponentManager
+refreshes them in its own update pass, only for the transforms that moved, so consumers
+never recompute them.
+*/
+class BoundsComponentManager : public ComponentStorage {
+private:
+    enum Field : size_t { LocalBounds, LocalSphere, WorldBounds, WorldSphere };
+    using BoundsData = SoA<AABB,             // LocalBounds
+                           BoundingSphere,   // LocalSphere
+                           AABB,             // WorldBounds
+                           BoundingSphere>;  // WorldSphere
+
+    BoundsData data;
+
+    // Called by TransformComponentManager with the entity's new world transform
+    friend class TransformComponentManager;
+    void updateWorldBounds(size_t index, const Matrix3x4& worldTransform);
+
+public:
+    // World bounds equal the local ones until the entity's transform places them
+    void create(Entity entity, const AABB& localBounds, const BoundingSphere& localSphere);
+    void reserve(size_t count);
+    AABB getWorldBounds(Entity entity) const;
+    BoundingSphere getWorldSphere(Entity entity) const;
+
+    // Dense-slot access for systems iterating through a View
+    const AABB& getLocalBoundsAt(size_t index) const;
+    const BoundingSphere& getLocalSphereAt(size_t index) const;
+    const AABB& getWorldBoundsAt(size_t index) const;
+    const BoundingSphere& getWorldSphereAt(size_t index) const;
+
+protected:
+    void swapData(size_t a, size_t b) override;
+    void popData() override;
+};
+
+// Inline Definitions
+
+inline const AABB& BoundsComponentManager::getLocalBoundsAt(size_t index) const {
+    return data.get<LocalBounds>()[index];
+}
+
+inline const BoundingSphere& BoundsComponentManager::getLocalSphereAt(size_t index) const {
+    return data.get<LocalSphere>()[index];
+}
+
+inline const AABB& BoundsComponentManager::getWorldBoundsAt(size_t index) const {
+    return data.get<WorldBounds>()[index];
+}
+
+inline const BoundingSphere& BoundsComponentManager::getWorldSphereAt(size_t index) const {
+    return data.get<WorldSphere>()[index];
+}
+
+} // namespace virealis
+
+#endif // VIREALIS_BOUNDS_COMPONENT_MANAGER_H
@@ -1,42 +1,70 @@
+#ifndef VIREALIS_CAMERA_COMPONENT_MANAGER_H
+#define VIREALIS_CAMERA_COMPONENT_MANAGER_H
+
 #include <virealis/Core/Entity.hpp>
+#include <virealis/Core/ComponentStorage.hpp>
+#include <virealis/Core/SoA.hpp>
 #include <virealis/Math/Vector3.hpp>
 #include <virealis/Math/Matrix4x4.hpp>
 #include <vector>
-#include <unordered_map>
+#include <span>
 
 namespace virealis {
 
-class CameraComponentManager {
+class CameraComponentManager : public ComponentStorage {
 public:
     enum class ProjectionType { Perspective, Orthographic };
 
 private:
-    struct CameraData {
-        std::vector<Entity> entities;
-        std::vector<Vector3> positions;
-        std::vector<Vector3> orientations;  // Could also be a quaternion
-        std::vector<Matrix4x4> viewMatrices;
-        std::vector<Matrix4x4> projectionMatrices;
-        std::vector<float> fovs; // Field of View for perspective projection
-        std::vector<float> aspectRatios;
-        std::vector<float> nearPlanes;
-        std::vector<float> farPlanes;
-        std::vector<ProjectionType> projectionTypes;
+    enum Field : size_t {
+        Position, Orientation, ViewMatrix, ProjectionMatrix,
+        Fov, AspectRatio, NearPlane, FarPlane, Projection
     };
+    using CameraData = SoA<Vector3,          // Position
+                           Vector3,          // Orientation (could also be a quaternion)
+                           Matrix4x4,        // ViewMatrix
+                           Matrix4x4,        // ProjectionMatrix
+                           float,            // Fov (field of view for perspective projection)
+                           float,            // AspectRatio
+                           float,            // NearPlane
+                           float,            // FarPlane
+                           ProjectionType>;  // Projection
 
     CameraData data;
-    std::unordered_map<Entity, size_t> entityToIndexMap;
 
 public:
     void create(Entity entity, const Vector3& position, const Vector3& orientation,
                 ProjectionType projectionType, float fov, float aspectRatio,
                 float nearPlane, float farPlane);
+    // Cameras in a batch share their projection settings
+    void createBatch(std::span<const Entity> entities, std::span<const Vector3> positions,
+                     std::span<const Vector3> orientations, ProjectionType projectionType,
+                     float fov, float aspectRatio, float nearPlane, float farPlane);
+    void reserve(size_t count);
 
-    void destroy(Entity entity);
     Matrix4x4 getViewMatrix(Entity entity) const;
     Matrix4x4 getProjectionMatrix(Entity entity) const;
     void updateCamera(Entity entity, const Vector3& position, const Vector3& orientation);
-    bool isValid(Entity entity) const;
+
+    // Dense-slot access for systems iterating through a View
+    const Matrix4x4& getViewMatrixAt(size_t index) const;
+    const Matrix4x4& getProjectionMatrixAt(size_t index) const;
+
+protected:
+    void swapData(size_t a, size_t b) override;
+    void popData() override;
 };
 
+// Inline Definitions
+
+inline const Matrix4x4& CameraComponentManager::getViewMatrixAt(size_t index) const {
+    return data.get<ViewMatrix>()[index];
+}
+
+inline const Matrix4x4& CameraComponentManager::getProjectionMatrixAt(size_t index) const {
+    return data.get<ProjectionMatrix>()[index];
+}
+
 } // namespace virealis
+
+#endif // VIREALIS_CAMERA_COMPONENT_MANAGER_H
@@ -0,0 +1,126 @@
+#ifndef VIREALIS_COMPONENT_POOL_H
+#define VIREALIS_COMPONENT_POOL_H
+
+#include <virealis/Core/ComponentStorage.hpp>
+#include <virealis/Core/SoA.hpp>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <cstddef>
+
+namespace virealis {
+
+/*
+Generic SoA component manager for component types that need no behaviour of their own.
+Derive a named type from it so each component gets its own TypeId:
+
+    class RigidBodyManager : public ComponentPool<Vector3, Vector3, float> {}; // Velocity, force, mass
+    enum RigidBodyField : size_t { Velocity, Force, Mass };
+
+    scene.registerComponent<RigidBodyManager>();
+    auto& rigidBodies = scene.getManager<RigidBodyManager>();
+    rigidBodies.create(entity, Vector3(0, 0, 0), Vector3(0, -9.8f, 0), 1.0f);
+    rigidBodies.get<Mass>(entity) = 2.0f;
+*/
+template <typename... Fields>
+class ComponentPool : public ComponentStorage {
+public:
+    // Takes one value per field, in field order
+    template <typename... Values>
+    void create(Entity entity, Values&&... values);
+    void reserve(size_t count);
+
+    // Writing through get()/getField() does not stamp the change tick; call markChanged
+    template <size_t I>
+    auto& get(Entity entity);
+    template <size_t I>
+    const auto& get(Entity entity) const;
+    void markChanged(Entity entity);
+
+    // Dense-slot access for systems iterating through a View
+    template <size_t I>
+    std::span<typename SoA<Fields...>::template FieldType<I>> getField();
+    template <size_t I>
+    std::span<const typename SoA<Fields...>::template FieldType<I>> getField() const;
+
+protected:
+    void swapData(size_t a, size_t b) override;
+    void popData() override;
+
+private:
+    size_t checkedIndexOf(Entity entity) const;
+
+    SoA<Fields...> data;
+};
+
+// Inline Definitions
+
+template <typename... Fields>
+template <typename... Values>
+void ComponentPool<Fields...>::create(Entity entity, Values&&... values) {
+    if (entitySet.contains(entity)) {
+        throw std::runtime_error("Entity already has this component.");
+    }
+
+    entitySet.insert(entity);
+    data.pushBack(std::forward<Values>(values)...);
+    notifyConstruct(entity);
+}
+
+template <typename... Fields>
+void ComponentPool<Fields...>::reserve(size_t count) {
+    entitySet.reserve(count);
+    data.reserve(count);
+}
+
+template <typename... Fields>
+size_t ComponentPool<Fields...>::checkedIndexOf(Entity entity) const {
+    size_t index = entitySet.indexOf(entity);
+    if (index == SparseSet::npos) {
+        throw std::runtime_error("Entity does not have this component.");
+    }
+    return index;
+}
+
+template <typename... Fields>
+template <size_t I>
+auto& ComponentPool<Fields...>::get(Entity entity) {
+    return data.template get<I>()[checkedIndexOf(entity)];
+}
+
+template <typename... Fields>
+template <size_t I>
+const auto& ComponentPool<Fields...>::get(Entity entity) const {
+    return data.template get<I>()[checkedIndexOf(entity)];
+}
+
+template <typename... Fields>
+void ComponentPool<Fields...>::markChanged(Entity entity) {
+    entitySet.markChanged(checkedIndexOf(entity));
+}
+
+template <typename... Fields>
+template <size_t I>
+std::span<typename SoA<Fields...>::template FieldType<I>> ComponentPool<Fields...>::getField() {
+    return data.template get<I>();
+}
+
+template <typename... Fields>
+template <size_t I>
+std::span<const typename SoA<Fields...>::template FieldType<I>> ComponentPool<Fields...>::getField() const {
+    return data.template get<I>();
+}
+
+template <typename... Fields>
+void ComponentPool<Fields...>::swapData(size_t a, size_t b) {
+    data.swapElements(a, b);
+}
+
+template <typename... Fields>
+void ComponentPool<Fields...>::popData() {
+    data.popBack();
+}
+
+} // namespace virealis
+
+#endif // VIREALIS_COMPONENT_POOL_H
@@ -1,39 +1,85 @@
+#ifndef VIREALIS_MATERIAL_COMPONENT_MANAGER_H
+#define VIREALIS_MATERIAL_COMPONENT_MANAGER_H
+
 #include <virealis/Core/Entity.hpp>
+#include <virealis/Core/ComponentStorage.hpp>
+#include <virealis/Core/SoA.hpp>
 #include <virealis/Math/Vector3.hpp>
 #include <vector>
-#include <unordered_map>
+#include <span>
 #include <string>
 
 namespace virealis {
 
-class MaterialComponentManager {
+class MaterialComponentManager : public ComponentStorage {
 private:
-    struct MaterialData {
-        std::vector<Entity> entities;
-        std::vector<Vector3> diffuseColors;
-        std::vector<Vector3> specularColors;
-        std::vector<float> shininesses;
-        std::vector<std::string> textures; // Optional texture path
-        std::vector<float> opacities;
-        std::vector<float> reflectivities;
-    };
+    enum Field : size_t { DiffuseColor, SpecularColor, Shininess, Texture, Opacity, Reflectivity };
+    using MaterialData = SoA<Vector3,       // DiffuseColor
+                             Vector3,       // SpecularColor
+                             float,         // Shininess
+                             std::string,   // Texture (optional texture path)
+                             float,         // Opacity
+                             float>;        // Reflectivity
 
     MaterialData data;
-    std::unordered_map<Entity, size_t> entityToIndexMap;
 
 public:
     void create(Entity entity, const Vector3& diffuseColor,
                 const Vector3& specularColor, float shininess,
                 const std::string& texture = "", // Optional texture
                 float opacity = 1.0f, float reflectivity = 0.0f);
-    void destroy(Entity entity);
+    // Untextured, opaque, non-reflective materials; one element of each span per entity
+    void createBatch(std::span<const Entity> entities,
+                     std::span<const Vector3> diffuseColors,
+                     std::span<const Vector3> specularColors,
+                     std::span<const float> shininesses);
+    void reserve(size_t count);
     Vector3 getDiffuseColor(Entity entity) const;
     Vector3 getSpecularColor(Entity entity) const;
     float getShininess(Entity entity) const;
     std::string getTexture(Entity entity) const;
     float getOpacity(Entity entity) const;
     float getReflectivity(Entity entity) const;
-    bool isValid(Entity entity) const;
+
+    // Dense-slot access for systems iterating through a View
+    const Vector3& getDiffuseColorAt(size_t index) const;
+    const Vector3& getSpecularColorAt(size_t index) const;
+    float getShininessAt(size_t index) const;
+    const std::string& getTextureAt(size_t index) const;
+    float getOpacityAt(size_t index) const;
+    float getReflectivityAt(size_t index) const;
+
+protected:
+    void swapData(size_t a, size_t b) override;
+    void popData() override;
 };
 
+// Inline Definitions
+
+inline const Vector3& MaterialComponentManager::getDiffuseColorAt(size_t index) const {
+    return data.get<DiffuseColor>()[index];
+}
+
+inline const Vector3& MaterialComponentManager::getSpecularColorAt(size_t index) const {
+    return data.get<SpecularColor>()[index];
+}
+
+inline float MaterialComponentManager::getShininessAt(size_t index) const {
+    return data.get<Shininess>()[index];
+}
+
+inline const std::string& MaterialComponentManager::getTextureAt(size_t index) const {
+    return data.get<Texture>()[index];
+}
+
+inline float MaterialComponentManager::getOpacityAt(size_t index) const {
+    return data.get<Opacity>()[index];
+}
+
+inline float MaterialComponentManager::getReflectivityAt(size_t index) const {
+    return data.get<Reflectivity>()[index];
+}
+
 } // namespace virealis
+
+#endif // VIREALIS_MATERIAL_COMPONENT_MANAGER_H
@@ -1,35 +1,87 @@
+#ifndef VIREALIS_MESH_COMPONENT_MANAGER_H
+#define VIREALIS_MESH_COMPONENT_MANAGER_H
+
 #include <virealis/Core/Entity.hpp>
+#include <virealis/Core/ComponentStorage.hpp>
+#include <virealis/Core/SoA.hpp>
 #include <virealis/Math/Vector3.hpp>
 #include <virealis/Math/Vector2.hpp>
+#include <virealis/Math/AABB.hpp>
+#include <virealis/Math/BoundingSphere.hpp>
 #include <vector>
-#include <unordered_map>
+#include <span>
 
 namespace virealis {
 
-class MeshComponentManager {
+class MeshComponentManager : public ComponentStorage {
 private:
-    struct MeshData {
-        std::vector<Entity> entities;
-        std::vector<std::vector<Vector3>> vertices;
-        std::vector<std::vector<Vector3>> normals;
-        std::vector<std::vector<Vector2>> uvCoordinates;  // New vector for UV coordinates
-        std::vector<std::vector<uint32_t>> indices;
-    };
+    enum Field : size_t { Vertices, Normals, UVCoordinates, Indices, LocalBounds, LocalSphere };
+    using MeshData = SoA<std::vector<Vector3>,    // Vertices
+                         std::vector<Vector3>,    // Normals
+                         std::vector<Vector2>,    // UVCoordinates
+                         std::vector<uint32_t>,   // Indices
+                         AABB,                    // LocalBounds (computed from the vertices on create)
+                         BoundingSphere>;         // LocalSphere (computed from the vertices on create)
 
     MeshData data;
-    std::unordered_map<Entity, size_t> entityToIndexMap;
 
 public:
     void create(Entity entity, const std::vector<Vector3>& vertices,
                 const std::vector<uint32_t>& indices,
                 const std::vector<Vector3>& normals,
                 const std::vector<Vector2>& uvCoords = {});
-    void destroy(Entity entity);
+    // One element of each span per entity; meshes in a batch have no UV coordinates
+    void createBatch(std::span<const Entity> entities,
+                     std::span<const std::vector<Vector3>> vertices,
+                     std::span<const std::vector<uint32_t>> indices,
+                     std::span<const std::vector<Vector3>> normals);
+    void reserve(size_t count);
     std::vector<Vector3> getVertices(Entity entity) const;
     std::vector<Vector3> getNormals(Entity entity) const;
     std::vector<Vector2> getUVCoordinates(Entity entity) const;
     std::vector<uint32_t> getIndices(Entity entity) const;
-    bool isValid(Entity entity) const;
+    AABB getLocalBounds(Entity entity) const;
+    BoundingSphere getLocalSphere(Entity entity) const;
+
+    // Dense-slot access for systems iterating through a View
+    const std::vector<Vector3>& getVerticesAt(size_t index) const;
+    const std::vector<Vector3>& getNormalsAt(size_t index) const;
+    const std::vector<Vector2>& getUVCoordinatesAt(size_t index) const;
+    const std::vector<uint32_t>& getIndicesAt(size_t index) const;
+    const AABB& getLocalBoundsAt(size_t index) const;
+    const BoundingSphere& getLocalSphereAt(size_t index) const;
+
+protected:
+    void swapData(size_t a, size_t b) override;
+    void popData() override;
 };
 
+// Inline Definitions
+
+inline const std::vector<Vector3>& MeshComponentManager::getVerticesAt(size_t index) const {
+    return data.get<Vertices>()[index];
+}
+
+inline const std::vector<Vector3>& MeshComponentManager::getNormalsAt(size_t index) const {
+    return data.get<Normals>()[index];
+}
+
+inline const std::vector<Vector2>& MeshComponentManager::getUVCoordinatesAt(size_t index) const {
+    return data.get<UVCoordinates>()[index];
+}
+
+inline const std::vector<uint32_t>& MeshComponentManager::getIndicesAt(size_t index) const {
+    return data.get<Indices>()[index];
+}
+
+inline const AABB& MeshComponentManager::getLocalBoundsAt(size_t index) const {
+    return data.get<LocalBounds>()[index];
+}
+
+inline const BoundingSphere& MeshComponentManager::getLocalSphereAt(size_t index) const {
+    return data.get<LocalSphere>()[index];
+}
+
 } // namespace virealis
+
+#endif // VIREALIS_MESH_COMPONENT_MANAGER_H
@@ -2,37 +2,211 @@
 #define VIREALIS_TRANSFORM_COMPONENT_MANAGER_H
 
 #include <virealis/Core/Entity.hpp>
+#include <virealis/Core/ComponentStorage.hpp>
+#include <virealis/Core/SoA.hpp>
+#include <virealis/Core/ThreadPool.hpp>
+#include <virealis/Math/Matrix3x4.hpp>
 #include <virealis/Math/Matrix4x4.hpp>
+#include <virealis/Math/Quaternion.hpp>
+#include <virealis/Math/Vector3.hpp>
 #include <vector>
-#include <unordered_map>
+#include <span>
 #include <cstddef>
+#include <cstdint>
 
 namespace virealis {
 
-class TransformComponentManager {
+class BoundsComponentManager;
+
+class TransformComponentManager : public ComponentStorage {
 private:
-    struct TransformData {
-        std::vector<Entity> entities;
-        std::vector<Matrix4x4> localTransforms;
-        std::vector<Matrix4x4> worldTransforms;
-        std::vector<size_t> parents;
-        std::vector<size_t> firstChildren;
-        std::vector<size_t> nextSiblings;
+    enum Field : size_t {
+        Position, Rotation, Scale, WorldTransform, PreviousWorldTransform, PreviousFrame,
+        Parent, FirstChild, LastChild, NextSibling, PrevSibling, OrderPosition, Dirty
     };
+    // Locals are kept decomposed so animation and physics can write a single part;
+    // worlds are affine, so the bottom row of a 4x4 matrix is never stored
+    using TransformData = SoA<Vector3,     // Position (local)
+                              Quaternion,  // Rotation (local)
+                              Vector3,     // Scale (local)
+                              Matrix3x4,   // WorldTransform
+                              Matrix3x4,   // PreviousWorldTransform (valid when PreviousFrame is current)
+                              uint32_t,    // PreviousFrame (buffer frame the previous transform belongs to)
+                              size_t,      // Parent (dense slot)
+                              size_t,      // FirstChild (dense slot)
+                              size_t,      // LastChild (dense slot)
+                              size_t,      // NextSibling (dense slot)
+                              size_t,      // PrevSibling (dense slot)
+                              size_t,      // OrderPosition (position in hierarchyOrder)
+                              uint8_t>;    // Dirty (world transform needs recomputing; see Created)
+
+    // Dirty value of a node whose world transform was never computed; it has no previous
+    // transform to interpolate from
+    static constexpr uint8_t Created = 2;
+
+    // Above this share of dirty nodes (1 / FullUpdateRatio), one pass over everything
+    // is cheaper than finding the dirty subtrees
+    static constexpr size_t FullUpdateRatio = 4;
+
+    // Updates touching fewer nodes than this stay on the calling thread
+    static constexpr size_t ParallelThreshold = 16384;
 
     TransformData data;
-    std::unordered_map<Entity, size_t> entityToIndexMap;
+
+    // Dense slots in hierarchy order, grouped by depth level: every parent comes before its
+    // children, so one forward pass computes each world transform exactly once. Storage
+    // order itself belongs to whichever group owns this manager, hence the separate list.
+    std::vector<size_t> hierarchyOrder;
+    std::vector<size_t> levelStarts{ 0 }; // Start of each depth level in hierarchyOrder, plus the end
+    bool hierarchyDirty = false;          // Set when patching the order would cost more than a rebuild
+
+    // Nodes whose local transform or parent changed since the last update. Entities rather
+    // than slots, since slots move; a node's descendants are implicitly dirty as well.
+    std::vector<Entity> dirtyNodes;
+
+    // Working memory of an update; one per thread in parallel updates
+    struct UpdateScratch {
+        std::vector<size_t> slots;             // Subtree walk
+        std::vector<Matrix3x4> parentWorlds;   // Batch inputs and outputs
+        std::vector<Matrix3x4> locals;
+        std::vector<Matrix3x4> worlds;
+    };
+    UpdateScratch updateScratch;
+
+    // Counts swapTransformBuffers calls. Rather than copying every world transform at the
+    // swap, a node saves its old one into PreviousWorldTransform the first time it moves
+    // in a frame; nodes that did not move read their current one as the previous.
+    uint32_t bufferFrame = 0;
+
+    // World bounds refreshed along with the world transforms, if set
+    BoundsComponentManager* boundsManager = nullptr;
+    static void onBoundsConstruct(void* context, Entity entity);
+
+    void append(Entity entity, const Vector3& position, const Quaternion& rotation, const Vector3& scale);
+    void rebuildHierarchyOrder();
+    // Structural changes patch the order in place: adding or removing a node at some level
+    // shifts one node per deeper level, so the levels stay contiguous
+    size_t levelOf(size_t index) const;
+    void insertIntoOrder(size_t index, size_t level);
+    void removeFromOrder(size_t index);
+    // Moves root's subtree so root sits at rootLevel, after root changed parent
+    void relevelSubtree(size_t root, size_t rootLevel);
+    void markDirty(size_t index);
+    Matrix3x4 computeLocal(size_t index) const;
+    // Recomputes the world transforms of the given slots, which must not include both a
+    // node and its parent; all update paths go through it, so they round alike
+    void updateBatch(std::span<const size_t> slots, UpdateScratch& scratch);
+    void storeWorld(size_t index, const Matrix3x4& world);
+    size_t updateSubtree(size_t root, UpdateScratch& scratch);
+    size_t update(ThreadPool* threadPool);
+    size_t updateAll(ThreadPool* threadPool);
+    size_t updateDirtySubtrees(ThreadPool* threadPool);
+
+    // Children form a doubly linked list, so attaching and detaching are O(1)
+    void attach(size_t child, size_t parent);
+    void detach(size_t index);
+
+    // Detaches the node at index from its parent and orphans its children
+    void unlink(size_t index);
 
 public:
+    void create(Entity entity, const Vector3& position, const Quaternion& rotation = Quaternion::identity(),
+                const Vector3& scale = Vector3(1.0f, 1.0f, 1.0f));
+    // Matrix forms are decomposed into translation, rotation and scale; shear is lost
     void create(Entity entity, const Matrix4x4& localTransform);
+    void createBatch(std::span<const Entity> entities, std::span<const Matrix4x4> localTransforms);
+    void reserve(size_t count);
     void destroy(Entity entity);
     Matrix4x4 getWorldTransform(Entity entity) const;
     void setLocalTransform(Entity entity, const Matrix4x4& localTransform);
-    void updateTransforms();
+
+    // Local transform parts; the setters only mark the node dirty for the next update
+    void setPosition(Entity entity, const Vector3& position);
+    void setRotation(Entity entity, const Quaternion& rotation);
+    void setScale(Entity entity, const Vector3& scale);
+    Vector3 getPosition(Entity entity) const;
+    Quaternion getRotation(Entity entity) const;
+    Vector3 getScale(Entity entity) const;
+
+    // Recomputes world transforms (world = parentWorld * local) for the subtrees under nodes
+    // modified since the last call and returns the number of nodes recomputed. A settled
+    // hierarchy costs nothing.
+    size_t updateTransforms();
+
+    // Same, spread over the pool once an update is large enough. Full updates split the
+    // work by root subtree when there are many roots, or else level by level; dirty
+    // updates split by dirty subtree.
+    size_t updateTransforms(ThreadPool& threadPool);
+
+    // Moves child (with its subtree) under parent, detaching it from any previous parent.
+    // Throws if parent is child itself or one of its descendants.
     void setParent(Entity child, Entity parent);
-    bool isValid(Entity entity) const;
+    // Makes child a root again
+    void removeParent(Entity child);
+
+    // Appends root and its descendants to entities, every parent before its children
+    void collectSubtree(Entity root, std::vector<Entity>& entities) const;
+    // Destroys the transforms of root and all its descendants, in time linear in the
+    // subtree size. See Scene::destroySubtree to destroy the entities themselves.
+    void destroySubtree(Entity root);
+
+    // Double buffering, for a simulation stepping at a fixed rate while rendering runs at
+    // display rate. Call swapTransformBuffers() before each step's updateTransforms(); the
+    // renderer then blends the last two steps with alpha = time since the last step / step
+    // length (0 gives the previous step, 1 the latest). Swapping is O(1).
+    //
+    // Both buffers are written by the step: updateTransforms saves a node's previous world
+    // and overwrites its current one in place. The step and any read of world, previous or
+    // interpolated transforms must therefore not overlap; run them as scheduler systems
+    // with write and read access to this manager, which keeps them apart.
+    void swapTransformBuffers();
+    // Rotations are slerped and translations and scales blended linearly, so a turning
+    // node keeps its size between the two steps. Alpha at or beyond 0 or 1 returns that
+    // step's world as stored, without blending.
+    Matrix4x4 getInterpolatedWorldTransform(Entity entity, float alpha) const;
+
+    // Keeps the world bounds of the manager's entities in step with their transforms:
+    // each update refreshes them for the transforms it moved, so a system calling
+    // updateTransforms writes the bounds manager too. Scene sets this up.
+    void setBoundsManager(BoundsComponentManager* manager);
+
+    // Dense-slot access for systems iterating through a View
+    const Matrix3x4& getWorldTransformAt(size_t index) const;
+    const Matrix3x4& getPreviousWorldTransformAt(size_t index) const;
+    Matrix3x4 getInterpolatedWorldTransformAt(size_t index, float alpha) const;
+
+    // Working memory of getInterpolatedWorldTransformsAt, kept by the caller so repeated
+    // calls reuse its allocations
+    struct InterpolationScratch {
+        std::vector<size_t> moving;               // Positions in out of the nodes that moved
+        std::vector<Quaternion> previousRotations;
+        std::vector<Quaternion> currentRotations;
+        std::vector<Matrix3x4> stretches;
+        std::vector<Matrix3x4> rotations;
+    };
+    // Batch form for renderers: out[i] = getInterpolatedWorldTransformAt(indices[i], alpha)
+    // to within about 1e-6 relative, with the rotations of the nodes that moved slerped
+    // and applied together on the Quaternion and Matrix3x4 batch kernels. out must be as
+    // long as indices.
+    void getInterpolatedWorldTransformsAt(std::span<const size_t> indices, float alpha, std::span<Matrix3x4> out,
+                                          InterpolationScratch& scratch) const;
+
+protected:
+    void swapData(size_t a, size_t b) override;
+    void popData() override;
 };
 
+// Inline Definitions
+
+inline const Matrix3x4& TransformComponentManager::getWorldTransformAt(size_t index) const {
+    return data.get<WorldTransform>()[index];
+}
+
+inline const Matrix3x4& TransformComponentManager::getPreviousWorldTransformAt(size_t index) const {
+    return data.get<PreviousFrame>()[index] == bufferFrame ? data.get<PreviousWorldTransform>()[index]
+                                                           : data.get<WorldTransform>()[index];
+}
+
 } // namespace virealis
 
-#endif // VIREALIS_TRANSFORM_COMPONENT_MANAGER_H
\ No newline at end of file
+#endif // VIREALIS_TRANSFORM_COMPONENT_MANAGER_H
@@ -0,0 +1,193 @@
+#ifndef VIREALIS_COMPONENT_REGISTRY_H
+#define VIREALIS_COMPONENT_REGISTRY_H
+
+#include <virealis/Core/ComponentStorage.hpp>
+#include <virealis/Core/Entity.hpp>
+#include <virealis/Core/TypeId.hpp>
+#include <array>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace virealis {
+
+/*
+Type-indexed set of component managers, so new component types can be added without
+touching Scene.
+
+Each registered manager gets a bit in a per-entity component mask. The masks are kept up
+to date through the managers' construct/destroy listeners, and destroyAll() walks only
+the set bits, calling each manager's destroy through a flat table of function pointers.
+An entity therefore pays nothing for component types it does not have.
+
+    scene.registerComponent<RigidBodyManager>();
+    scene.getManager<RigidBodyManager>().create(entity, ...);
+
+Managers are any ComponentStorage subclass (see ComponentPool for a generic one).
+*/
+class ComponentRegistry {
+public:
+    static constexpr size_t MaxComponentTypes = 64;
+    using ComponentMask = uint64_t;
+
+    ComponentRegistry() = default;
+    ~ComponentRegistry() = default;
+
+    ComponentRegistry(const ComponentRegistry&) = delete;
+    ComponentRegistry& operator=(const ComponentRegistry&) = delete;
+
+    // Constructs the manager in place; throws if the type is already registered
+    template <typename Manager, typename... Args>
+    Manager& registerComponent(Args&&... args);
+
+    template <typename Manager>
+    bool isRegistered() const;
+
+    // Registered manager of the given type, or nullptr
+    template <typename Manager>
+    Manager* find() const;
+
+    // Registered manager of the given type; throws if it is not registered
+    template <typename Manager>
+    Manager& get() const;
+
+    // Registers a default-constructed manager on first use
+    template <typename Manager>
+    Manager& assure();
+
+    // Bits of the given managers in the component masks; all must be registered
+    template <typename... Managers>
+    ComponentMask maskOf() const;
+
+    ComponentMask getMask(Entity entity) const;
+    bool hasAll(Entity entity, ComponentMask mask) const;
+
+    // Removes every component the entity has
+    void destroyAll(Entity entity);
+
+    void setCurrentTick(uint32_t tick);
+    size_t size() const;
+
+private:
+    using DestroyFunction = void (*)(ComponentStorage& storage, Entity entity);
+
+    struct Pool {
+        std::unique_ptr<ComponentStorage> storage;
+        DestroyFunction destroy = nullptr;
+        ComponentRegistry* registry = nullptr;
+        ComponentMask bit = 0;
+    };
+
+    static constexpr uint32_t Unregistered = std::numeric_limits<uint32_t>::max();
+
+    template <typename Manager>
+    uint32_t poolIndexOf() const;
+
+    static void onConstruct(void* context, Entity entity);
+    static void onDestroy(void* context, Entity entity);
+
+    std::array<Pool, MaxComponentTypes> pools; // Fixed, so listener contexts stay put
+    size_t poolCount = 0;
+    std::vector<uint32_t> poolIndices;         // Indexed by TypeId
+    std::vector<ComponentMask> masks;          // Indexed by Entity::index
+};
+
+// Inline Definitions
+
+template <typename Manager>
+uint32_t ComponentRegistry::poolIndexOf() const {
+    const TypeId id = getTypeId<Manager>();
+    return id < poolIndices.size() ? poolIndices[id] : Unregistered;
+}
+
+template <typename Manager, typename... Args>
+Manager& ComponentRegistry::registerComponent(Args&&... args) {
+    static_assert(std::is_base_of_v<ComponentStorage, Manager>, "Component managers must derive from ComponentStorage.");
+    if (isRegistered<Manager>()) {
+        throw std::runtime_error("Component type is already registered.");
+    }
+    if (poolCount == MaxComponentTypes) {
+        throw std::runtime_error("Too many component types registered.");
+    }
+
+    const TypeId id = getTypeId<Manager>();
+    if (id >= poolIndices.size()) {
+        poolIndices.resize(id + 1, Unregistered);
+    }
+    poolIndices[id] = static_cast<uint32_t>(poolCount);
+
+    Pool& pool = pools[poolCount];
+    auto manager = std::make_unique<Manager>(std::forward<Args>(args)...);
+    Manager& result = *manager;
+    pool.storage = std::move(manager);
+    // Calls the manager's own destroy, which may hide ComponentStorage::destroy
+    pool.destroy = [](ComponentStorage& storage, Entity entity) { static_cast<Manager&>(storage).destroy(entity); };
+    pool.registry = this;
+    pool.bit = ComponentMask(1) << poolCount;
+    pool.storage->addListener({ &pool, &ComponentRegistry::onConstruct, &ComponentRegistry::onDestroy });
+    ++poolCount;
+    return result;
+}
+
+template <typename Manager>
+bool ComponentRegistry::isRegistered() const {
+    return poolIndexOf<Manager>() != Unregistered;
+}
+
+template <typename Manager>
+Manager* ComponentRegistry::find() const {
+    uint32_t index = poolIndexOf<Manager>();
+    if (index == Unregistered) {
+        return nullptr;
+    }
+    return static_cast<Manager*>(pools[index].storage.get());
+}
+
+template <typename Manager>
+Manager& ComponentRegistry::get() const {
+    Manager* manager = find<Manager>();
+    if (manager == nullptr) {
+        throw std::runtime_error("Component type is not registered.");
+    }
+    return *manager;
+}
+
+template <typename Manager>
+Manager& ComponentRegistry::assure() {
+    if (Manager* manager = find<Manager>()) {
+        return *manager;
+    }
+    return registerComponent<Manager>();
+}
+
+template <typename... Managers>
+ComponentRegistry::ComponentMask ComponentRegistry::maskOf() const {
+    auto bitOf = [this](uint32_t index) {
+        if (index == Unregistered) {
+            throw std::runtime_error("Component type is not registered.");
+        }
+        return pools[index].bit;
+    };
+    return (bitOf(poolIndexOf<Managers>()) | ... | ComponentMask(0));
+}
+
+inline ComponentRegistry::ComponentMask ComponentRegistry::getMask(Entity entity) const {
+    return entity.index < masks.size() ? masks[entity.index] : 0;
+}
+
+inline bool ComponentRegistry::hasAll(Entity entity, ComponentMask mask) const {
+    return (getMask(entity) & mask) == mask;
+}
+
+inline size_t ComponentRegistry::size() const {
+    return poolCount;
+}
+
+} // namespace virealis
+
+#endif // VIREALIS_COMPONENT_REGISTRY_H
@@ -0,0 +1,161 @@
+#ifndef VIREALIS_COMPONENT_STORAGE_H
+#define VIREALIS_COMPONENT_STORAGE_H
+
+#include <virealis/Core/Entity.hpp>
+#include <virealis/Core/SparseSet.hpp>
+#include <algorithm>
+#include <span>
+#include <stdexcept>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace virealis {
+
+/*
+Common base of the component managers: the sparse set that maps entities to dense slots,
+plus the hooks that groups use to keep several managers in the same order.
+
+A derived manager keeps its component data parallel to the dense array and implements
+swapData()/popData() for it. swapSlots() then reorders entity and data together, and
+destroy() moves the entity to the back before popping it. Managers call
+notifyConstruct() once a new component is fully written; destroy() calls the destroy
+listeners while the component is still present.
+*/
+class ComponentStorage {
+public:
+    // Called with the listener's context; see Group for the main user. Either callback
+    // may be null.
+    struct Listener {
+        void* context;
+        void (*onConstruct)(void* context, Entity entity);
+        void (*onDestroy)(void* context, Entity entity);
+    };
+
+    virtual ~ComponentStorage() = default;
+
+    void destroy(Entity entity);
+    bool isValid(Entity entity) const;
+
+    // Exchanges two dense slots, entity handles and component data alike
+    void swapSlots(size_t a, size_t b);
+
+    void addListener(const Listener& listener);
+    void removeListener(void* context);
+
+    // The group that decides this manager's order, if any (a manager has at most one)
+    void* getOwner() const;
+    void setOwner(void* owner);
+
+    const SparseSet& getEntitySet() const;
+
+    // Tick stamped on components created or modified from now on (see Scene::advanceTick)
+    void setCurrentTick(uint32_t tick);
+
+protected:
+    ComponentStorage() = default;
+    ComponentStorage(const ComponentStorage&) = delete;
+    ComponentStorage& operator=(const ComponentStorage&) = delete;
+
+    virtual void swapData(size_t a, size_t b) = 0;
+    virtual void popData() = 0;
+
+    void notifyConstruct(Entity entity);
+
+    // Throws unless every entity is new to this manager and listed once, so that a batch
+    // create can check everything before it changes anything
+    void checkBatchEntities(std::span<const Entity> entities, const char* existingMessage) const;
+
+    SparseSet entitySet;
+
+private:
+    std::vector<Listener> listeners;
+    void* owner = nullptr;
+};
+
+// Inline Definitions
+
+inline void ComponentStorage::destroy(Entity entity) {
+    if (!entitySet.contains(entity)) {
+        return;
+    }
+
+    // Listeners may reorder slots, so look the index up again afterwards
+    for (const Listener& listener : listeners) {
+        if (listener.onDestroy != nullptr) {
+            listener.onDestroy(listener.context, entity);
+        }
+    }
+
+    size_t index = entitySet.indexOf(entity);
+    size_t last = entitySet.size() - 1;
+    swapSlots(index, last);
+    popData();
+    entitySet.remove(entity);
+}
+
+inline bool ComponentStorage::isValid(Entity entity) const {
+    return entitySet.contains(entity);
+}
+
+inline void ComponentStorage::swapSlots(size_t a, size_t b) {
+    if (a == b) {
+        return;
+    }
+    swapData(a, b);
+    entitySet.swapSlots(a, b);
+}
+
+inline void ComponentStorage::addListener(const Listener& listener) {
+    listeners.push_back(listener);
+}
+
+inline void ComponentStorage::removeListener(void* context) {
+    listeners.erase(std::remove_if(listeners.begin(), listeners.end(),
+                                   [context](const Listener& listener) { return listener.context == context; }),
+                    listeners.end());
+}
+
+inline void ComponentStorage::notifyConstruct(Entity entity) {
+    for (const Listener& listener : listeners) {
+        if (listener.onConstruct != nullptr) {
+            listener.onConstruct(listener.context, entity);
+        }
+    }
+}
+
+inline void ComponentStorage::checkBatchEntities(std::span<const Entity> entities,
+                                                 const char* existingMessage) const {
+    std::vector<uint32_t> indices;
+    indices.reserve(entities.size());
+    for (const Entity& entity : entities) {
+        if (entitySet.contains(entity)) {
+            throw std::runtime_error(existingMessage);
+        }
+        indices.push_back(entity.index);
+    }
+    std::sort(indices.begin(), indices.end());
+    if (std::adjacent_find(indices.begin(), indices.end()) != indices.end()) {
+        throw std::runtime_error("createBatch lists an entity more than once.");
+    }
+}
+
+inline void* ComponentStorage::getOwner() const {
+    return owner;
+}
+
+inline void ComponentStorage::setOwner(void* newOwner) {
+    owner = newOwner;
+}
+
+inline const SparseSet& ComponentStorage::getEntitySet() const {
+    return entitySet;
+}
+
+inline void ComponentStorage::setCurrentTick(uint32_t tick) {
+    entitySet.setCurrentTick(tick);
+}
+
+} // namespace virealis
+
+#endif // VIREALIS_COMPONENT_STORAGE_H
@@ -3,7 +3,6 @@
 
 #include <virealis/Core/Entity.hpp>
 #include <vector>
-#include <queue>
 #include <cstdint>
 
 namespace virealis {
@@ -11,17 +10,18 @@ namespace virealis {
 class EntityManager {
 private:
     std::vector<uint32_t> generations;
-    std::queue<uint32_t> freeIndices;
+    std::vector<uint32_t> freeIndices; // Recycled indices, reused most-recently-freed first
 
 public:
     EntityManager() = default;
     ~EntityManager() = default;
 
     Entity createEntity();
+    void reserve(size_t count);
     void destroyEntity(Entity entity);
     bool isValid(Entity entity) const;
 };
 
 } // namespace virealis
 
-#endif // VIREALIS_ENTITY_MANAGER_H
\ No newline at end of file
+#endif // VIREALIS_ENTITY_MANAGER_H
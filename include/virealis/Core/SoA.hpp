@@ -0,0 +1,365 @@
+#ifndef VIREALIS_SOA_H
+#define VIREALIS_SOA_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace virealis {
+
+/*
+Structure-of-arrays container: one array per field, all sharing a single size and capacity.
+
+Every field array lives in one allocation, each starting on a FieldAlignment boundary so
+hot loops can use aligned SIMD loads on any field. Growing reallocates all fields at once,
+instead of each std::vector growing on its own schedule.
+
+Like std::vector, growing gives the strong exception guarantee: elements are moved to the
+new block only if their move constructor is noexcept, and copied otherwise, so a throw
+leaves the container as it was. pushBack may be passed elements of the container itself.
+
+    SoA<Vector3, float> data;
+    data.pushBack(Vector3(0, 1, 0), 2.0f);
+    std::span<float> masses = data.get<1>();
+*/
+template <typename... Fields>
+class SoA {
+public:
+    static_assert(sizeof...(Fields) > 0, "SoA needs at least one field.");
+
+    static constexpr size_t FieldCount = sizeof...(Fields);
+    static constexpr size_t FieldAlignment = 64; // Cache line; also covers AVX/AVX-512 loads
+
+    static_assert(((alignof(Fields) <= FieldAlignment) && ...), "SoA fields may need at most 64-byte alignment.");
+
+    template <size_t I>
+    using FieldType = std::tuple_element_t<I, std::tuple<Fields...>>;
+
+    SoA() = default;
+    ~SoA();
+
+    SoA(const SoA&) = delete;
+    SoA& operator=(const SoA&) = delete;
+    SoA(SoA&& other) noexcept;
+    SoA& operator=(SoA&& other) noexcept;
+
+    void reserve(size_t newCapacity);
+
+    // Appends one element; takes exactly one value per field, in field order
+    template <typename... Values>
+    void pushBack(Values&&... values);
+
+    // Moves the last element into index, then drops the last element
+    void swapRemove(size_t index);
+    void swapElements(size_t a, size_t b);
+    void popBack();
+    void clear();
+
+    size_t size() const;
+    size_t capacity() const;
+    bool empty() const;
+
+    template <size_t I>
+    std::span<FieldType<I>> get();
+    template <size_t I>
+    std::span<const FieldType<I>> get() const;
+
+private:
+    using FieldPointers = std::array<void*, FieldCount>;
+
+    // Field arrays for a given capacity, with nothing constructed in them yet
+    struct Block {
+        std::byte* storage;
+        FieldPointers fields;
+    };
+
+    template <size_t I>
+    static FieldType<I>* fieldIn(const FieldPointers& pointers);
+    template <size_t I>
+    FieldType<I>* field() const;
+
+    static Block allocateBlock(size_t capacity);
+    static void freeBlock(std::byte* blockStorage);
+
+    // Moves (or copies) every element into block; on a throw, destroys what it constructed
+    // there, leaving the caller to free the block
+    template <size_t... Is>
+    void relocate(const Block& block, std::index_sequence<Is...>);
+    // Destroys the elements, frees the storage and takes block in its place
+    void adopt(const Block& block, size_t newCapacity);
+    // Constructs one element; on a throw, destroys the fields already constructed
+    template <size_t... Is, typename... Values>
+    static void constructAt(const FieldPointers& pointers, size_t index, std::index_sequence<Is...>,
+                            Values&&... values);
+    template <size_t... Is>
+    void moveInto(size_t target, size_t source, std::index_sequence<Is...>);
+    template <size_t... Is>
+    void swapAt(size_t a, size_t b, std::index_sequence<Is...>);
+    template <size_t... Is>
+    static void destroyAt(const FieldPointers& pointers, size_t index, std::index_sequence<Is...>);
+
+    void release();
+
+    static constexpr size_t alignUp(size_t value, size_t alignment);
+
+    std::byte* storage = nullptr;
+    FieldPointers fields{};
+    size_t count = 0;
+    size_t cap = 0;
+};
+
+// Inline Definitions
+
+template <typename... Fields>
+constexpr size_t SoA<Fields...>::alignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+template <typename... Fields>
+template <size_t I>
+typename SoA<Fields...>::template FieldType<I>* SoA<Fields...>::fieldIn(const FieldPointers& pointers) {
+    return static_cast<FieldType<I>*>(pointers[I]);
+}
+
+template <typename... Fields>
+template <size_t I>
+typename SoA<Fields...>::template FieldType<I>* SoA<Fields...>::field() const {
+    return fieldIn<I>(fields);
+}
+
+template <typename... Fields>
+SoA<Fields...>::~SoA() {
+    release();
+}
+
+template <typename... Fields>
+SoA<Fields...>::SoA(SoA&& other) noexcept
+    : storage(std::exchange(other.storage, nullptr)),
+      fields(std::exchange(other.fields, {})),
+      count(std::exchange(other.count, 0)),
+      cap(std::exchange(other.cap, 0)) {}
+
+template <typename... Fields>
+SoA<Fields...>& SoA<Fields...>::operator=(SoA&& other) noexcept {
+    if (this != &other) {
+        release();
+        storage = std::exchange(other.storage, nullptr);
+        fields = std::exchange(other.fields, {});
+        count = std::exchange(other.count, 0);
+        cap = std::exchange(other.cap, 0);
+    }
+    return *this;
+}
+
+template <typename... Fields>
+typename SoA<Fields...>::Block SoA<Fields...>::allocateBlock(size_t capacity) {
+    // Lay the field arrays out back to back, each on its own aligned boundary
+    constexpr std::array<size_t, FieldCount> sizes{ sizeof(Fields)... };
+    std::array<size_t, FieldCount> offsets{};
+    size_t bytes = 0;
+    for (size_t i = 0; i < FieldCount; ++i) {
+        bytes = alignUp(bytes, FieldAlignment);
+        offsets[i] = bytes;
+        bytes += sizes[i] * capacity;
+    }
+
+    Block block{ static_cast<std::byte*>(::operator new(bytes, std::align_val_t{FieldAlignment})), {} };
+    for (size_t i = 0; i < FieldCount; ++i) {
+        block.fields[i] = block.storage + offsets[i];
+    }
+    return block;
+}
+
+template <typename... Fields>
+void SoA<Fields...>::freeBlock(std::byte* blockStorage) {
+    ::operator delete(blockStorage, std::align_val_t{FieldAlignment});
+}
+
+template <typename... Fields>
+void SoA<Fields...>::reserve(size_t newCapacity) {
+    if (newCapacity <= cap) {
+        return;
+    }
+
+    Block block = allocateBlock(newCapacity);
+    try {
+        relocate(block, std::index_sequence_for<Fields...>{});
+    } catch (...) {
+        freeBlock(block.storage);
+        throw;
+    }
+    adopt(block, newCapacity);
+}
+
+template <typename... Fields>
+template <size_t... Is>
+void SoA<Fields...>::relocate(const Block& block, std::index_sequence<Is...>) {
+    // move_if_noexcept copies what could throw while moving, so the old elements stay
+    // intact until the last one is in place and a failure only has to undo the new block
+    size_t fieldsDone = 0;
+    size_t elementsDone = 0;
+    auto relocateField = [&](auto* destination, auto* source) {
+        using T = std::remove_pointer_t<decltype(source)>;
+        for (elementsDone = 0; elementsDone < count; ++elementsDone) {
+            ::new (static_cast<void*>(destination + elementsDone)) T(std::move_if_noexcept(source[elementsDone]));
+        }
+        ++fieldsDone;
+    };
+    try {
+        (relocateField(fieldIn<Is>(block.fields), field<Is>()), ...);
+    } catch (...) {
+        (std::destroy_n(fieldIn<Is>(block.fields), Is < fieldsDone ? count : (Is == fieldsDone ? elementsDone : 0)),
+         ...);
+        throw;
+    }
+}
+
+template <typename... Fields>
+void SoA<Fields...>::adopt(const Block& block, size_t newCapacity) {
+    size_t oldCount = count;
+    release();
+    storage = block.storage;
+    fields = block.fields;
+    count = oldCount;
+    cap = newCapacity;
+}
+
+template <typename... Fields>
+template <typename... Values>
+void SoA<Fields...>::pushBack(Values&&... values) {
+    static_assert(sizeof...(Values) == FieldCount, "pushBack takes one value per field.");
+    if (count < cap) {
+        constructAt(fields, count, std::index_sequence_for<Fields...>{}, std::forward<Values>(values)...);
+        ++count;
+        return;
+    }
+
+    // Construct the new element before moving the others: values may refer to them
+    size_t newCapacity = cap == 0 ? 8 : cap * 2;
+    Block block = allocateBlock(newCapacity);
+    try {
+        constructAt(block.fields, count, std::index_sequence_for<Fields...>{}, std::forward<Values>(values)...);
+    } catch (...) {
+        freeBlock(block.storage);
+        throw;
+    }
+    try {
+        relocate(block, std::index_sequence_for<Fields...>{});
+    } catch (...) {
+        destroyAt(block.fields, count, std::index_sequence_for<Fields...>{});
+        freeBlock(block.storage);
+        throw;
+    }
+    adopt(block, newCapacity);
+    ++count;
+}
+
+template <typename... Fields>
+template <size_t... Is, typename... Values>
+void SoA<Fields...>::constructAt(const FieldPointers& pointers, size_t index, std::index_sequence<Is...>,
+                                 Values&&... values) {
+    size_t constructed = 0;
+    try {
+        ((::new (static_cast<void*>(fieldIn<Is>(pointers) + index)) FieldType<Is>(std::forward<Values>(values)),
+          ++constructed), ...);
+    } catch (...) {
+        (std::destroy_n(fieldIn<Is>(pointers) + index, Is < constructed ? 1 : 0), ...);
+        throw;
+    }
+}
+
+template <typename... Fields>
+template <size_t... Is>
+void SoA<Fields...>::moveInto(size_t target, size_t source, std::index_sequence<Is...>) {
+    ((field<Is>()[target] = std::move(field<Is>()[source])), ...);
+}
+
+template <typename... Fields>
+template <size_t... Is>
+void SoA<Fields...>::destroyAt(const FieldPointers& pointers, size_t index, std::index_sequence<Is...>) {
+    (std::destroy_at(fieldIn<Is>(pointers) + index), ...);
+}
+
+template <typename... Fields>
+void SoA<Fields...>::swapRemove(size_t index) {
+    size_t last = count - 1;
+    if (index != last) {
+        moveInto(index, last, std::index_sequence_for<Fields...>{});
+    }
+    popBack();
+}
+
+template <typename... Fields>
+template <size_t... Is>
+void SoA<Fields...>::swapAt(size_t a, size_t b, std::index_sequence<Is...>) {
+    using std::swap;
+    (swap(field<Is>()[a], field<Is>()[b]), ...);
+}
+
+template <typename... Fields>
+void SoA<Fields...>::swapElements(size_t a, size_t b) {
+    if (a != b) {
+        swapAt(a, b, std::index_sequence_for<Fields...>{});
+    }
+}
+
+template <typename... Fields>
+void SoA<Fields...>::popBack() {
+    --count;
+    destroyAt(fields, count, std::index_sequence_for<Fields...>{});
+}
+
+template <typename... Fields>
+void SoA<Fields...>::clear() {
+    while (count > 0) {
+        popBack();
+    }
+}
+
+template <typename... Fields>
+void SoA<Fields...>::release() {
+    clear();
+    if (storage != nullptr) {
+        ::operator delete(storage, std::align_val_t{FieldAlignment});
+        storage = nullptr;
+    }
+    fields = {};
+    cap = 0;
+}
+
+template <typename... Fields>
+size_t SoA<Fields...>::size() const {
+    return count;
+}
+
+template <typename... Fields>
+size_t SoA<Fields...>::capacity() const {
+    return cap;
+}
+
+template <typename... Fields>
+bool SoA<Fields...>::empty() const {
+    return count == 0;
+}
+
+template <typename... Fields>
+template <size_t I>
+std::span<typename SoA<Fields...>::template FieldType<I>> SoA<Fields...>::get() {
+    return { field<I>(), count };
+}
+
+template <typename... Fields>
+template <size_t I>
+std::span<const typename SoA<Fields...>::template FieldType<I>> SoA<Fields...>::get() const {
+    return { field<I>(), count };
+}
+
+} // namespace virealis
+
+#endif // VIREALIS_SOA_H
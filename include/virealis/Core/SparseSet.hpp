@@ -0,0 +1,207 @@
+#ifndef VIREALIS_SPARSE_SET_H
+#define VIREALIS_SPARSE_SET_H
+
+#include <virealis/Core/Entity.hpp>
+#include <array>
+#include <memory>
+#include <vector>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+
+namespace virealis {
+
+/*
+Sparse set mapping entities to dense slots, shared by all component managers.
+
+The sparse side is a list of fixed-size pages indexed by Entity::index, allocated
+lazily the first time an index in that range is inserted. Each page entry holds the
+dense slot of the entity (or Tombstone). The dense side stores the full entity handles,
+so the generation check is a compare against dense[slot].
+
+Component managers keep their SoA arrays parallel to the dense array: slot i of every
+component array belongs to getEntities()[i]. remove() does swap-and-pop, and managers
+mirror that move on their own arrays.
+
+Each dense slot also carries the tick at which it last changed. insert() and
+markChanged() stamp the set's current tick, which the Scene advances once per frame.
+Tick 0 means "never", so changedSince(0) is true for every slot.
+*/
+class SparseSet {
+public:
+    static constexpr size_t npos = std::numeric_limits<size_t>::max();
+    static constexpr size_t PageSize = 4096;
+
+    bool contains(Entity entity) const;
+    size_t indexOf(Entity entity) const;
+
+    // Appends the entity to the dense array and returns its slot
+    size_t insert(Entity entity);
+
+    // Swap-and-pop; returns the slot the entity occupied (now holding the former last entity)
+    size_t remove(Entity entity);
+
+    // Exchanges the entities (and change ticks) in two dense slots
+    void swapSlots(size_t a, size_t b);
+
+    // Reserves the dense array and the page table; pages themselves stay lazily allocated
+    void reserve(size_t capacity);
+
+    // Change tracking
+    void setCurrentTick(uint32_t tick);
+    uint32_t getCurrentTick() const;
+    void markChanged(size_t index);
+    uint32_t getChangeTick(size_t index) const;
+    bool changedSince(size_t index, uint32_t tick) const;
+
+    void clear();
+    size_t size() const;
+    bool empty() const;
+    Entity operator[](size_t index) const;
+    const std::vector<Entity>& getEntities() const;
+
+private:
+    static constexpr uint32_t Tombstone = std::numeric_limits<uint32_t>::max();
+    using Page = std::array<uint32_t, PageSize>;
+
+    uint32_t* findSlot(uint32_t entityIndex);
+    const uint32_t* findSlot(uint32_t entityIndex) const;
+    uint32_t& assureSlot(uint32_t entityIndex);
+
+    std::vector<std::unique_ptr<Page>> sparse;
+    std::vector<Entity> dense;
+    std::vector<uint32_t> changeTicks; // Parallel to dense
+    uint32_t currentTick = 1;
+};
+
+// Inline Definitions
+
+inline const uint32_t* SparseSet::findSlot(uint32_t entityIndex) const {
+    size_t page = entityIndex / PageSize;
+    if (page >= sparse.size() || !sparse[page]) {
+        return nullptr;
+    }
+    return &(*sparse[page])[entityIndex % PageSize];
+}
+
+inline uint32_t* SparseSet::findSlot(uint32_t entityIndex) {
+    return const_cast<uint32_t*>(static_cast<const SparseSet&>(*this).findSlot(entityIndex));
+}
+
+inline uint32_t& SparseSet::assureSlot(uint32_t entityIndex) {
+    size_t page = entityIndex / PageSize;
+    if (page >= sparse.size()) {
+        sparse.resize(page + 1);
+    }
+    if (!sparse[page]) {
+        sparse[page] = std::make_unique<Page>();
+        sparse[page]->fill(Tombstone);
+    }
+    return (*sparse[page])[entityIndex % PageSize];
+}
+
+inline size_t SparseSet::indexOf(Entity entity) const {
+    const uint32_t* slot = findSlot(entity.index);
+    if (slot == nullptr || *slot == Tombstone || dense[*slot].generation != entity.generation) {
+        return npos;
+    }
+    return *slot;
+}
+
+inline bool SparseSet::contains(Entity entity) const {
+    return indexOf(entity) != npos;
+}
+
+inline size_t SparseSet::insert(Entity entity) {
+    uint32_t& slot = assureSlot(entity.index);
+    if (slot != Tombstone) {
+        throw std::runtime_error("Entity index is already present in the sparse set.");
+    }
+
+    size_t index = dense.size();
+    dense.push_back(entity);
+    changeTicks.push_back(currentTick);
+    slot = static_cast<uint32_t>(index);
+    return index;
+}
+
+inline size_t SparseSet::remove(Entity entity) {
+    size_t index = indexOf(entity);
+    if (index == npos) {
+        return npos;
+    }
+
+    // Move the last entity into the freed slot, then drop the removed entity's mapping
+    Entity last = dense.back();
+    dense[index] = last;
+    changeTicks[index] = changeTicks.back();
+    *findSlot(last.index) = static_cast<uint32_t>(index);
+    *findSlot(entity.index) = Tombstone;
+    dense.pop_back();
+    changeTicks.pop_back();
+
+    return index;
+}
+
+inline void SparseSet::swapSlots(size_t a, size_t b) {
+    std::swap(dense[a], dense[b]);
+    std::swap(changeTicks[a], changeTicks[b]);
+    *findSlot(dense[a].index) = static_cast<uint32_t>(a);
+    *findSlot(dense[b].index) = static_cast<uint32_t>(b);
+}
+
+inline void SparseSet::reserve(size_t capacity) {
+    dense.reserve(capacity);
+    changeTicks.reserve(capacity);
+    sparse.reserve((capacity + PageSize - 1) / PageSize);
+}
+
+inline void SparseSet::clear() {
+    for (const Entity& entity : dense) {
+        *findSlot(entity.index) = Tombstone;
+    }
+    dense.clear();
+    changeTicks.clear();
+}
+
+inline void SparseSet::setCurrentTick(uint32_t tick) {
+    currentTick = tick;
+}
+
+inline uint32_t SparseSet::getCurrentTick() const {
+    return currentTick;
+}
+
+inline void SparseSet::markChanged(size_t index) {
+    changeTicks[index] = currentTick;
+}
+
+inline uint32_t SparseSet::getChangeTick(size_t index) const {
+    return changeTicks[index];
+}
+
+inline bool SparseSet::changedSince(size_t index, uint32_t tick) const {
+    return changeTicks[index] > tick;
+}
+
+inline size_t SparseSet::size() const {
+    return dense.size();
+}
+
+inline bool SparseSet::empty() const {
+    return dense.empty();
+}
+
+inline Entity SparseSet::operator[](size_t index) const {
+    return dense[index];
+}
+
+inline const std::vector<Entity>& SparseSet::getEntities() const {
+    return dense;
+}
+
+} // namespace virealis
+
+#endif // VIREALIS_SPARSE_SET_H
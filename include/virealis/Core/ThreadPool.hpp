@@ -0,0 +1,124 @@
+#ifndef VIREALIS_THREAD_POOL_H
+#define VIREALIS_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <cstddef>
+
+namespace virealis {
+
+/*
+Work-stealing thread pool.
+
+Every worker owns a task deque. Tasks submitted from a worker go to the back of its own
+deque and are popped LIFO (hot in cache); idle workers steal from the front of other
+deques. Tasks submitted from outside the pool go to a shared injection queue.
+
+Threads that wait on pool work (parallelFor, SystemScheduler::run) help by running
+pending tasks instead of blocking, so a pool with zero worker threads still makes
+progress on the calling thread.
+*/
+class ThreadPool {
+public:
+    static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+    // Defaults to one worker per hardware thread, minus the calling thread
+    ThreadPool();
+    explicit ThreadPool(size_t threadCount);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void submit(std::function<void()> task);
+
+    // Runs one pending task on the calling thread; returns false if none was found
+    bool runPendingTask();
+
+    // Calls func(begin, end) over [first, last) split into chunks of at most grainSize,
+    // and returns once every chunk has run. Rethrows the first exception a chunk threw.
+    template <typename Func>
+    void parallelFor(size_t first, size_t last, size_t grainSize, Func&& func);
+
+    size_t getThreadCount() const;
+
+    // Index of the calling worker thread in [0, getThreadCount()), or npos off the pool
+    size_t getCurrentWorkerIndex() const;
+
+private:
+    struct TaskQueue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    void workerLoop(size_t workerIndex);
+    bool popTask(size_t queueIndex, std::function<void()>& task);
+    bool stealTask(size_t thiefIndex, std::function<void()>& task);
+
+    std::vector<std::unique_ptr<TaskQueue>> queues; // One per worker, plus the injection queue last
+    std::vector<std::thread> threads;
+
+    std::mutex sleepMutex;
+    std::condition_variable wakeCondition;
+    std::atomic<size_t> pendingTasks{0};
+    bool stopping = false;
+};
+
+// Inline Definitions
+
+template <typename Func>
+void ThreadPool::parallelFor(size_t first, size_t last, size_t grainSize, Func&& func) {
+    if (first >= last) {
+        return;
+    }
+    if (grainSize == 0) {
+        grainSize = 1;
+    }
+
+    size_t chunkCount = (last - first + grainSize - 1) / grainSize;
+    std::atomic<size_t> remaining{chunkCount};
+    std::exception_ptr error;
+    std::mutex errorMutex;
+
+    auto runChunk = [&](size_t chunk) {
+        size_t begin = first + chunk * grainSize;
+        size_t end = begin + grainSize < last ? begin + grainSize : last;
+        try {
+            func(begin, end);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+        remaining.fetch_sub(1, std::memory_order_acq_rel);
+    };
+
+    // The calling thread takes the first chunk itself and helps with the rest
+    for (size_t chunk = 1; chunk < chunkCount; ++chunk) {
+        submit([&runChunk, chunk] { runChunk(chunk); });
+    }
+    runChunk(0);
+
+    while (remaining.load(std::memory_order_acquire) > 0) {
+        if (!runPendingTask()) {
+            std::this_thread::yield();
+        }
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+} // namespace virealis
+
+#endif // VIREALIS_THREAD_POOL_H
@@ -0,0 +1,31 @@
+#ifndef VIREALIS_TYPE_ID_H
+#define VIREALIS_TYPE_ID_H
+
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+namespace virealis {
+
+// Small dense integer per type, assigned on first use. Stable for the lifetime of the
+// process but not across runs, so never serialize it.
+using TypeId = uint32_t;
+
+namespace detail {
+    inline std::atomic<TypeId> nextTypeId{0};
+
+    template <typename T>
+    TypeId typeIdOf() {
+        static const TypeId id = nextTypeId.fetch_add(1, std::memory_order_relaxed);
+        return id;
+    }
+}
+
+template <typename T>
+TypeId getTypeId() {
+    return detail::typeIdOf<std::remove_cv_t<std::remove_reference_t<T>>>();
+}
+
+} // namespace virealis
+
+#endif // VIREALIS_TYPE_ID_H
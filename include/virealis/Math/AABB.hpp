@@ -0,0 +1,60 @@
+#ifndef VIREALIS_AABB_H
+#define VIREALIS_AABB_H
+
+#include <virealis/Math/Vector3.hpp>
+#include <virealis/Math/Matrix3x4.hpp>
+#include <span>
+#include <iostream>
+
+namespace virealis {
+
+// Axis-aligned bounding box
+class AABB {
+public:
+    Vector3 min, max;
+
+    // Constructors
+    AABB() = default;
+    AABB(const Vector3& min, const Vector3& max) : min(min), max(max) {}
+
+    // Smallest box around the points; a degenerate box at the origin when there are none
+    static AABB fromPoints(std::span<const Vector3> points);
+
+    Vector3 getCenter() const;
+    Vector3 getExtents() const; // Half the size along each axis
+
+    // Smallest axis-aligned box around this one after the transform
+    AABB transformed(const Matrix3x4& transform) const;
+
+    bool operator==(const AABB& other) const;
+    bool operator!=(const AABB& other) const;
+
+    friend std::ostream& operator<<(std::ostream& os, const AABB& box);
+};
+
+// Inline Definitions
+
+inline Vector3 AABB::getCenter() const {
+    return (min + max) * 0.5f;
+}
+
+inline Vector3 AABB::getExtents() const {
+    return (max - min) * 0.5f;
+}
+
+inline bool AABB::operator==(const AABB& other) const {
+    return min.x == other.min.x && min.y == other.min.y && min.z == other.min.z &&
+           max.x == other.max.x && max.y == other.max.y && max.z == other.max.z;
+}
+
+inline bool AABB::operator!=(const AABB& other) const {
+    return !(*this == other);
+}
+
+inline std::ostream& operator<<(std::ostream& os, const AABB& box) {
+    return os << "[" << box.min << "] - [" << box.max << "]";
+}
+
+} // namespace virealis
+
+#endif // VIREALIS_AABB_H
@@ -0,0 +1,38 @@
+#ifndef VIREALIS_BOUNDING_SPHERE_H
+#define VIREALIS_BOUNDING_SPHERE_H
+
+#include <virealis/Math/Vector3.hpp>
+#include <virealis/Math/Matrix3x4.hpp>
+#include <span>
+#include <iostream>
+
+namespace virealis {
+
+class BoundingSphere {
+public:
+    Vector3 center;
+    float radius;
+
+    // Constructors
+    BoundingSphere() : radius(0.0f) {}
+    BoundingSphere(const Vector3& center, float radius) : center(center), radius(radius) {}
+
+    // Sphere around the points, centered on their bounding box; not the smallest one, but
+    // close for typical meshes and found in two passes
+    static BoundingSphere fromPoints(std::span<const Vector3> points);
+
+    // Sphere around this one after the transform; the largest axis scale sets the radius
+    BoundingSphere transformed(const Matrix3x4& transform) const;
+
+    friend std::ostream& operator<<(std::ostream& os, const BoundingSphere& sphere);
+};
+
+// Inline Definitions
+
+inline std::ostream& operator<<(std::ostream& os, const BoundingSphere& sphere) {
+    return os << "[" << sphere.center << "] r " << sphere.radius;
+}
+
+} // namespace virealis
+
+#endif // VIREALIS_BOUNDING_SPHERE_H
@@ -0,0 +1,107 @@
+#ifndef VIREALIS_CONSTEXPR_MATH_H
+#define VIREALIS_CONSTEXPR_MATH_H
+
+#include <virealis/Math/Constants.hpp>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+namespace virealis::ConstexprMath {
+
+/*
+sqrt, sin and cos usable in constant expressions, so that tables (sphere vertices, kernel
+weights and the like) can be computed at compile time and stored in read-only memory.
+
+During constant evaluation they work in double precision and round once to float: sqrt
+by Newton-Raphson, which rounds correctly like std::sqrt; sin and cos by reduction to
+[-pi/2, pi/2] and a degree-17 Taylor polynomial, within one ulp of std::sin and std::cos
+for |x| up to 1e5 (larger arguments lose accuracy in the reduction). At run time they
+call the <cmath> functions, so they cost nothing over using those directly.
+*/
+
+constexpr float abs(float x) {
+    return x < 0.0f ? -x : x;
+}
+
+constexpr float sqrt(float x) {
+    if (!std::is_constant_evaluated()) {
+        return std::sqrt(x);
+    }
+    if (!(x >= 0.0f)) {
+        return std::numeric_limits<float>::quiet_NaN(); // Negative or NaN
+    }
+    if (x == 0.0f || x == std::numeric_limits<float>::infinity()) {
+        return x;
+    }
+    // Scale into [0.25, 4] by powers of four, whose square roots are exact
+    double value = x;
+    double scale = 1.0;
+    while (value > 4.0) {
+        value *= 0.25;
+        scale *= 2.0;
+    }
+    while (value < 0.25) {
+        value *= 4.0;
+        scale *= 0.5;
+    }
+    double root = 0.5 * (1.0 + value);
+    for (int i = 0; i < 8; ++i) {
+        root = 0.5 * (root + value / root);
+    }
+    return static_cast<float>(root * scale);
+}
+
+namespace detail {
+
+// sin(r) for |r| <= pi/2; the first omitted term is below 4e-14
+constexpr double sinPolynomial(double r) {
+    const double r2 = r * r;
+    return r * (1.0 - r2 / 6.0 * (1.0 - r2 / 20.0 * (1.0 - r2 / 42.0 * (1.0 - r2 / 72.0 *
+           (1.0 - r2 / 110.0 * (1.0 - r2 / 156.0 * (1.0 - r2 / 210.0 * (1.0 - r2 / 272.0))))))));
+}
+
+// x - 2 pi k for the nearest integer k, in [-pi, pi]
+constexpr double reduceAngle(double x) {
+    const double turns = x / (2.0 * Constants::PI);
+    const double k = static_cast<double>(static_cast<long long>(turns + (turns >= 0.0 ? 0.5 : -0.5)));
+    return x - k * (2.0 * Constants::PI);
+}
+
+constexpr bool isFinite(float x) {
+    return x - x == 0.0f;
+}
+
+} // namespace detail
+
+constexpr float sin(float x) {
+    if (!std::is_constant_evaluated()) {
+        return std::sin(x);
+    }
+    if (!detail::isFinite(x)) {
+        return std::numeric_limits<float>::quiet_NaN();
+    }
+    // sin(pi - r) = sin(r) folds [-pi, pi] onto [-pi/2, pi/2]
+    double r = detail::reduceAngle(x);
+    if (r > 0.5 * Constants::PI) {
+        r = Constants::PI - r;
+    } else if (r < -0.5 * Constants::PI) {
+        r = -Constants::PI - r;
+    }
+    return static_cast<float>(detail::sinPolynomial(r));
+}
+
+constexpr float cos(float x) {
+    if (!std::is_constant_evaluated()) {
+        return std::cos(x);
+    }
+    if (!detail::isFinite(x)) {
+        return std::numeric_limits<float>::quiet_NaN();
+    }
+    // cos(r) = sin(pi/2 - |r|), and pi/2 - |r| lies in [-pi/2, pi/2]
+    const double r = detail::reduceAngle(x);
+    return static_cast<float>(detail::sinPolynomial(0.5 * Constants::PI - (r < 0.0 ? -r : r)));
+}
+
+} // namespace virealis::ConstexprMath
+
+#endif // VIREALIS_CONSTEXPR_MATH_H
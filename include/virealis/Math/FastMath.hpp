@@ -0,0 +1,53 @@
+#ifndef VIREALIS_FAST_MATH_H
+#define VIREALIS_FAST_MATH_H
+
+#include <span>
+
+namespace virealis::FastMath {
+
+/*
+sin and cos, exp, 1/sqrt, atan2 and acos for loops that call them per vertex or per
+particle, such as procedural meshes and SPH kernels.
+
+Each function reduces its argument to a short interval and evaluates a polynomial there.
+Precise stays within a few ulps of the exact result, like <cmath>; Fast uses shorter
+polynomials (and the hardware 1/sqrt estimate) for at least 14 correct bits, plenty for
+positions, normals and simulation weights. Maximum errors, measured against double
+precision over the whole domain on every SIMD path (tests/FastMathTest.cpp enforces them):
+
+    function   domain                Precise    Fast
+    sincos     |x| <= 8192           2.5 ulp    1.6e-5 relative
+    exp        all x                 1 ulp      5.5e-6 relative
+    rsqrt      x >= FLT_MIN          1.5 ulp    4 ulp
+    atan2      all x, y              3.5 ulp    2.3e-5 relative
+    acos       [-1, 1]               1.5 ulp    3.8e-5 relative
+
+sincos hands arguments beyond |x| = 8192 to std::sin and std::cos, which costs more but
+stays accurate. exp flushes results below FLT_MIN to zero, and Fast rsqrt on x86
+treats subnormals as zero. Infinities, NaNs and signed zeros follow <cmath> otherwise.
+
+The batch forms take spans and run on the fastest SIMD path the CPU supports (see
+Simd.hpp); every path stays within the bounds above, and outputs may alias inputs.
+*/
+
+enum class Precision { Precise, Fast };
+
+// Single values
+void sincos(float x, float& sine, float& cosine, Precision precision = Precision::Precise);
+float exp(float x, Precision precision = Precision::Precise);
+float rsqrt(float x, Precision precision = Precision::Precise);
+float atan2(float y, float x, Precision precision = Precision::Precise);
+float acos(float x, Precision precision = Precision::Precise);
+
+// Batch forms, one output per input; spans of different lengths throw std::runtime_error
+void sincos(std::span<const float> x, std::span<float> sines, std::span<float> cosines,
+            Precision precision = Precision::Precise);
+void exp(std::span<const float> x, std::span<float> out, Precision precision = Precision::Precise);
+void rsqrt(std::span<const float> x, std::span<float> out, Precision precision = Precision::Precise);
+void atan2(std::span<const float> y, std::span<const float> x, std::span<float> out,
+           Precision precision = Precision::Precise);
+void acos(std::span<const float> x, std::span<float> out, Precision precision = Precision::Precise);
+
+} // namespace virealis::FastMath
+
+#endif // VIREALIS_FAST_MATH_H
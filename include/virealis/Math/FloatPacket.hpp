@@ -0,0 +1,555 @@
+#ifndef VIREALIS_FLOAT_PACKET_H
+#define VIREALIS_FLOAT_PACKET_H
+
+#include <virealis/Math/Simd.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace virealis {
+
+/*
+Packets of 4 or 8 floats, one value per lane, with every operation applied lane by lane.
+Kernels written against them (usually through Vec3x4 and Vec3x8) process 4 or 8 elements
+per step without touching intrinsics.
+
+They use the instruction set the build targets (see Simd.hpp): Floatx4 is one SSE
+register, or four floats without SIMD; Floatx8 is one AVX register on AVX2 builds, or
+else two Floatx4 halves, so code using it stays portable and merely loses width.
+
+Comparisons give masks, which pick lanes with select():
+
+    Floatx4 distance = ...;
+    Floatx4 clamped = select(distance > limit, limit, distance);
+*/
+
+class Floatx4;
+
+// Result of a lane-wise comparison of Floatx4s
+class Maskx4 {
+public:
+    Maskx4 operator&(const Maskx4& m) const;
+    Maskx4 operator|(const Maskx4& m) const;
+    Maskx4 operator^(const Maskx4& m) const;
+    Maskx4 operator!() const;
+
+    bool any() const;
+    bool all() const;
+    bool none() const;
+    // Lane i in bit i
+    int bits() const;
+
+private:
+    friend class Floatx4;
+    friend Floatx4 select(const Maskx4& mask, const Floatx4& a, const Floatx4& b);
+
+#if VIREALIS_SIMD_SSE2
+    explicit Maskx4(__m128 lanes) : lanes(lanes) {}
+    __m128 lanes; // All bits set in selected lanes
+#else
+    explicit Maskx4(int lanes) : lanes(lanes) {}
+    int lanes; // Lane i in bit i
+#endif
+};
+
+class Floatx4 {
+public:
+    static constexpr size_t Width = 4;
+
+    // Constructors
+    Floatx4() : Floatx4(0.0f) {}
+    Floatx4(float value); // Same value in every lane
+    Floatx4(float l0, float l1, float l2, float l3);
+
+    // Load and store helpers; the partial forms touch only the first count lanes and
+    // zero the rest on loading
+    static Floatx4 load(const float* source);
+    static Floatx4 loadPartial(const float* source, size_t count);
+    static Floatx4 gather(const float* source, const uint32_t* indices);
+    void store(float* destination) const;
+    void storePartial(float* destination, size_t count) const;
+
+    // Splits four packed (x, y, z) triples into one packet per component, and back
+    static void deinterleave3(const float* source, Floatx4& x, Floatx4& y, Floatx4& z);
+    static void interleave3(const Floatx4& x, const Floatx4& y, const Floatx4& z, float* destination);
+
+    float operator[](size_t lane) const;
+
+    // Arithmetic
+    Floatx4 operator+(const Floatx4& v) const;
+    Floatx4 operator-(const Floatx4& v) const;
+    Floatx4 operator*(const Floatx4& v) const;
+    Floatx4 operator/(const Floatx4& v) const;
+    Floatx4 operator-() const;
+    Floatx4& operator+=(const Floatx4& v);
+    Floatx4& operator-=(const Floatx4& v);
+    Floatx4& operator*=(const Floatx4& v);
+
+    // Comparisons
+    Maskx4 operator<(const Floatx4& v) const;
+    Maskx4 operator<=(const Floatx4& v) const;
+    Maskx4 operator>(const Floatx4& v) const;
+    Maskx4 operator>=(const Floatx4& v) const;
+    Maskx4 operator==(const Floatx4& v) const;
+
+    // Lane-wise functions
+    static Floatx4 Min(const Floatx4& a, const Floatx4& b);
+    static Floatx4 Max(const Floatx4& a, const Floatx4& b);
+    Floatx4 abs() const;
+    Floatx4 sqrt() const;
+    // 1 / sqrt, from the hardware estimate refined by one Newton-Raphson step (about
+    // 22 bits); exact without SIMD
+    Floatx4 rsqrt() const;
+
+    float sum() const;
+
+    // a where mask is set, else b
+    friend Floatx4 select(const Maskx4& mask, const Floatx4& a, const Floatx4& b);
+
+private:
+    friend class Floatx8;
+
+#if VIREALIS_SIMD_SSE2
+    explicit Floatx4(__m128 lanes) : lanes(lanes) {}
+    __m128 lanes;
+#else
+    float lanes[4];
+#endif
+};
+
+class Floatx8;
+
+// Result of a lane-wise comparison of Floatx8s
+class Maskx8 {
+public:
+    Maskx8 operator&(const Maskx8& m) const;
+    Maskx8 operator|(const Maskx8& m) const;
+    Maskx8 operator^(const Maskx8& m) const;
+    Maskx8 operator!() const;
+
+    bool any() const;
+    bool all() const;
+    bool none() const;
+    // Lane i in bit i
+    int bits() const;
+
+private:
+    friend class Floatx8;
+    friend Floatx8 select(const Maskx8& mask, const Floatx8& a, const Floatx8& b);
+
+#if VIREALIS_SIMD_AVX2
+    explicit Maskx8(__m256 lanes) : lanes(lanes) {}
+    __m256 lanes;
+#else
+    Maskx8(const Maskx4& lo, const Maskx4& hi) : lo(lo), hi(hi) {}
+    Maskx4 lo, hi;
+#endif
+};
+
+class Floatx8 {
+public:
+    static constexpr size_t Width = 8;
+
+    // Constructors
+    Floatx8() : Floatx8(0.0f) {}
+    Floatx8(float value); // Same value in every lane
+    Floatx8(const Floatx4& lo, const Floatx4& hi);
+
+    // Lanes 0-3 and 4-7
+    Floatx4 low() const;
+    Floatx4 high() const;
+
+    // Load and store helpers; the partial forms touch only the first count lanes and
+    // zero the rest on loading
+    static Floatx8 load(const float* source);
+    static Floatx8 loadPartial(const float* source, size_t count);
+    static Floatx8 gather(const float* source, const uint32_t* indices);
+    void store(float* destination) const;
+    void storePartial(float* destination, size_t count) const;
+
+    // Splits eight packed (x, y, z) triples into one packet per component, and back
+    static void deinterleave3(const float* source, Floatx8& x, Floatx8& y, Floatx8& z);
+    static void interleave3(const Floatx8& x, const Floatx8& y, const Floatx8& z, float* destination);
+
+    float operator[](size_t lane) const;
+
+    // Arithmetic
+    Floatx8 operator+(const Floatx8& v) const;
+    Floatx8 operator-(const Floatx8& v) const;
+    Floatx8 operator*(const Floatx8& v) const;
+    Floatx8 operator/(const Floatx8& v) const;
+    Floatx8 operator-() const;
+    Floatx8& operator+=(const Floatx8& v);
+    Floatx8& operator-=(const Floatx8& v);
+    Floatx8& operator*=(const Floatx8& v);
+
+    // Comparisons
+    Maskx8 operator<(const Floatx8& v) const;
+    Maskx8 operator<=(const Floatx8& v) const;
+    Maskx8 operator>(const Floatx8& v) const;
+    Maskx8 operator>=(const Floatx8& v) const;
+    Maskx8 operator==(const Floatx8& v) const;
+
+    // Lane-wise functions
+    static Floatx8 Min(const Floatx8& a, const Floatx8& b);
+    static Floatx8 Max(const Floatx8& a, const Floatx8& b);
+    Floatx8 abs() const;
+    Floatx8 sqrt() const;
+    // 1 / sqrt, as Floatx4::rsqrt
+    Floatx8 rsqrt() const;
+
+    float sum() const;
+
+    // a where mask is set, else b
+    friend Floatx8 select(const Maskx8& mask, const Floatx8& a, const Floatx8& b);
+
+private:
+#if VIREALIS_SIMD_AVX2
+    explicit Floatx8(__m256 lanes) : lanes(lanes) {}
+    __m256 lanes;
+#else
+    Floatx4 lo, hi;
+#endif
+};
+
+// Inline Definitions
+
+#if VIREALIS_SIMD_SSE2
+
+inline Maskx4 Maskx4::operator&(const Maskx4& m) const { return Maskx4(_mm_and_ps(lanes, m.lanes)); }
+inline Maskx4 Maskx4::operator|(const Maskx4& m) const { return Maskx4(_mm_or_ps(lanes, m.lanes)); }
+inline Maskx4 Maskx4::operator^(const Maskx4& m) const { return Maskx4(_mm_xor_ps(lanes, m.lanes)); }
+inline Maskx4 Maskx4::operator!() const {
+    return Maskx4(_mm_xor_ps(lanes, _mm_castsi128_ps(_mm_set1_epi32(-1))));
+}
+inline int Maskx4::bits() const { return _mm_movemask_ps(lanes); }
+
+inline Floatx4::Floatx4(float value) : lanes(_mm_set1_ps(value)) {}
+inline Floatx4::Floatx4(float l0, float l1, float l2, float l3) : lanes(_mm_setr_ps(l0, l1, l2, l3)) {}
+
+inline Floatx4 Floatx4::load(const float* source) { return Floatx4(_mm_loadu_ps(source)); }
+inline void Floatx4::store(float* destination) const { _mm_storeu_ps(destination, lanes); }
+
+inline void Floatx4::deinterleave3(const float* source, Floatx4& x, Floatx4& y, Floatx4& z) {
+    // a = (x0 y0 z0 x1), b = (y1 z1 x2 y2), c = (z2 x3 y3 z3)
+    const __m128 a = _mm_loadu_ps(source);
+    const __m128 b = _mm_loadu_ps(source + 4);
+    const __m128 c = _mm_loadu_ps(source + 8);
+    const __m128 bx = _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2));  // x2 x2 x3 x3
+    const __m128 ay = _mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1));  // y0 y0 y1 y1
+    const __m128 by = _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3));  // y2 y2 y3 y3
+    const __m128 az = _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2));  // z0 z0 z1 z1
+    x = Floatx4(_mm_shuffle_ps(a, bx, _MM_SHUFFLE(2, 0, 3, 0)));
+    y = Floatx4(_mm_shuffle_ps(ay, by, _MM_SHUFFLE(2, 0, 2, 0)));
+    z = Floatx4(_mm_shuffle_ps(az, c, _MM_SHUFFLE(3, 0, 2, 0)));
+}
+
+inline void Floatx4::interleave3(const Floatx4& x, const Floatx4& y, const Floatx4& z, float* destination) {
+    const __m128 xy0 = _mm_shuffle_ps(x.lanes, y.lanes, _MM_SHUFFLE(0, 0, 0, 0)); // x0 x0 y0 y0
+    const __m128 zx0 = _mm_shuffle_ps(z.lanes, x.lanes, _MM_SHUFFLE(1, 1, 0, 0)); // z0 z0 x1 x1
+    const __m128 yz1 = _mm_shuffle_ps(y.lanes, z.lanes, _MM_SHUFFLE(1, 1, 1, 1)); // y1 y1 z1 z1
+    const __m128 xy2 = _mm_shuffle_ps(x.lanes, y.lanes, _MM_SHUFFLE(2, 2, 2, 2)); // x2 x2 y2 y2
+    const __m128 zx2 = _mm_shuffle_ps(z.lanes, x.lanes, _MM_SHUFFLE(3, 3, 2, 2)); // z2 z2 x3 x3
+    const __m128 yz3 = _mm_shuffle_ps(y.lanes, z.lanes, _MM_SHUFFLE(3, 3, 3, 3)); // y3 y3 z3 z3
+    _mm_storeu_ps(destination, _mm_shuffle_ps(xy0, zx0, _MM_SHUFFLE(2, 0, 2, 0)));
+    _mm_storeu_ps(destination + 4, _mm_shuffle_ps(yz1, xy2, _MM_SHUFFLE(2, 0, 2, 0)));
+    _mm_storeu_ps(destination + 8, _mm_shuffle_ps(zx2, yz3, _MM_SHUFFLE(2, 0, 2, 0)));
+}
+
+inline Floatx4 Floatx4::operator+(const Floatx4& v) const { return Floatx4(_mm_add_ps(lanes, v.lanes)); }
+inline Floatx4 Floatx4::operator-(const Floatx4& v) const { return Floatx4(_mm_sub_ps(lanes, v.lanes)); }
+inline Floatx4 Floatx4::operator*(const Floatx4& v) const { return Floatx4(_mm_mul_ps(lanes, v.lanes)); }
+inline Floatx4 Floatx4::operator/(const Floatx4& v) const { return Floatx4(_mm_div_ps(lanes, v.lanes)); }
+inline Floatx4 Floatx4::operator-() const { return Floatx4(_mm_xor_ps(lanes, _mm_set1_ps(-0.0f))); }
+
+inline Maskx4 Floatx4::operator<(const Floatx4& v) const { return Maskx4(_mm_cmplt_ps(lanes, v.lanes)); }
+inline Maskx4 Floatx4::operator<=(const Floatx4& v) const { return Maskx4(_mm_cmple_ps(lanes, v.lanes)); }
+inline Maskx4 Floatx4::operator>(const Floatx4& v) const { return Maskx4(_mm_cmpgt_ps(lanes, v.lanes)); }
+inline Maskx4 Floatx4::operator>=(const Floatx4& v) const { return Maskx4(_mm_cmpge_ps(lanes, v.lanes)); }
+inline Maskx4 Floatx4::operator==(const Floatx4& v) const { return Maskx4(_mm_cmpeq_ps(lanes, v.lanes)); }
+
+inline Floatx4 Floatx4::Min(const Floatx4& a, const Floatx4& b) { return Floatx4(_mm_min_ps(a.lanes, b.lanes)); }
+inline Floatx4 Floatx4::Max(const Floatx4& a, const Floatx4& b) { return Floatx4(_mm_max_ps(a.lanes, b.lanes)); }
+inline Floatx4 Floatx4::abs() const { return Floatx4(_mm_andnot_ps(_mm_set1_ps(-0.0f), lanes)); }
+inline Floatx4 Floatx4::sqrt() const { return Floatx4(_mm_sqrt_ps(lanes)); }
+
+inline Floatx4 Floatx4::rsqrt() const {
+    // y' = y (1.5 - 0.5 x y^2) roughly doubles the estimate's 12 correct bits
+    const __m128 estimate = _mm_rsqrt_ps(lanes);
+    const __m128 halfX = _mm_mul_ps(lanes, _mm_set1_ps(0.5f));
+    const __m128 correction = _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(halfX, _mm_mul_ps(estimate, estimate)));
+    return Floatx4(_mm_mul_ps(estimate, correction));
+}
+
+inline Floatx4 select(const Maskx4& mask, const Floatx4& a, const Floatx4& b) {
+#if VIREALIS_SIMD_SSE41
+    return Floatx4(_mm_blendv_ps(b.lanes, a.lanes, mask.lanes));
+#else
+    return Floatx4(_mm_or_ps(_mm_and_ps(mask.lanes, a.lanes), _mm_andnot_ps(mask.lanes, b.lanes)));
+#endif
+}
+
+#else
+
+inline Maskx4 Maskx4::operator&(const Maskx4& m) const { return Maskx4(lanes & m.lanes); }
+inline Maskx4 Maskx4::operator|(const Maskx4& m) const { return Maskx4(lanes | m.lanes); }
+inline Maskx4 Maskx4::operator^(const Maskx4& m) const { return Maskx4(lanes ^ m.lanes); }
+inline Maskx4 Maskx4::operator!() const { return Maskx4(~lanes & 0xF); }
+inline int Maskx4::bits() const { return lanes; }
+
+inline Floatx4::Floatx4(float value) : lanes{ value, value, value, value } {}
+inline Floatx4::Floatx4(float l0, float l1, float l2, float l3) : lanes{ l0, l1, l2, l3 } {}
+
+inline Floatx4 Floatx4::load(const float* source) { return Floatx4(source[0], source[1], source[2], source[3]); }
+inline void Floatx4::store(float* destination) const { std::copy(lanes, lanes + 4, destination); }
+
+inline void Floatx4::deinterleave3(const float* source, Floatx4& x, Floatx4& y, Floatx4& z) {
+    x = Floatx4(source[0], source[3], source[6], source[9]);
+    y = Floatx4(source[1], source[4], source[7], source[10]);
+    z = Floatx4(source[2], source[5], source[8], source[11]);
+}
+
+inline void Floatx4::interleave3(const Floatx4& x, const Floatx4& y, const Floatx4& z, float* destination) {
+    for (size_t i = 0; i < 4; ++i) {
+        destination[i * 3 + 0] = x.lanes[i];
+        destination[i * 3 + 1] = y.lanes[i];
+        destination[i * 3 + 2] = z.lanes[i];
+    }
+}
+
+inline Floatx4 Floatx4::operator+(const Floatx4& v) const {
+    return Floatx4(lanes[0] + v.lanes[0], lanes[1] + v.lanes[1], lanes[2] + v.lanes[2], lanes[3] + v.lanes[3]);
+}
+inline Floatx4 Floatx4::operator-(const Floatx4& v) const {
+    return Floatx4(lanes[0] - v.lanes[0], lanes[1] - v.lanes[1], lanes[2] - v.lanes[2], lanes[3] - v.lanes[3]);
+}
+inline Floatx4 Floatx4::operator*(const Floatx4& v) const {
+    return Floatx4(lanes[0] * v.lanes[0], lanes[1] * v.lanes[1], lanes[2] * v.lanes[2], lanes[3] * v.lanes[3]);
+}
+inline Floatx4 Floatx4::operator/(const Floatx4& v) const {
+    return Floatx4(lanes[0] / v.lanes[0], lanes[1] / v.lanes[1], lanes[2] / v.lanes[2], lanes[3] / v.lanes[3]);
+}
+inline Floatx4 Floatx4::operator-() const { return Floatx4(-lanes[0], -lanes[1], -lanes[2], -lanes[3]); }
+
+// Lane i of the comparison in bit i
+#define VIREALIS_COMPARE_LANES(op)                                                          \
+    Maskx4(((lanes[0] op v.lanes[0]) << 0) | ((lanes[1] op v.lanes[1]) << 1) |              \
+           ((lanes[2] op v.lanes[2]) << 2) | ((lanes[3] op v.lanes[3]) << 3))
+
+inline Maskx4 Floatx4::operator<(const Floatx4& v) const { return VIREALIS_COMPARE_LANES(<); }
+inline Maskx4 Floatx4::operator<=(const Floatx4& v) const { return VIREALIS_COMPARE_LANES(<=); }
+inline Maskx4 Floatx4::operator>(const Floatx4& v) const { return VIREALIS_COMPARE_LANES(>); }
+inline Maskx4 Floatx4::operator>=(const Floatx4& v) const { return VIREALIS_COMPARE_LANES(>=); }
+inline Maskx4 Floatx4::operator==(const Floatx4& v) const { return VIREALIS_COMPARE_LANES(==); }
+
+#undef VIREALIS_COMPARE_LANES
+
+inline Floatx4 Floatx4::Min(const Floatx4& a, const Floatx4& b) {
+    return Floatx4(std::min(a.lanes[0], b.lanes[0]), std::min(a.lanes[1], b.lanes[1]),
+                   std::min(a.lanes[2], b.lanes[2]), std::min(a.lanes[3], b.lanes[3]));
+}
+inline Floatx4 Floatx4::Max(const Floatx4& a, const Floatx4& b) {
+    return Floatx4(std::max(a.lanes[0], b.lanes[0]), std::max(a.lanes[1], b.lanes[1]),
+                   std::max(a.lanes[2], b.lanes[2]), std::max(a.lanes[3], b.lanes[3]));
+}
+inline Floatx4 Floatx4::abs() const {
+    return Floatx4(std::fabs(lanes[0]), std::fabs(lanes[1]), std::fabs(lanes[2]), std::fabs(lanes[3]));
+}
+inline Floatx4 Floatx4::sqrt() const {
+    return Floatx4(std::sqrt(lanes[0]), std::sqrt(lanes[1]), std::sqrt(lanes[2]), std::sqrt(lanes[3]));
+}
+inline Floatx4 Floatx4::rsqrt() const {
+    return Floatx4(1.0f) / sqrt();
+}
+
+inline Floatx4 select(const Maskx4& mask, const Floatx4& a, const Floatx4& b) {
+    Floatx4 result;
+    for (int i = 0; i < 4; ++i) {
+        result.lanes[i] = (mask.lanes >> i) & 1 ? a.lanes[i] : b.lanes[i];
+    }
+    return result;
+}
+
+#endif // VIREALIS_SIMD_SSE2
+
+inline bool Maskx4::any() const { return bits() != 0; }
+inline bool Maskx4::all() const { return bits() == 0xF; }
+inline bool Maskx4::none() const { return bits() == 0; }
+
+inline Floatx4 Floatx4::loadPartial(const float* source, size_t count) {
+    float lanes[4] = {};
+    std::copy(source, source + std::min<size_t>(count, 4), lanes);
+    return load(lanes);
+}
+
+inline Floatx4 Floatx4::gather(const float* source, const uint32_t* indices) {
+    return Floatx4(source[indices[0]], source[indices[1]], source[indices[2]], source[indices[3]]);
+}
+
+inline void Floatx4::storePartial(float* destination, size_t count) const {
+    float lanes[4];
+    store(lanes);
+    std::copy(lanes, lanes + std::min<size_t>(count, 4), destination);
+}
+
+inline float Floatx4::operator[](size_t lane) const {
+    float lanes[4];
+    store(lanes);
+    return lanes[lane];
+}
+
+inline float Floatx4::sum() const {
+    float lanes[4];
+    store(lanes);
+    return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+}
+
+inline Floatx4& Floatx4::operator+=(const Floatx4& v) { return *this = *this + v; }
+inline Floatx4& Floatx4::operator-=(const Floatx4& v) { return *this = *this - v; }
+inline Floatx4& Floatx4::operator*=(const Floatx4& v) { return *this = *this * v; }
+
+#if VIREALIS_SIMD_AVX2
+
+inline Maskx8 Maskx8::operator&(const Maskx8& m) const { return Maskx8(_mm256_and_ps(lanes, m.lanes)); }
+inline Maskx8 Maskx8::operator|(const Maskx8& m) const { return Maskx8(_mm256_or_ps(lanes, m.lanes)); }
+inline Maskx8 Maskx8::operator^(const Maskx8& m) const { return Maskx8(_mm256_xor_ps(lanes, m.lanes)); }
+inline Maskx8 Maskx8::operator!() const {
+    return Maskx8(_mm256_xor_ps(lanes, _mm256_castsi256_ps(_mm256_set1_epi32(-1))));
+}
+inline int Maskx8::bits() const { return _mm256_movemask_ps(lanes); }
+
+inline Floatx8::Floatx8(float value) : lanes(_mm256_set1_ps(value)) {}
+inline Floatx8::Floatx8(const Floatx4& lo, const Floatx4& hi) : lanes(_mm256_set_m128(hi.lanes, lo.lanes)) {}
+inline Floatx4 Floatx8::low() const { return Floatx4(_mm256_castps256_ps128(lanes)); }
+inline Floatx4 Floatx8::high() const { return Floatx4(_mm256_extractf128_ps(lanes, 1)); }
+
+inline Floatx8 Floatx8::load(const float* source) { return Floatx8(_mm256_loadu_ps(source)); }
+inline void Floatx8::store(float* destination) const { _mm256_storeu_ps(destination, lanes); }
+
+inline Floatx8 Floatx8::operator+(const Floatx8& v) const { return Floatx8(_mm256_add_ps(lanes, v.lanes)); }
+inline Floatx8 Floatx8::operator-(const Floatx8& v) const { return Floatx8(_mm256_sub_ps(lanes, v.lanes)); }
+inline Floatx8 Floatx8::operator*(const Floatx8& v) const { return Floatx8(_mm256_mul_ps(lanes, v.lanes)); }
+inline Floatx8 Floatx8::operator/(const Floatx8& v) const { return Floatx8(_mm256_div_ps(lanes, v.lanes)); }
+inline Floatx8 Floatx8::operator-() const { return Floatx8(_mm256_xor_ps(lanes, _mm256_set1_ps(-0.0f))); }
+
+inline Maskx8 Floatx8::operator<(const Floatx8& v) const { return Maskx8(_mm256_cmp_ps(lanes, v.lanes, _CMP_LT_OQ)); }
+inline Maskx8 Floatx8::operator<=(const Floatx8& v) const { return Maskx8(_mm256_cmp_ps(lanes, v.lanes, _CMP_LE_OQ)); }
+inline Maskx8 Floatx8::operator>(const Floatx8& v) const { return Maskx8(_mm256_cmp_ps(lanes, v.lanes, _CMP_GT_OQ)); }
+inline Maskx8 Floatx8::operator>=(const Floatx8& v) const { return Maskx8(_mm256_cmp_ps(lanes, v.lanes, _CMP_GE_OQ)); }
+inline Maskx8 Floatx8::operator==(const Floatx8& v) const { return Maskx8(_mm256_cmp_ps(lanes, v.lanes, _CMP_EQ_OQ)); }
+
+inline Floatx8 Floatx8::Min(const Floatx8& a, const Floatx8& b) { return Floatx8(_mm256_min_ps(a.lanes, b.lanes)); }
+inline Floatx8 Floatx8::Max(const Floatx8& a, const Floatx8& b) { return Floatx8(_mm256_max_ps(a.lanes, b.lanes)); }
+inline Floatx8 Floatx8::abs() const { return Floatx8(_mm256_andnot_ps(_mm256_set1_ps(-0.0f), lanes)); }
+inline Floatx8 Floatx8::sqrt() const { return Floatx8(_mm256_sqrt_ps(lanes)); }
+
+inline Floatx8 Floatx8::rsqrt() const {
+    const __m256 estimate = _mm256_rsqrt_ps(lanes);
+    const __m256 halfX = _mm256_mul_ps(lanes, _mm256_set1_ps(0.5f));
+    const __m256 correction = _mm256_fnmadd_ps(halfX, _mm256_mul_ps(estimate, estimate), _mm256_set1_ps(1.5f));
+    return Floatx8(_mm256_mul_ps(estimate, correction));
+}
+
+inline Floatx8 select(const Maskx8& mask, const Floatx8& a, const Floatx8& b) {
+    return Floatx8(_mm256_blendv_ps(b.lanes, a.lanes, mask.lanes));
+}
+
+#else
+
+inline Maskx8 Maskx8::operator&(const Maskx8& m) const { return Maskx8(lo & m.lo, hi & m.hi); }
+inline Maskx8 Maskx8::operator|(const Maskx8& m) const { return Maskx8(lo | m.lo, hi | m.hi); }
+inline Maskx8 Maskx8::operator^(const Maskx8& m) const { return Maskx8(lo ^ m.lo, hi ^ m.hi); }
+inline Maskx8 Maskx8::operator!() const { return Maskx8(!lo, !hi); }
+inline int Maskx8::bits() const { return lo.bits() | (hi.bits() << 4); }
+
+inline Floatx8::Floatx8(float value) : lo(value), hi(value) {}
+inline Floatx8::Floatx8(const Floatx4& lo, const Floatx4& hi) : lo(lo), hi(hi) {}
+inline Floatx4 Floatx8::low() const { return lo; }
+inline Floatx4 Floatx8::high() const { return hi; }
+
+inline Floatx8 Floatx8::load(const float* source) { return Floatx8(Floatx4::load(source), Floatx4::load(source + 4)); }
+inline void Floatx8::store(float* destination) const {
+    lo.store(destination);
+    hi.store(destination + 4);
+}
+
+inline Floatx8 Floatx8::operator+(const Floatx8& v) const { return Floatx8(lo + v.lo, hi + v.hi); }
+inline Floatx8 Floatx8::operator-(const Floatx8& v) const { return Floatx8(lo - v.lo, hi - v.hi); }
+inline Floatx8 Floatx8::operator*(const Floatx8& v) const { return Floatx8(lo * v.lo, hi * v.hi); }
+inline Floatx8 Floatx8::operator/(const Floatx8& v) const { return Floatx8(lo / v.lo, hi / v.hi); }
+inline Floatx8 Floatx8::operator-() const { return Floatx8(-lo, -hi); }
+
+inline Maskx8 Floatx8::operator<(const Floatx8& v) const { return Maskx8(lo < v.lo, hi < v.hi); }
+inline Maskx8 Floatx8::operator<=(const Floatx8& v) const { return Maskx8(lo <= v.lo, hi <= v.hi); }
+inline Maskx8 Floatx8::operator>(const Floatx8& v) const { return Maskx8(lo > v.lo, hi > v.hi); }
+inline Maskx8 Floatx8::operator>=(const Floatx8& v) const { return Maskx8(lo >= v.lo, hi >= v.hi); }
+inline Maskx8 Floatx8::operator==(const Floatx8& v) const { return Maskx8(lo == v.lo, hi == v.hi); }
+
+inline Floatx8 Floatx8::Min(const Floatx8& a, const Floatx8& b) {
+    return Floatx8(Floatx4::Min(a.lo, b.lo), Floatx4::Min(a.hi, b.hi));
+}
+inline Floatx8 Floatx8::Max(const Floatx8& a, const Floatx8& b) {
+    return Floatx8(Floatx4::Max(a.lo, b.lo), Floatx4::Max(a.hi, b.hi));
+}
+inline Floatx8 Floatx8::abs() const { return Floatx8(lo.abs(), hi.abs()); }
+inline Floatx8 Floatx8::sqrt() const { return Floatx8(lo.sqrt(), hi.sqrt()); }
+inline Floatx8 Floatx8::rsqrt() const { return Floatx8(lo.rsqrt(), hi.rsqrt()); }
+
+inline Floatx8 select(const Maskx8& mask, const Floatx8& a, const Floatx8& b) {
+    return Floatx8(select(mask.lo, a.lo, b.lo), select(mask.hi, a.hi, b.hi));
+}
+
+#endif // VIREALIS_SIMD_AVX2
+
+inline bool Maskx8::any() const { return bits() != 0; }
+inline bool Maskx8::all() const { return bits() == 0xFF; }
+inline bool Maskx8::none() const { return bits() == 0; }
+
+inline void Floatx8::deinterleave3(const float* source, Floatx8& x, Floatx8& y, Floatx8& z) {
+    Floatx4 x0, y0, z0, x1, y1, z1;
+    Floatx4::deinterleave3(source, x0, y0, z0);
+    Floatx4::deinterleave3(source + 12, x1, y1, z1);
+    x = Floatx8(x0, x1);
+    y = Floatx8(y0, y1);
+    z = Floatx8(z0, z1);
+}
+
+inline void Floatx8::interleave3(const Floatx8& x, const Floatx8& y, const Floatx8& z, float* destination) {
+    Floatx4::interleave3(x.low(), y.low(), z.low(), destination);
+    Floatx4::interleave3(x.high(), y.high(), z.high(), destination + 12);
+}
+
+inline Floatx8 Floatx8::loadPartial(const float* source, size_t count) {
+    float lanes[8] = {};
+    std::copy(source, source + std::min<size_t>(count, 8), lanes);
+    return load(lanes);
+}
+
+inline Floatx8 Floatx8::gather(const float* source, const uint32_t* indices) {
+    return Floatx8(Floatx4::gather(source, indices), Floatx4::gather(source, indices + 4));
+}
+
+inline void Floatx8::storePartial(float* destination, size_t count) const {
+    float lanes[8];
+    store(lanes);
+    std::copy(lanes, lanes + std::min<size_t>(count, 8), destination);
+}
+
+inline float Floatx8::operator[](size_t lane) const {
+    float lanes[8];
+    store(lanes);
+    return lanes[lane];
+}
+
+inline float Floatx8::sum() const {
+    return low().sum() + high().sum();
+}
+
+inline Floatx8& Floatx8::operator+=(const Floatx8& v) { return *this = *this + v; }
+inline Floatx8& Floatx8::operator-=(const Floatx8& v) { return *this = *this - v; }
+inline Floatx8& Floatx8::operator*=(const Floatx8& v) { return *this = *this * v; }
+
+} // namespace virealis
+
+#endif // VIREALIS_FLOAT_PACKET_H
@@ -0,0 +1,168 @@
+#ifndef VIREALIS_MATRIX3X4_H
+#define VIREALIS_MATRIX3X4_H
+
+#include <virealis/Math/Vector3.hpp>
+#include <virealis/Math/Quaternion.hpp>
+#include <virealis/Math/Simd.hpp>
+#include <array>
+#include <cstddef>
+#include <iostream>
+#include <type_traits>
+
+namespace virealis {
+
+class Matrix4x4;
+
+/*
+Affine transform stored as the top three rows of a 4x4 matrix; the implied bottom row is
+(0, 0, 0, 1). Columns 0-2 hold the rotation and scale, column 3 the translation.
+
+At 48 bytes it is a quarter smaller than a Matrix4x4, and composing two of them costs 36
+multiplies instead of 64. Rows are 16-byte aligned, so each loads into one SSE register.
+*/
+class alignas(16) Matrix3x4 {
+private:
+    std::array<float, 12> elements;
+
+public:
+    // Constructors
+    constexpr Matrix3x4() : elements{0} {};
+    constexpr Matrix3x4(const std::array<float, 12>& elements) : elements(elements) {};
+
+    // Static methods for creating specific matrices
+    static constexpr Matrix3x4 identity();
+    // Scale first, then rotate, then translate
+    static Matrix3x4 fromTranslationRotationScale(const Vector3& translation, const Quaternion& rotation,
+                                                  const Vector3& scale);
+    // Drops the bottom row; the matrix must be affine
+    static Matrix3x4 fromMatrix4x4(const Matrix4x4& matrix);
+    // Element-wise blend; close to a proper rotation only when a and b are close, as for
+    // two consecutive simulation steps
+    static constexpr Matrix3x4 lerp(const Matrix3x4& a, const Matrix3x4& b, float t);
+
+    Matrix4x4 toMatrix4x4() const;
+    constexpr Vector3 getTranslation() const;
+
+    // Batch products out[i] = a[i] * b[i], or a * b[i] for a single a, on the fastest
+    // SIMD path the CPU supports (see Simd.hpp); out may be the same array as a or b
+    static void multiplyArrays(const Matrix3x4* a, const Matrix3x4* b, Matrix3x4* out, size_t n);
+    static void multiplyArrays(const Matrix3x4& a, const Matrix3x4* b, Matrix3x4* out, size_t n);
+
+    // Operator overloads; the product is constexpr, using SIMD only at run time
+    constexpr Matrix3x4 operator*(const Matrix3x4& other) const;
+    constexpr Vector3 operator*(const Vector3& point) const;
+    constexpr float& operator()(int row, int col);
+    constexpr float operator()(int row, int col) const;
+
+    constexpr bool operator==(const Matrix3x4& other) const;
+    constexpr bool operator!=(const Matrix3x4& other) const;
+
+    // Applies only the rotation and scale, for directions
+    constexpr Vector3 transformVector(const Vector3& vector) const;
+
+    // The 12 elements, row by row
+    constexpr const float* data() const;
+
+    // Friends for I/O
+    friend std::ostream& operator<<(std::ostream& os, const Matrix3x4& matrix);
+};
+
+// Inline Definitions
+
+constexpr Matrix3x4 Matrix3x4::identity() {
+    return Matrix3x4({
+        1.0f, 0.0f, 0.0f, 0.0f,
+        0.0f, 1.0f, 0.0f, 0.0f,
+        0.0f, 0.0f, 1.0f, 0.0f
+    });
+}
+
+constexpr float& Matrix3x4::operator()(int row, int col) {
+    return elements[row * 4 + col];
+}
+
+constexpr float Matrix3x4::operator()(int row, int col) const {
+    return elements[row * 4 + col];
+}
+
+constexpr bool Matrix3x4::operator==(const Matrix3x4& other) const {
+    return elements == other.elements;
+}
+
+constexpr bool Matrix3x4::operator!=(const Matrix3x4& other) const {
+    return !(*this == other);
+}
+
+constexpr Matrix3x4 Matrix3x4::operator*(const Matrix3x4& other) const {
+    // Upper 3x3 blocks multiply; the translation is this * other's translation + ours
+    Matrix3x4 result;
+#if VIREALIS_SIMD_SSE2
+    if (!std::is_constant_evaluated()) {
+        const __m128 translationMask = _mm_castsi128_ps(_mm_set_epi32(-1, 0, 0, 0));
+        const __m128 b0 = _mm_load_ps(&other.elements[0]);
+        const __m128 b1 = _mm_load_ps(&other.elements[4]);
+        const __m128 b2 = _mm_load_ps(&other.elements[8]);
+        for (int row = 0; row < 3; ++row) {
+            const __m128 aRow = _mm_load_ps(&elements[row * 4]);
+            __m128 sum = _mm_and_ps(aRow, translationMask);
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_shuffle_ps(aRow, aRow, 0x00), b0));
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_shuffle_ps(aRow, aRow, 0x55), b1));
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_shuffle_ps(aRow, aRow, 0xAA), b2));
+            _mm_store_ps(&result.elements[row * 4], sum);
+        }
+        return result;
+    }
+#endif
+    for (int row = 0; row < 3; ++row) {
+        const float a0 = (*this)(row, 0);
+        const float a1 = (*this)(row, 1);
+        const float a2 = (*this)(row, 2);
+        for (int col = 0; col < 4; ++col) {
+            result(row, col) = a0 * other(0, col) + a1 * other(1, col) + a2 * other(2, col);
+        }
+        result(row, 3) += (*this)(row, 3);
+    }
+    return result;
+}
+
+constexpr const float* Matrix3x4::data() const {
+    return elements.data();
+}
+
+constexpr Matrix3x4 Matrix3x4::lerp(const Matrix3x4& a, const Matrix3x4& b, float t) {
+    Matrix3x4 result;
+    for (size_t i = 0; i < 12; ++i) {
+        result.elements[i] = a.elements[i] * (1.0f - t) + b.elements[i] * t;
+    }
+    return result;
+}
+
+constexpr Vector3 Matrix3x4::operator*(const Vector3& point) const {
+    return Vector3((*this)(0, 0) * point.x + (*this)(0, 1) * point.y + (*this)(0, 2) * point.z + (*this)(0, 3),
+                   (*this)(1, 0) * point.x + (*this)(1, 1) * point.y + (*this)(1, 2) * point.z + (*this)(1, 3),
+                   (*this)(2, 0) * point.x + (*this)(2, 1) * point.y + (*this)(2, 2) * point.z + (*this)(2, 3));
+}
+
+constexpr Vector3 Matrix3x4::transformVector(const Vector3& vector) const {
+    return Vector3((*this)(0, 0) * vector.x + (*this)(0, 1) * vector.y + (*this)(0, 2) * vector.z,
+                   (*this)(1, 0) * vector.x + (*this)(1, 1) * vector.y + (*this)(1, 2) * vector.z,
+                   (*this)(2, 0) * vector.x + (*this)(2, 1) * vector.y + (*this)(2, 2) * vector.z);
+}
+
+constexpr Vector3 Matrix3x4::getTranslation() const {
+    return Vector3((*this)(0, 3), (*this)(1, 3), (*this)(2, 3));
+}
+
+inline std::ostream& operator<<(std::ostream& os, const Matrix3x4& matrix) {
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            os << matrix(i, j) << " ";
+        }
+        os << std::endl;
+    }
+    return os;
+}
+
+} // namespace virealis
+
+#endif // VIREALIS_MATRIX3X4_H
@@ -2,84 +2,162 @@
 #define VIREALIS_MATRIX4X4_H
 
 #include <virealis/Math/Vector3.hpp>
+#include <virealis/Math/Vector3A.hpp>
+#include <virealis/Math/Vector4.hpp>
 #include <virealis/Math/Constants.hpp>
+#include <virealis/Math/Simd.hpp>
 #include <array>
+#include <cstddef>
 #include <iostream>
+#include <span>
+#include <type_traits>
 
 namespace virealis {
 
-class Matrix4x4 {
+// Aligned so each row loads into one SSE register; products use SIMD (see Simd.hpp)
+class alignas(16) Matrix4x4 {
 private:
     std::array<float, 16> elements;
 
 public:
     // Constructors
-    Matrix4x4() : elements{0} {};
-    Matrix4x4(const std::array<float, 16>& elements) : elements(elements) {};
+    constexpr Matrix4x4() : elements{0} {};
+    constexpr Matrix4x4(const std::array<float, 16>& elements) : elements(elements) {};
 
-    // Static methods for creating specific matrices
-    static Matrix4x4 identity();
-    static Matrix4x4 translation(const Vector3& translation);
+    // Static methods for creating specific matrices; identity, translation and scale are
+    // constexpr, for matrices built at compile time
+    static constexpr Matrix4x4 identity();
+    static constexpr Matrix4x4 translation(const Vector3& translation);
     static Matrix4x4 rotation(float angle, const Vector3& axis);
-    static Matrix4x4 scale(const Vector3& scale);
+    static constexpr Matrix4x4 scale(const Vector3& scale);
     static Matrix4x4 perspective(float fov, float aspect, float near, float far);
     static Matrix4x4 orthographic(float left, float right, float bottom, float top, float near, float far);
 
     // Matrix operations
-    Matrix4x4 transpose() const;
-    Matrix4x4 inverse() const;
+    constexpr Matrix4x4 transpose() const;
     float determinant() const;
 
-    // Operator overloads
-    Matrix4x4 operator*(const Matrix4x4& other) const;
-    Vector3 operator*(const Vector3& vector) const;
-    Matrix4x4& operator*=(const Matrix4x4& other);
-    float& operator()(int row, int col);
-    float operator()(int row, int col) const;
+    // General inverse, on the fastest SIMD path the CPU supports. The matrix must be
+    // invertible; a singular one gives non-finite elements.
+    Matrix4x4 inverse() const;
+    // Inverse of an affine matrix (bottom row 0, 0, 0, 1), such as a model matrix:
+    // inverts the upper 3x3 and maps the translation through it
+    Matrix4x4 inverseAffine() const;
+    // Inverse of a rotation plus translation with no scale, such as a view or camera
+    // matrix: transposes the rotation and negates the translation through it
+    Matrix4x4 inverseRigid() const;
+    // Batch general inverses, out[i] = in[i].inverse(); out may be the same array as in
+    static void inverseArrays(const Matrix4x4* in, Matrix4x4* out, size_t n);
+
+    // Batch products out[i] = a[i] * b[i], or a * b[i] for a single a, on the fastest
+    // SIMD path the CPU supports (see Simd.hpp); out may be the same array as a or b
+    static void multiplyArrays(const Matrix4x4* a, const Matrix4x4* b, Matrix4x4* out, size_t n);
+    static void multiplyArrays(const Matrix4x4& a, const Matrix4x4* b, Matrix4x4* out, size_t n);
+
+    // Affine point transform, like operator*(Vector3): the bottom row is ignored
+    Vector3A transformPoint(const Vector3A& point) const;
+    // Batch form, out[i] = matrix.transformPoint(in[i]), on the fastest SIMD path the
+    // CPU supports; out may be the same array as in
+    static void transformPoints(const Matrix4x4& matrix, const Vector3A* in, Vector3A* out, size_t n);
+
+    // Operator overloads; the product is constexpr, using SIMD only at run time
+    constexpr Matrix4x4 operator*(const Matrix4x4& other) const;
+    constexpr Vector3 operator*(const Vector3& vector) const;
+    Vector4 operator*(const Vector4& vector) const;
+    constexpr Matrix4x4& operator*=(const Matrix4x4& other);
+    constexpr float& operator()(int row, int col);
+    constexpr float operator()(int row, int col) const;
+
+    constexpr bool operator==(const Matrix4x4& other) const;
+    constexpr bool operator!=(const Matrix4x4& other) const;
 
     // Element-wise scalar operations
-    Matrix4x4 operator*(float scalar) const;
-    Matrix4x4 operator/(float scalar) const;
-    Matrix4x4& operator*=(float scalar);
-    Matrix4x4& operator/=(float scalar);
+    constexpr Matrix4x4 operator*(float scalar) const;
+    constexpr Matrix4x4 operator/(float scalar) const;
+    constexpr Matrix4x4& operator*=(float scalar);
+    constexpr Matrix4x4& operator/=(float scalar);
 
     // Element-wise matrix operations
-    Matrix4x4 operator+(const Matrix4x4& other) const;
-    Matrix4x4 operator-(const Matrix4x4& other) const;
-    Matrix4x4& operator+=(const Matrix4x4& other);
-    Matrix4x4& operator-=(const Matrix4x4& other);
+    constexpr Matrix4x4 operator+(const Matrix4x4& other) const;
+    constexpr Matrix4x4 operator-(const Matrix4x4& other) const;
+    constexpr Matrix4x4& operator+=(const Matrix4x4& other);
+    constexpr Matrix4x4& operator-=(const Matrix4x4& other);
 
     // Utility functions
     static Matrix4x4 lookAt(const Vector3& eye, const Vector3& target, const Vector3& up);
     static Matrix4x4 fromTranslationRotationScale(const Vector3& translation, const Vector3& rotation, const Vector3& scale);
 
     // Friends for symmetry and I/O
-    friend Matrix4x4 operator*(float scalar, const Matrix4x4& matrix);
+    friend constexpr Matrix4x4 operator*(float scalar, const Matrix4x4& matrix);
     friend std::ostream& operator<<(std::ostream& os, const Matrix4x4& matrix);
 
-    // Add this function to Matrix4x4
-    const float* data() const {
-        static std::array<float, 16> columnMajorElements;
-        for (int row = 0; row < 4; ++row) {
-            for (int col = 0; col < 4; ++col) {
-                columnMajorElements[col * 4 + row] = elements[row * 4 + col];
-            }
-        }
-        return columnMajorElements.data();
-    }
+    // The 16 elements, row by row, stored in place: safe from any thread and free to
+    // call. OpenGL takes them as they are with transpose = GL_TRUE.
+    constexpr const float* data() const;
+
+    // Writes the matrices to dst one after another, each column by column (16 floats per
+    // matrix), as instance and uniform buffers expect; dst need not be aligned
+    static void writeColumnMajor(std::span<const Matrix4x4> matrices, float* dst);
 };
 
 // Inline Definitions
 
-inline float& Matrix4x4::operator()(int row, int col) {
+constexpr Matrix4x4 Matrix4x4::identity() {
+    return Matrix4x4({
+        1.0f, 0.0f, 0.0f, 0.0f,
+        0.0f, 1.0f, 0.0f, 0.0f,
+        0.0f, 0.0f, 1.0f, 0.0f,
+        0.0f, 0.0f, 0.0f, 1.0f
+    });
+}
+
+constexpr Matrix4x4 Matrix4x4::translation(const Vector3& translation) {
+    Matrix4x4 result = Matrix4x4::identity();
+    result(0, 3) = translation.x;
+    result(1, 3) = translation.y;
+    result(2, 3) = translation.z;
+    return result;
+}
+
+constexpr Matrix4x4 Matrix4x4::scale(const Vector3& scale) {
+    Matrix4x4 result = Matrix4x4::identity();
+    result(0, 0) = scale.x;
+    result(1, 1) = scale.y;
+    result(2, 2) = scale.z;
+    return result;
+}
+
+constexpr Matrix4x4 Matrix4x4::transpose() const {
+    Matrix4x4 result;
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            result(i, j) = (*this)(j, i);
+        }
+    }
+    return result;
+}
+
+constexpr float& Matrix4x4::operator()(int row, int col) {
     return elements[row * 4 + col];
 }
 
-inline float Matrix4x4::operator()(int row, int col) const {
+constexpr float Matrix4x4::operator()(int row, int col) const {
     return elements[row * 4 + col];
 }
 
-inline Matrix4x4 Matrix4x4::operator*(float scalar) const {
+constexpr const float* Matrix4x4::data() const {
+    return elements.data();
+}
+
+constexpr bool Matrix4x4::operator==(const Matrix4x4& other) const {
+    return elements == other.elements;
+}
+
+constexpr bool Matrix4x4::operator!=(const Matrix4x4& other) const {
+    return !(*this == other);
+}
+
+constexpr Matrix4x4 Matrix4x4::operator*(float scalar) const {
     Matrix4x4 result;
     for (int i = 0; i < 16; ++i) {
         result.elements[i] = elements[i] * scalar;
@@ -87,7 +165,7 @@ inline Matrix4x4 Matrix4x4::operator*(float scalar) const {
     return result;
 }
 
-inline Matrix4x4 Matrix4x4::operator/(float scalar) const {
+constexpr Matrix4x4 Matrix4x4::operator/(float scalar) const {
     Matrix4x4 result;
     for (int i = 0; i < 16; ++i) {
         result.elements[i] = elements[i] / scalar;
@@ -95,36 +173,101 @@ inline Matrix4x4 Matrix4x4::operator/(float scalar) const {
     return result;
 }
 
-inline Matrix4x4& Matrix4x4::operator*=(float scalar) {
+constexpr Matrix4x4& Matrix4x4::operator*=(float scalar) {
     for (int i = 0; i < 16; ++i) {
         elements[i] *= scalar;
     }
     return *this;
 }
 
-inline Matrix4x4& Matrix4x4::operator/=(float scalar) {
+constexpr Matrix4x4& Matrix4x4::operator/=(float scalar) {
     for (int i = 0; i < 16; ++i) {
         elements[i] /= scalar;
     }
     return *this;
 }
 
-inline Matrix4x4 Matrix4x4::operator*(const Matrix4x4& other) const {
-    Matrix4x4 result;
+#if VIREALIS_SIMD_SSE2
+
+inline Vector4 Matrix4x4::operator*(const Vector4& vector) const {
+    // Four row-by-vector products, transposed so that adding them gives the four dot products
+    const __m128 v = _mm_load_ps(&vector.x);
+    __m128 p0 = _mm_mul_ps(_mm_load_ps(&elements[0]), v);
+    __m128 p1 = _mm_mul_ps(_mm_load_ps(&elements[4]), v);
+    __m128 p2 = _mm_mul_ps(_mm_load_ps(&elements[8]), v);
+    __m128 p3 = _mm_mul_ps(_mm_load_ps(&elements[12]), v);
+    _MM_TRANSPOSE4_PS(p0, p1, p2, p3);
+    Vector4 result;
+    _mm_store_ps(&result.x, _mm_add_ps(_mm_add_ps(p0, p1), _mm_add_ps(p2, p3)));
+    return result;
+}
+
+inline Vector3A Matrix4x4::transformPoint(const Vector3A& point) const {
+    // The point's padding lane stands in for w = 1; a zero fourth row keeps the result's at zero
+    const __m128 v = _mm_add_ps(point.load(), _mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f));
+    __m128 p0 = _mm_mul_ps(_mm_load_ps(&elements[0]), v);
+    __m128 p1 = _mm_mul_ps(_mm_load_ps(&elements[4]), v);
+    __m128 p2 = _mm_mul_ps(_mm_load_ps(&elements[8]), v);
+    __m128 p3 = _mm_setzero_ps();
+    _MM_TRANSPOSE4_PS(p0, p1, p2, p3);
+    return Vector3A(_mm_add_ps(_mm_add_ps(p0, p1), _mm_add_ps(p2, p3)));
+}
+
+#else
 
+inline Vector4 Matrix4x4::operator*(const Vector4& vector) const {
+    Vector4 result;
+    float* out = &result.x;
+    for (int row = 0; row < 4; ++row) {
+        out[row] = (*this)(row, 0) * vector.x + (*this)(row, 1) * vector.y + (*this)(row, 2) * vector.z +
+                   (*this)(row, 3) * vector.w;
+    }
+    return result;
+}
+
+inline Vector3A Matrix4x4::transformPoint(const Vector3A& point) const {
+    return Vector3A((*this)(0, 0) * point.x + (*this)(0, 1) * point.y + (*this)(0, 2) * point.z + (*this)(0, 3),
+                    (*this)(1, 0) * point.x + (*this)(1, 1) * point.y + (*this)(1, 2) * point.z + (*this)(1, 3),
+                    (*this)(2, 0) * point.x + (*this)(2, 1) * point.y + (*this)(2, 2) * point.z + (*this)(2, 3));
+}
+
+#endif // VIREALIS_SIMD_SSE2
+
+constexpr Matrix4x4 Matrix4x4::operator*(const Matrix4x4& other) const {
+    Matrix4x4 result;
+#if VIREALIS_SIMD_SSE2
+    if (!std::is_constant_evaluated()) {
+        // Each result row is the rows of other weighted by one row of this, as in the SSE
+        // batch kernel, so both round alike
+        const __m128 b0 = _mm_load_ps(&other.elements[0]);
+        const __m128 b1 = _mm_load_ps(&other.elements[4]);
+        const __m128 b2 = _mm_load_ps(&other.elements[8]);
+        const __m128 b3 = _mm_load_ps(&other.elements[12]);
+        for (int row = 0; row < 4; ++row) {
+            const __m128 aRow = _mm_load_ps(&elements[row * 4]);
+            __m128 sum = _mm_mul_ps(_mm_shuffle_ps(aRow, aRow, 0x00), b0);
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_shuffle_ps(aRow, aRow, 0x55), b1));
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_shuffle_ps(aRow, aRow, 0xAA), b2));
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_shuffle_ps(aRow, aRow, 0xFF), b3));
+            _mm_store_ps(&result.elements[row * 4], sum);
+        }
+        return result;
+    }
+#endif
+    // Summed in the same order as the SIMD path
     for (int row = 0; row < 4; ++row) {
         for (int col = 0; col < 4; ++col) {
-            result(row, col) = 0;
-            for (int i = 0; i < 4; ++i) {
-                result(row, col) += (*this)(row, i) * other(i, col);
+            float sum = (*this)(row, 0) * other(0, col);
+            for (int i = 1; i < 4; ++i) {
+                sum += (*this)(row, i) * other(i, col);
             }
+            result(row, col) = sum;
         }
     }
-
     return result;
 }
 
-inline Vector3 Matrix4x4::operator*(const Vector3& vector) const {
+constexpr Vector3 Matrix4x4::operator*(const Vector3& vector) const {
     // Assume w = 1 for homogeneous coordinates
     float x = (*this)(0, 0) * vector.x + (*this)(0, 1) * vector.y + (*this)(0, 2) * vector.z + (*this)(0, 3);
     float y = (*this)(1, 0) * vector.x + (*this)(1, 1) * vector.y + (*this)(1, 2) * vector.z + (*this)(1, 3);
@@ -133,12 +276,12 @@ inline Vector3 Matrix4x4::operator*(const Vector3& vector) const {
     return Vector3(x, y, z);
 }
 
-inline Matrix4x4& Matrix4x4::operator*=(const Matrix4x4& other) {
+constexpr Matrix4x4& Matrix4x4::operator*=(const Matrix4x4& other) {
     *this = *this * other;  // Use the previously defined operator* for matrix multiplication
     return *this;
 }
 
-inline Matrix4x4 Matrix4x4::operator+(const Matrix4x4& other) const {
+constexpr Matrix4x4 Matrix4x4::operator+(const Matrix4x4& other) const {
     Matrix4x4 result;
     for (int i = 0; i < 16; ++i) {
         result.elements[i] = elements[i] + other.elements[i];
@@ -146,7 +289,7 @@ inline Matrix4x4 Matrix4x4::operator+(const Matrix4x4& other) const {
     return result;
 }
 
-inline Matrix4x4 Matrix4x4::operator-(const Matrix4x4& other) const {
+constexpr Matrix4x4 Matrix4x4::operator-(const Matrix4x4& other) const {
     Matrix4x4 result;
     for (int i = 0; i < 16; ++i) {
         result.elements[i] = elements[i] - other.elements[i];
@@ -154,21 +297,117 @@ inline Matrix4x4 Matrix4x4::operator-(const Matrix4x4& other) const {
     return result;
 }
 
-inline Matrix4x4& Matrix4x4::operator+=(const Matrix4x4& other) {
+constexpr Matrix4x4& Matrix4x4::operator+=(const Matrix4x4& other) {
     for (int i = 0; i < 16; ++i) {
         elements[i] += other.elements[i];
     }
     return *this;
 }
 
-inline Matrix4x4& Matrix4x4::operator-=(const Matrix4x4& other) {
+constexpr Matrix4x4& Matrix4x4::operator-=(const Matrix4x4& other) {
     for (int i = 0; i < 16; ++i) {
         elements[i] -= other.elements[i];
     }
     return *this;
 }
 
-inline Matrix4x4 operator*(float scalar, const Matrix4x4& matrix) {
+/*
+Both fast paths build the inverse's columns, which are easy to reach from our rows, and
+transpose them into rows at the end. For an affine M = [A t], inverse(M) = [inverse(A)
+-inverse(A) t]; the columns of inverse(A) are the cross products of A's rows over det(A),
+and for a rotation they are just A's rows.
+*/
+inline Matrix4x4 Matrix4x4::inverseAffine() const {
+    Matrix4x4 result;
+#if VIREALIS_SIMD_SSE2
+    const __m128 xyzMask = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+    const __m128 row0 = _mm_load_ps(&elements[0]);
+    const __m128 row1 = _mm_load_ps(&elements[4]);
+    const __m128 row2 = _mm_load_ps(&elements[8]);
+    const __m128 a0 = _mm_and_ps(row0, xyzMask);
+    const __m128 a1 = _mm_and_ps(row1, xyzMask);
+    const __m128 a2 = _mm_and_ps(row2, xyzMask);
+
+    __m128 column0 = simd::cross3(a1, a2);
+    __m128 column1 = simd::cross3(a2, a0);
+    __m128 column2 = simd::cross3(a0, a1);
+    const __m128 inverseDeterminant = _mm_div_ps(_mm_set1_ps(1.0f), simd::dot4(a0, column0));
+    column0 = _mm_mul_ps(column0, inverseDeterminant);
+    column1 = _mm_mul_ps(column1, inverseDeterminant);
+    column2 = _mm_mul_ps(column2, inverseDeterminant);
+
+    // -inverse(A) t, with the bottom row's 1 in the fourth lane
+    __m128 column3 = _mm_mul_ps(column0, _mm_shuffle_ps(row0, row0, 0xFF));
+    column3 = _mm_add_ps(column3, _mm_mul_ps(column1, _mm_shuffle_ps(row1, row1, 0xFF)));
+    column3 = _mm_add_ps(column3, _mm_mul_ps(column2, _mm_shuffle_ps(row2, row2, 0xFF)));
+    column3 = _mm_sub_ps(_mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f), column3);
+
+    _MM_TRANSPOSE4_PS(column0, column1, column2, column3);
+    _mm_store_ps(&result.elements[0], column0);
+    _mm_store_ps(&result.elements[4], column1);
+    _mm_store_ps(&result.elements[8], column2);
+    _mm_store_ps(&result.elements[12], column3);
+#else
+    const Vector3 a0((*this)(0, 0), (*this)(0, 1), (*this)(0, 2));
+    const Vector3 a1((*this)(1, 0), (*this)(1, 1), (*this)(1, 2));
+    const Vector3 a2((*this)(2, 0), (*this)(2, 1), (*this)(2, 2));
+    const Vector3 t((*this)(0, 3), (*this)(1, 3), (*this)(2, 3));
+
+    Vector3 columns[3] = { a1.cross(a2), a2.cross(a0), a0.cross(a1) };
+    const float inverseDeterminant = 1.0f / a0.dot(columns[0]);
+    for (Vector3& column : columns) {
+        column = column * inverseDeterminant;
+    }
+    const Vector3 translation = -(columns[0] * t.x + columns[1] * t.y + columns[2] * t.z);
+
+    for (int col = 0; col < 3; ++col) {
+        result(0, col) = columns[col].x;
+        result(1, col) = columns[col].y;
+        result(2, col) = columns[col].z;
+    }
+    result(0, 3) = translation.x;
+    result(1, 3) = translation.y;
+    result(2, 3) = translation.z;
+    result(3, 3) = 1.0f;
+#endif
+    return result;
+}
+
+inline Matrix4x4 Matrix4x4::inverseRigid() const {
+    Matrix4x4 result;
+#if VIREALIS_SIMD_SSE2
+    const __m128 xyzMask = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+    const __m128 row0 = _mm_load_ps(&elements[0]);
+    const __m128 row1 = _mm_load_ps(&elements[4]);
+    const __m128 row2 = _mm_load_ps(&elements[8]);
+    __m128 column0 = _mm_and_ps(row0, xyzMask);
+    __m128 column1 = _mm_and_ps(row1, xyzMask);
+    __m128 column2 = _mm_and_ps(row2, xyzMask);
+
+    __m128 column3 = _mm_mul_ps(column0, _mm_shuffle_ps(row0, row0, 0xFF));
+    column3 = _mm_add_ps(column3, _mm_mul_ps(column1, _mm_shuffle_ps(row1, row1, 0xFF)));
+    column3 = _mm_add_ps(column3, _mm_mul_ps(column2, _mm_shuffle_ps(row2, row2, 0xFF)));
+    column3 = _mm_sub_ps(_mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f), column3);
+
+    _MM_TRANSPOSE4_PS(column0, column1, column2, column3);
+    _mm_store_ps(&result.elements[0], column0);
+    _mm_store_ps(&result.elements[4], column1);
+    _mm_store_ps(&result.elements[8], column2);
+    _mm_store_ps(&result.elements[12], column3);
+#else
+    for (int row = 0; row < 3; ++row) {
+        for (int col = 0; col < 3; ++col) {
+            result(row, col) = (*this)(col, row);
+        }
+        result(row, 3) = -((*this)(0, row) * (*this)(0, 3) + (*this)(1, row) * (*this)(1, 3) +
+                           (*this)(2, row) * (*this)(2, 3));
+    }
+    result(3, 3) = 1.0f;
+#endif
+    return result;
+}
+
+constexpr Matrix4x4 operator*(float scalar, const Matrix4x4& matrix) {
     return matrix * scalar;
 }
 
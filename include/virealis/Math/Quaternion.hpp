@@ -0,0 +1,131 @@
+#ifndef VIREALIS_QUATERNION_H
+#define VIREALIS_QUATERNION_H
+
+#include <virealis/Math/Vector3.hpp>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+
+namespace virealis {
+
+class Matrix3x4;
+class Matrix4x4;
+
+// Rotation quaternion (x, y, z vector part, w scalar part). Rotations compose right to
+// left like matrices: (a * b).rotate(v) == a.rotate(b.rotate(v)).
+class Quaternion {
+public:
+    float x, y, z, w;
+
+    // Constructors
+    Quaternion() : x(0), y(0), z(0), w(1) {}
+    Quaternion(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {}
+
+    // Static methods for creating specific rotations
+    static Quaternion identity();
+    static Quaternion fromAxisAngle(const Vector3& axis, float angle);
+    // Rotation part of a matrix whose upper-left 3x3 is a pure rotation
+    static Quaternion fromRotationMatrix(const Matrix4x4& matrix);
+    // Rotation matrix of a unit quaternion, with no translation
+    Matrix4x4 toRotationMatrix() const;
+
+    // Interpolation along the shorter arc between two unit quaternions (t = 0 gives a,
+    // 1 gives b). nlerp blends and renormalizes, which is cheaper but not at constant
+    // angular speed; slerp is.
+    static Quaternion nlerp(const Quaternion& a, const Quaternion& b, float t);
+    static Quaternion slerp(const Quaternion& a, const Quaternion& b, float t);
+
+    // Batch forms, as used by interpolated rendering (see TransformComponentManager), on
+    // the fastest SIMD path the CPU supports (see Simd.hpp). The kernels transpose a few
+    // quaternions at a time into one register per component, so every lane does the same
+    // work. slerpArrays evaluates slerp with a polynomial instead of acos and sin, accurate
+    // to about 1e-6 for unit quaternions; pairs a half turn apart may go either way round.
+    // out may be the same array as an input.
+    static void toRotationMatrices(const Quaternion* in, Matrix3x4* out, size_t n);
+    static void slerpArrays(const Quaternion* a, const Quaternion* b, float t, Quaternion* out, size_t n);
+
+    // Quaternion operations
+    Quaternion operator*(const Quaternion& q) const;
+    Quaternion operator-() const;
+    bool operator==(const Quaternion& q) const;
+    bool operator!=(const Quaternion& q) const;
+    Quaternion conjugate() const;
+    Quaternion normalized() const;
+    float dot(const Quaternion& q) const;
+    float magnitude() const;
+
+    Vector3 rotate(const Vector3& v) const;
+
+    // Friends
+    friend std::ostream& operator<<(std::ostream& os, const Quaternion& q);
+};
+
+// Inline Definitions
+
+inline Quaternion Quaternion::identity() {
+    return Quaternion(0.0f, 0.0f, 0.0f, 1.0f);
+}
+
+inline Quaternion Quaternion::fromAxisAngle(const Vector3& axis, float angle) {
+    Vector3 n = axis.normalized();
+    float s = std::sin(angle * 0.5f);
+    return Quaternion(n.x * s, n.y * s, n.z * s, std::cos(angle * 0.5f));
+}
+
+inline Quaternion Quaternion::operator*(const Quaternion& q) const {
+    return Quaternion(w * q.x + x * q.w + y * q.z - z * q.y,
+                      w * q.y - x * q.z + y * q.w + z * q.x,
+                      w * q.z + x * q.y - y * q.x + z * q.w,
+                      w * q.w - x * q.x - y * q.y - z * q.z);
+}
+
+inline Quaternion Quaternion::operator-() const {
+    return Quaternion(-x, -y, -z, -w);
+}
+
+inline bool Quaternion::operator==(const Quaternion& q) const {
+    return x == q.x && y == q.y && z == q.z && w == q.w;
+}
+
+inline bool Quaternion::operator!=(const Quaternion& q) const {
+    return !(*this == q);
+}
+
+inline Quaternion Quaternion::conjugate() const {
+    return Quaternion(-x, -y, -z, w);
+}
+
+inline float Quaternion::dot(const Quaternion& q) const {
+    return x * q.x + y * q.y + z * q.z + w * q.w;
+}
+
+inline float Quaternion::magnitude() const {
+    return std::sqrt(dot(*this));
+}
+
+inline Quaternion Quaternion::normalized() const {
+    float n = magnitude();
+    return Quaternion(x / n, y / n, z / n, w / n);
+}
+
+inline Quaternion Quaternion::nlerp(const Quaternion& a, const Quaternion& b, float t) {
+    // q and -q are the same rotation; blend towards whichever is nearer
+    const float tb = a.dot(b) < 0.0f ? -t : t;
+    const float ta = 1.0f - t;
+    return Quaternion(a.x * ta + b.x * tb, a.y * ta + b.y * tb, a.z * ta + b.z * tb, a.w * ta + b.w * tb).normalized();
+}
+
+inline Vector3 Quaternion::rotate(const Vector3& v) const {
+    // v' = v + w * t + u x t, with u the vector part and t = 2 * (u x v)
+    Vector3 u(x, y, z);
+    Vector3 t = u.cross(v) * 2.0f;
+    return v + t * w + u.cross(t);
+}
+
+inline std::ostream& operator<<(std::ostream& os, const Quaternion& q) {
+    return os << q.x << ", " << q.y << ", " << q.z << ", " << q.w;
+}
+
+} // namespace virealis
+
+#endif // VIREALIS_QUATERNION_H
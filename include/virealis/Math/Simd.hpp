@@ -0,0 +1,113 @@
+#ifndef VIREALIS_SIMD_H
+#define VIREALIS_SIMD_H
+
+/*
+SIMD selection for the math types.
+
+Batch kernels (e.g. Matrix4x4::multiplyArrays) pick their path at run time: every path
+is compiled in on x86 and the best one the CPU supports is used, so one binary runs
+everywhere. Inline operations on single values (Matrix4x4::operator*, Vector4, Vector3A)
+cannot afford a dispatch, so they use what the build targets: SSE2, which every x86-64
+CPU has, unless the VIREALIS_SIMD CMake option raises it to SSE4.1 or AVX2. Other
+architectures, and builds with VIREALIS_FORCE_SCALAR, use scalar code throughout.
+*/
+
+#if !defined(VIREALIS_FORCE_SCALAR) && \
+    (defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86))
+#define VIREALIS_SIMD_X86 1
+#else
+#define VIREALIS_SIMD_X86 0
+#endif
+
+// Instruction sets the build targets, for the inline operations
+#if VIREALIS_SIMD_X86 && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define VIREALIS_SIMD_SSE2 1
+#include <immintrin.h>
+#else
+#define VIREALIS_SIMD_SSE2 0
+#endif
+
+#if VIREALIS_SIMD_SSE2 && (defined(__SSE4_1__) || defined(__AVX__))
+#define VIREALIS_SIMD_SSE41 1
+#else
+#define VIREALIS_SIMD_SSE41 0
+#endif
+
+#if VIREALIS_SIMD_SSE2 && defined(__AVX2__) && defined(__FMA__)
+#define VIREALIS_SIMD_AVX2 1
+#else
+#define VIREALIS_SIMD_AVX2 0
+#endif
+
+// Enables instruction sets for a single function, so the rest of the build keeps its
+// baseline target. MSVC accepts the intrinsics without it.
+#if VIREALIS_SIMD_X86 && (defined(__GNUC__) || defined(__clang__))
+#define VIREALIS_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define VIREALIS_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#else
+#define VIREALIS_TARGET_SSE41
+#define VIREALIS_TARGET_AVX2
+#endif
+
+namespace virealis {
+
+// Ordered from least to most capable
+enum class SimdPath { Scalar, SSE, AVX2 };
+
+// Best path this CPU supports (AVX2 also requires FMA)
+SimdPath getSupportedSimdPath();
+
+// Path the kernels currently use; the supported one unless overridden
+SimdPath getSimdPath();
+
+// Overrides the path, e.g. to compare them in a benchmark. Paths the CPU lacks fall back
+// to the best supported one; returns the path in effect.
+SimdPath setSimdPath(SimdPath path);
+
+const char* getSimdPathName(SimdPath path);
+
+// What the inline operations were built for
+inline constexpr const char* SimdBuildTarget = VIREALIS_SIMD_AVX2    ? "AVX2"
+                                               : VIREALIS_SIMD_SSE41 ? "SSE4.1"
+                                               : VIREALIS_SIMD_SSE2  ? "SSE2"
+                                                                     : "scalar";
+
+#if VIREALIS_SIMD_SSE2
+namespace simd {
+
+// Dot products of the first four or three lanes, broadcast to every lane
+inline __m128 dot4(__m128 a, __m128 b) {
+#if VIREALIS_SIMD_SSE41
+    return _mm_dp_ps(a, b, 0xFF);
+#else
+    __m128 products = _mm_mul_ps(a, b);
+    __m128 sums = _mm_add_ps(products, _mm_shuffle_ps(products, products, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_add_ps(sums, _mm_shuffle_ps(sums, sums, _MM_SHUFFLE(1, 0, 3, 2)));
+#endif
+}
+
+inline __m128 dot3(__m128 a, __m128 b) {
+#if VIREALIS_SIMD_SSE41
+    return _mm_dp_ps(a, b, 0x7F);
+#else
+    const __m128 xyzMask = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+    return dot4(_mm_and_ps(a, xyzMask), b);
+#endif
+}
+
+// Cross product of the first three lanes; the fourth comes out zero for finite inputs
+inline __m128 cross3(__m128 a, __m128 b) {
+    // a * (b.y, b.z, b.x) - (a.y, a.z, a.x) * b gives the result rotated by one lane, so
+    // one rotation of each input and one of the result replace four
+    const __m128 aYzx = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+    const __m128 bYzx = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+    const __m128 c = _mm_sub_ps(_mm_mul_ps(a, bYzx), _mm_mul_ps(aYzx, b));
+    return _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 0, 2, 1));
+}
+
+} // namespace simd
+#endif // VIREALIS_SIMD_SSE2
+
+} // namespace virealis
+
+#endif // VIREALIS_SIMD_H
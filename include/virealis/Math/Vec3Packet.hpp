@@ -0,0 +1,245 @@
+#ifndef VIREALIS_VEC3_PACKET_H
+#define VIREALIS_VEC3_PACKET_H
+
+#include <virealis/Math/FloatPacket.hpp>
+#include <virealis/Math/Vector3.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace virealis {
+
+/*
+Several Vector3s in structure-of-arrays form: x, y and z each fill one packet, so every
+operation handles Width vectors at once and dot, cross and length need no horizontal
+adds. Use Vec3x4 or Vec3x8, e.g. to normalize an array:
+
+    for (; i + Vec3x8::Width <= n; i += Vec3x8::Width) {
+        Vec3x8::load(&v[i]).normalized().store(&v[i]);
+    }
+    Vec3x8::loadPartial(&v[i], n - i).normalized().storePartial(&v[i], n - i);
+
+Loads and stores convert from and to Vector3 arrays (packed x, y, z triples, as in
+std::vector<Vector3>) or separate x, y and z arrays. The partial forms handle fewer than
+Width vectors, filling the missing lanes with zero on loading.
+*/
+
+template <typename Lanes>
+class Vec3Packet {
+public:
+    static constexpr size_t Width = Lanes::Width;
+    using Mask = decltype(Lanes() < Lanes());
+
+    Lanes x, y, z;
+
+    // Constructors
+    Vec3Packet() = default;
+    Vec3Packet(const Lanes& x, const Lanes& y, const Lanes& z) : x(x), y(y), z(z) {}
+    explicit Vec3Packet(const Vector3& v) : x(v.x), y(v.y), z(v.z) {} // Same vector in every lane
+
+    // Loads and stores
+    static Vec3Packet load(const Vector3* source);
+    static Vec3Packet loadPartial(const Vector3* source, size_t count);
+    static Vec3Packet load(const float* xs, const float* ys, const float* zs);
+    static Vec3Packet loadPartial(const float* xs, const float* ys, const float* zs, size_t count);
+    static Vec3Packet gather(const std::vector<Vector3>& source, const uint32_t* indices);
+    void store(Vector3* destination) const;
+    void storePartial(Vector3* destination, size_t count) const;
+    void store(float* xs, float* ys, float* zs) const;
+    void storePartial(float* xs, float* ys, float* zs, size_t count) const;
+
+    Vector3 operator[](size_t lane) const;
+
+    // Basic operations
+    Vec3Packet operator+(const Vec3Packet& v) const;
+    Vec3Packet operator-(const Vec3Packet& v) const;
+    Vec3Packet operator*(const Vec3Packet& v) const;
+    Vec3Packet operator*(const Lanes& r) const;
+    Vec3Packet operator/(const Lanes& r) const;
+    Vec3Packet operator-() const;
+    Vec3Packet& operator+=(const Vec3Packet& v);
+    Vec3Packet& operator-=(const Vec3Packet& v);
+    Vec3Packet& operator*=(const Lanes& r);
+
+    // Vector operations, one result per lane
+    Lanes dot(const Vec3Packet& v) const;
+    Vec3Packet cross(const Vec3Packet& v) const;
+    Lanes magnitude() const;
+    Lanes magnitudeSquared() const;
+    // Uses Lanes::rsqrt, so about 22 bits accurate on SIMD builds; zero vectors give NaN
+    Vec3Packet normalized() const;
+
+    // Static methods
+    static Vec3Packet Min(const Vec3Packet& a, const Vec3Packet& b);
+    static Vec3Packet Max(const Vec3Packet& a, const Vec3Packet& b);
+
+    // a where mask is set, else b
+    static Vec3Packet select(const Mask& mask, const Vec3Packet& a, const Vec3Packet& b);
+};
+
+using Vec3x4 = Vec3Packet<Floatx4>;
+using Vec3x8 = Vec3Packet<Floatx8>;
+
+// Inline Definitions
+
+// The loads read Vector3 arrays as packed floats
+static_assert(sizeof(Vector3) == 3 * sizeof(float) && std::is_standard_layout_v<Vector3>,
+              "Vector3 must be three packed floats");
+
+template <typename Lanes>
+inline Vec3Packet<Lanes> Vec3Packet<Lanes>::load(const Vector3* source) {
+    Vec3Packet result;
+    Lanes::deinterleave3(&source->x, result.x, result.y, result.z);
+    return result;
+}
+
+template <typename Lanes>
+inline Vec3Packet<Lanes> Vec3Packet<Lanes>::loadPartial(const Vector3* source, size_t count) {
+    Vector3 lanes[Width];
+    std::copy(source, source + std::min(count, Width), lanes);
+    return load(lanes);
+}
+
+template <typename Lanes>
+inline Vec3Packet<Lanes> Vec3Packet<Lanes>::load(const float* xs, const float* ys, const float* zs) {
+    return Vec3Packet(Lanes::load(xs), Lanes::load(ys), Lanes::load(zs));
+}
+
+template <typename Lanes>
+inline Vec3Packet<Lanes> Vec3Packet<Lanes>::loadPartial(const float* xs, const float* ys, const float* zs,
+                                                        size_t count) {
+    return Vec3Packet(Lanes::loadPartial(xs, count), Lanes::loadPartial(ys, count), Lanes::loadPartial(zs, count));
+}
+
+template <typename Lanes>
+inline Vec3Packet<Lanes> Vec3Packet<Lanes>::gather(const std::vector<Vector3>& source, const uint32_t* indices) {
+    Vector3 lanes[Width];
+    for (size_t i = 0; i < Width; ++i) {
+        lanes[i] = source[indices[i]];
+    }
+    return load(lanes);
+}
+
+template <typename Lanes>
+inline void Vec3Packet<Lanes>::store(Vector3* destination) const {
+    Lanes::interleave3(x, y, z, &destination->x);
+}
+
+template <typename Lanes>
+inline void Vec3Packet<Lanes>::storePartial(Vector3* destination, size_t count) const {
+    Vector3 lanes[Width];
+    store(lanes);
+    std::copy(lanes, lanes + std::min(count, Width), destination);
+}
+
+template <typename Lanes>
+inline void Vec3Packet<Lanes>::store(float* xs, float* ys, float* zs) const {
+    x.store(xs);
+    y.store(ys);
+    z.store(zs);
+}
+
+template <typename Lanes>
+inline void Vec3Packet<Lanes>::storePartial(float* xs, float* ys, float* zs, size_t count) const {
+    x.storePartial(xs, count);
+    y.storePartial(ys, count);
+    z.storePartial(zs, count);
+}
+
+template <typename Lanes>
+inline Vector3 Vec3Packet<Lanes>::operator[](size_t lane) const {
+    return Vector3(x[lane], y[lane], z[lane]);
+}
+
+template <typename Lanes>
+inline Vec3Packet<Lanes> Vec3Packet<Lanes>::operator+(const Vec3Packet& v) const {
+    return Vec3Packet(x + v.x, y + v.y, z + v.z);
+}
+
+template <typename Lanes>
+inline Vec3Packet<Lanes> Vec3Packet<Lanes>::operator-(const Vec3Packet& v) const {
+    return Vec3Packet(x - v.x, y - v.y, z - v.z);
+}
+
+template <typename Lanes>
+inline Vec3Packet<Lanes> Vec3Packet<Lanes>::operator*(const Vec3Packet& v) const {
+    return Vec3Packet(x * v.x, y * v.y, z * v.z);
+}
+
+template <typename Lanes>
+inline Vec3Packet<Lanes> Vec3Packet<Lanes>::operator*(const Lanes& r) const {
+    return Vec3Packet(x * r, y * r, z * r);
+}
+
+template <typename Lanes>
+inline Vec3Packet<Lanes> Vec3Packet<Lanes>::operator/(const Lanes& r) const {
+    return Vec3Packet(x / r, y / r, z / r);
+}
+
+template <typename Lanes>
+inline Vec3Packet<Lanes> Vec3Packet<Lanes>::operator-() const {
+    return Vec3Packet(-x, -y, -z);
+}
+
+template <typename Lanes>
+inline Vec3Packet<Lanes>& Vec3Packet<Lanes>::operator+=(const Vec3Packet& v) {
+    return *this = *this + v;
+}
+
+template <typename Lanes>
+inline Vec3Packet<Lanes>& Vec3Packet<Lanes>::operator-=(const Vec3Packet& v) {
+    return *this = *this - v;
+}
+
+template <typename Lanes>
+inline Vec3Packet<Lanes>& Vec3Packet<Lanes>::operator*=(const Lanes& r) {
+    return *this = *this * r;
+}
+
+template <typename Lanes>
+inline Lanes Vec3Packet<Lanes>::dot(const Vec3Packet& v) const {
+    return x * v.x + y * v.y + z * v.z;
+}
+
+template <typename Lanes>
+inline Vec3Packet<Lanes> Vec3Packet<Lanes>::cross(const Vec3Packet& v) const {
+    return Vec3Packet(y * v.z - z * v.y,
+                      z * v.x - x * v.z,
+                      x * v.y - y * v.x);
+}
+
+template <typename Lanes>
+inline Lanes Vec3Packet<Lanes>::magnitude() const {
+    return magnitudeSquared().sqrt();
+}
+
+template <typename Lanes>
+inline Lanes Vec3Packet<Lanes>::magnitudeSquared() const {
+    return x * x + y * y + z * z;
+}
+
+template <typename Lanes>
+inline Vec3Packet<Lanes> Vec3Packet<Lanes>::normalized() const {
+    return *this * magnitudeSquared().rsqrt();
+}
+
+template <typename Lanes>
+inline Vec3Packet<Lanes> Vec3Packet<Lanes>::Min(const Vec3Packet& a, const Vec3Packet& b) {
+    return Vec3Packet(Lanes::Min(a.x, b.x), Lanes::Min(a.y, b.y), Lanes::Min(a.z, b.z));
+}
+
+template <typename Lanes>
+inline Vec3Packet<Lanes> Vec3Packet<Lanes>::Max(const Vec3Packet& a, const Vec3Packet& b) {
+    return Vec3Packet(Lanes::Max(a.x, b.x), Lanes::Max(a.y, b.y), Lanes::Max(a.z, b.z));
+}
+
+template <typename Lanes>
+inline Vec3Packet<Lanes> Vec3Packet<Lanes>::select(const Mask& mask, const Vec3Packet& a, const Vec3Packet& b) {
+    using virealis::select;
+    return Vec3Packet(select(mask, a.x, b.x), select(mask, a.y, b.y), select(mask, a.z, b.z));
+}
+
+} // namespace virealis
+
+#endif // VIREALIS_VEC3_PACKET_H
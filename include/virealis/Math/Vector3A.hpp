@@ -0,0 +1,218 @@
+#ifndef VIREALIS_VECTOR3A_H
+#define VIREALIS_VECTOR3A_H
+
+#include <virealis/Math/Vector3.hpp>
+#include <virealis/Math/Simd.hpp>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+
+namespace virealis {
+
+/*
+Vector3 padded to 16 bytes and aligned, for hot loops: it loads into one SSE register
+with no shuffling. The padding lane is kept at zero by every operation, so it never
+leaks into dot products or lengths.
+
+Vector3 stays packed, since vertex buffers and the GPU expect three floats per element;
+convert at the boundaries.
+*/
+class alignas(16) Vector3A {
+public:
+    float x, y, z;
+    float pad = 0.0f; // Always zero
+
+    // Constructors
+    constexpr Vector3A() : x(0), y(0), z(0) {}
+    constexpr Vector3A(float x, float y, float z) : x(x), y(y), z(z) {}
+    constexpr explicit Vector3A(const Vector3& v) : x(v.x), y(v.y), z(v.z) {}
+
+    constexpr Vector3 toVector3() const;
+
+    // Basic operations
+    Vector3A operator*(float r) const;
+    Vector3A operator/(float r) const;
+    Vector3A operator+(const Vector3A& v) const;
+    Vector3A operator-(const Vector3A& v) const;
+    Vector3A& operator+=(const Vector3A& v);
+    Vector3A& operator-=(const Vector3A& v);
+    Vector3A operator-() const;
+    Vector3A operator*(const Vector3A& v) const;
+    float operator[](int index) const;
+
+    bool operator==(const Vector3A& v) const;
+    bool operator!=(const Vector3A& v) const;
+
+    // Vector operations
+    float magnitude() const;
+    float magnitudeSquared() const;
+    Vector3A normalized() const;
+    Vector3A cross(const Vector3A& v) const;
+    float dot(const Vector3A& v) const;
+
+    // Normalizes n vectors on the fastest SIMD path the CPU supports (see Simd.hpp);
+    // out may be the same array as in
+    static void normalizeArray(const Vector3A* in, Vector3A* out, size_t n);
+
+    // Static methods
+    static Vector3A Min(const Vector3A& p1, const Vector3A& p2);
+    static Vector3A Max(const Vector3A& p1, const Vector3A& p2);
+
+    // Friends
+    friend class Matrix4x4;
+    friend Vector3A operator*(float r, const Vector3A& v);
+    friend std::ostream& operator<<(std::ostream& os, const Vector3A& v);
+
+private:
+#if VIREALIS_SIMD_SSE2
+    explicit Vector3A(__m128 v) { _mm_store_ps(&x, v); }
+    __m128 load() const { return _mm_load_ps(&x); }
+#endif
+};
+
+// Inline Definitions
+
+constexpr Vector3 Vector3A::toVector3() const {
+    return Vector3(x, y, z);
+}
+
+#if VIREALIS_SIMD_SSE2
+
+inline Vector3A Vector3A::operator*(float r) const {
+    return Vector3A(_mm_mul_ps(load(), _mm_set1_ps(r)));
+}
+
+inline Vector3A Vector3A::operator/(float r) const {
+    return Vector3A(_mm_div_ps(load(), _mm_set1_ps(r)));
+}
+
+inline Vector3A Vector3A::operator+(const Vector3A& v) const {
+    return Vector3A(_mm_add_ps(load(), v.load()));
+}
+
+inline Vector3A Vector3A::operator-(const Vector3A& v) const {
+    return Vector3A(_mm_sub_ps(load(), v.load()));
+}
+
+inline Vector3A Vector3A::operator-() const {
+    return Vector3A(_mm_sub_ps(_mm_setzero_ps(), load()));
+}
+
+inline Vector3A Vector3A::operator*(const Vector3A& v) const {
+    return Vector3A(_mm_mul_ps(load(), v.load()));
+}
+
+inline float Vector3A::dot(const Vector3A& v) const {
+    return _mm_cvtss_f32(simd::dot4(load(), v.load()));
+}
+
+inline Vector3A Vector3A::normalized() const {
+    const __m128 v = load();
+    const __m128 length = _mm_sqrt_ps(simd::dot4(v, v));
+    // The padding lane would be 0 / length; masking keeps it at zero for a zero vector too
+    const __m128 xyzMask = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+    return Vector3A(_mm_and_ps(_mm_div_ps(v, length), xyzMask));
+}
+
+inline Vector3A Vector3A::cross(const Vector3A& v) const {
+    return Vector3A(simd::cross3(load(), v.load()));
+}
+
+inline Vector3A Vector3A::Min(const Vector3A& p1, const Vector3A& p2) {
+    return Vector3A(_mm_min_ps(p1.load(), p2.load()));
+}
+
+inline Vector3A Vector3A::Max(const Vector3A& p1, const Vector3A& p2) {
+    return Vector3A(_mm_max_ps(p1.load(), p2.load()));
+}
+
+#else
+
+inline Vector3A Vector3A::operator*(float r) const {
+    return Vector3A(x * r, y * r, z * r);
+}
+
+inline Vector3A Vector3A::operator/(float r) const {
+    return Vector3A(x / r, y / r, z / r);
+}
+
+inline Vector3A Vector3A::operator+(const Vector3A& v) const {
+    return Vector3A(x + v.x, y + v.y, z + v.z);
+}
+
+inline Vector3A Vector3A::operator-(const Vector3A& v) const {
+    return Vector3A(x - v.x, y - v.y, z - v.z);
+}
+
+inline Vector3A Vector3A::operator-() const {
+    return Vector3A(-x, -y, -z);
+}
+
+inline Vector3A Vector3A::operator*(const Vector3A& v) const {
+    return Vector3A(x * v.x, y * v.y, z * v.z);
+}
+
+inline float Vector3A::dot(const Vector3A& v) const {
+    return x * v.x + y * v.y + z * v.z;
+}
+
+inline Vector3A Vector3A::normalized() const {
+    float n = std::sqrt(dot(*this));
+    return Vector3A(x / n, y / n, z / n);
+}
+
+inline Vector3A Vector3A::cross(const Vector3A& v) const {
+    return Vector3A(y * v.z - z * v.y,
+                    z * v.x - x * v.z,
+                    x * v.y - y * v.x);
+}
+
+inline Vector3A Vector3A::Min(const Vector3A& p1, const Vector3A& p2) {
+    return Vector3A(std::min(p1.x, p2.x), std::min(p1.y, p2.y), std::min(p1.z, p2.z));
+}
+
+inline Vector3A Vector3A::Max(const Vector3A& p1, const Vector3A& p2) {
+    return Vector3A(std::max(p1.x, p2.x), std::max(p1.y, p2.y), std::max(p1.z, p2.z));
+}
+
+#endif // VIREALIS_SIMD_SSE2
+
+inline Vector3A& Vector3A::operator+=(const Vector3A& v) {
+    return *this = *this + v;
+}
+
+inline Vector3A& Vector3A::operator-=(const Vector3A& v) {
+    return *this = *this - v;
+}
+
+inline float Vector3A::operator[](int index) const {
+    return (&x)[index];
+}
+
+inline bool Vector3A::operator==(const Vector3A& v) const {
+    return x == v.x && y == v.y && z == v.z;
+}
+
+inline bool Vector3A::operator!=(const Vector3A& v) const {
+    return !(*this == v);
+}
+
+inline float Vector3A::magnitude() const {
+    return std::sqrt(dot(*this));
+}
+
+inline float Vector3A::magnitudeSquared() const {
+    return dot(*this);
+}
+
+inline Vector3A operator*(float r, const Vector3A& v) {
+    return v * r;
+}
+
+inline std::ostream& operator<<(std::ostream& os, const Vector3A& v) {
+    return os << v.x << ", " << v.y << ", " << v.z;
+}
+
+} // namespace virealis
+
+#endif // VIREALIS_VECTOR3A_H
@@ -0,0 +1,194 @@
+#ifndef VIREALIS_VECTOR4_H
+#define VIREALIS_VECTOR4_H
+
+#include <virealis/Math/Vector3.hpp>
+#include <virealis/Math/Simd.hpp>
+#include <cmath>
+#include <iostream>
+
+namespace virealis {
+
+/*
+Four floats on a 16-byte boundary, so every operation is a single SSE instruction or a
+few (see Simd.hpp for how the instruction set is chosen). Homogeneous points and
+vectors, e.g. the result of Matrix4x4 * Vector4.
+*/
+class alignas(16) Vector4 {
+public:
+    float x, y, z, w;
+
+    // Constructors
+    constexpr Vector4() : x(0), y(0), z(0), w(0) {}
+    constexpr Vector4(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {}
+    constexpr Vector4(const Vector3& v, float w) : x(v.x), y(v.y), z(v.z), w(w) {}
+
+    constexpr Vector3 toVector3() const;
+
+    // Basic operations
+    Vector4 operator*(float r) const;
+    Vector4 operator/(float r) const;
+    Vector4 operator+(const Vector4& v) const;
+    Vector4 operator-(const Vector4& v) const;
+    Vector4& operator+=(const Vector4& v);
+    Vector4& operator-=(const Vector4& v);
+    Vector4 operator-() const;
+    Vector4 operator*(const Vector4& v) const;
+    float operator[](int index) const;
+
+    bool operator==(const Vector4& v) const;
+    bool operator!=(const Vector4& v) const;
+
+    // Vector operations
+    float magnitude() const;
+    float magnitudeSquared() const;
+    Vector4 normalized() const;
+    float dot(const Vector4& v) const;
+
+    // Static methods
+    static Vector4 Min(const Vector4& p1, const Vector4& p2);
+    static Vector4 Max(const Vector4& p1, const Vector4& p2);
+
+    // Friends
+    friend Vector4 operator*(float r, const Vector4& v);
+    friend std::ostream& operator<<(std::ostream& os, const Vector4& v);
+
+private:
+#if VIREALIS_SIMD_SSE2
+    explicit Vector4(__m128 v) { _mm_store_ps(&x, v); }
+    __m128 load() const { return _mm_load_ps(&x); }
+#endif
+};
+
+// Inline Definitions
+
+constexpr Vector3 Vector4::toVector3() const {
+    return Vector3(x, y, z);
+}
+
+#if VIREALIS_SIMD_SSE2
+
+inline Vector4 Vector4::operator*(float r) const {
+    return Vector4(_mm_mul_ps(load(), _mm_set1_ps(r)));
+}
+
+inline Vector4 Vector4::operator/(float r) const {
+    return Vector4(_mm_div_ps(load(), _mm_set1_ps(r)));
+}
+
+inline Vector4 Vector4::operator+(const Vector4& v) const {
+    return Vector4(_mm_add_ps(load(), v.load()));
+}
+
+inline Vector4 Vector4::operator-(const Vector4& v) const {
+    return Vector4(_mm_sub_ps(load(), v.load()));
+}
+
+inline Vector4 Vector4::operator-() const {
+    return Vector4(_mm_sub_ps(_mm_setzero_ps(), load()));
+}
+
+inline Vector4 Vector4::operator*(const Vector4& v) const {
+    return Vector4(_mm_mul_ps(load(), v.load()));
+}
+
+inline float Vector4::dot(const Vector4& v) const {
+    return _mm_cvtss_f32(simd::dot4(load(), v.load()));
+}
+
+inline Vector4 Vector4::normalized() const {
+    const __m128 v = load();
+    return Vector4(_mm_div_ps(v, _mm_sqrt_ps(simd::dot4(v, v))));
+}
+
+inline Vector4 Vector4::Min(const Vector4& p1, const Vector4& p2) {
+    return Vector4(_mm_min_ps(p1.load(), p2.load()));
+}
+
+inline Vector4 Vector4::Max(const Vector4& p1, const Vector4& p2) {
+    return Vector4(_mm_max_ps(p1.load(), p2.load()));
+}
+
+#else
+
+inline Vector4 Vector4::operator*(float r) const {
+    return Vector4(x * r, y * r, z * r, w * r);
+}
+
+inline Vector4 Vector4::operator/(float r) const {
+    return Vector4(x / r, y / r, z / r, w / r);
+}
+
+inline Vector4 Vector4::operator+(const Vector4& v) const {
+    return Vector4(x + v.x, y + v.y, z + v.z, w + v.w);
+}
+
+inline Vector4 Vector4::operator-(const Vector4& v) const {
+    return Vector4(x - v.x, y - v.y, z - v.z, w - v.w);
+}
+
+inline Vector4 Vector4::operator-() const {
+    return Vector4(-x, -y, -z, -w);
+}
+
+inline Vector4 Vector4::operator*(const Vector4& v) const {
+    return Vector4(x * v.x, y * v.y, z * v.z, w * v.w);
+}
+
+inline float Vector4::dot(const Vector4& v) const {
+    return x * v.x + y * v.y + z * v.z + w * v.w;
+}
+
+inline Vector4 Vector4::normalized() const {
+    float n = std::sqrt(dot(*this));
+    return Vector4(x / n, y / n, z / n, w / n);
+}
+
+inline Vector4 Vector4::Min(const Vector4& p1, const Vector4& p2) {
+    return Vector4(std::min(p1.x, p2.x), std::min(p1.y, p2.y), std::min(p1.z, p2.z), std::min(p1.w, p2.w));
+}
+
+inline Vector4 Vector4::Max(const Vector4& p1, const Vector4& p2) {
+    return Vector4(std::max(p1.x, p2.x), std::max(p1.y, p2.y), std::max(p1.z, p2.z), std::max(p1.w, p2.w));
+}
+
+#endif // VIREALIS_SIMD_SSE2
+
+inline Vector4& Vector4::operator+=(const Vector4& v) {
+    return *this = *this + v;
+}
+
+inline Vector4& Vector4::operator-=(const Vector4& v) {
+    return *this = *this - v;
+}
+
+inline float Vector4::operator[](int index) const {
+    return (&x)[index];
+}
+
+inline bool Vector4::operator==(const Vector4& v) const {
+    return x == v.x && y == v.y && z == v.z && w == v.w;
+}
+
+inline bool Vector4::operator!=(const Vector4& v) const {
+    return !(*this == v);
+}
+
+inline float Vector4::magnitude() const {
+    return std::sqrt(dot(*this));
+}
+
+inline float Vector4::magnitudeSquared() const {
+    return dot(*this);
+}
+
+inline Vector4 operator*(float r, const Vector4& v) {
+    return v * r;
+}
+
+inline std::ostream& operator<<(std::ostream& os, const Vector4& v) {
+    return os << v.x << ", " << v.y << ", " << v.z << ", " << v.w;
+}
+
+} // namespace virealis
+
+#endif // VIREALIS_VECTOR4_H
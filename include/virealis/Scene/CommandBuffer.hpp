@@ -0,0 +1,171 @@
+#ifndef VIREALIS_COMMAND_BUFFER_H
+#define VIREALIS_COMMAND_BUFFER_H
+
+#include <virealis/Core/Entity.hpp>
+#include <virealis/Core/ThreadPool.hpp>
+#include <virealis/Scene/Scene.hpp>
+#include <limits>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace virealis {
+
+/*
+Records structural changes (entity create/destroy, component add/remove) so they can be
+applied to a Scene later, at a sync point where no system is iterating the managers.
+
+Each worker thread records into its own CommandBuffer (see CommandBufferSet), so
+recording takes no locks. Buffers are played back one after another on a single thread.
+
+createEntity() returns a provisional handle that is only meaningful to the buffer that
+issued it. It can be used in later commands of the same buffer and is swapped for the
+real entity during playback. Commands that target an entity which is no longer alive at
+playback time are skipped.
+
+Component arguments are copied into an arena owned by the buffer, next to the command
+that uses them, so recording allocates only when the arena or the command list grows;
+clear() keeps both for the next frame.
+*/
+class CommandBuffer {
+public:
+    CommandBuffer() = default;
+    ~CommandBuffer();
+
+    CommandBuffer(const CommandBuffer&) = delete;
+    CommandBuffer& operator=(const CommandBuffer&) = delete;
+
+    Entity createEntity();
+    void destroyEntity(Entity entity);
+
+    // Records Manager::create(entity, args...); arguments are copied into the buffer
+    template <typename Manager, typename... Args>
+    void addComponent(Entity entity, Args&&... args);
+
+    // Records Manager::destroy(entity)
+    template <typename Manager>
+    void removeComponent(Entity entity);
+
+    // Applies every recorded command to the scene in recording order, then clears. If a
+    // command throws, the commands before it stay applied (entities created so far stay
+    // alive), the rest are discarded, and the buffer is cleared before the exception
+    // propagates; provisional handles from it are then meaningless.
+    void playback(Scene& scene);
+
+    void clear();
+    bool empty() const;
+    size_t size() const;
+
+private:
+    // Provisional handles use a generation the EntityManager never hands out in practice
+    static constexpr uint32_t PendingGeneration = std::numeric_limits<uint32_t>::max();
+    static constexpr size_t BlockSize = 16 * 1024;
+
+    enum class CommandType { CreateEntity, DestroyEntity, Component };
+
+    // Component commands point at their arguments in the arena, with the functions that
+    // apply and destroy them for the manager and argument types they were recorded with
+    struct Command {
+        CommandType type;
+        Entity entity;
+        void* arguments;
+        void (*apply)(void* arguments, Scene& scene, Entity target);
+        void (*destroy)(void* arguments);
+    };
+
+    // Arena blocks never move, so recorded arguments stay put until clear()
+    struct Block {
+        std::unique_ptr<std::byte[]> memory;
+        size_t size;
+    };
+
+    void* allocate(size_t size, size_t alignment);
+    Entity resolve(Entity entity) const;
+
+    std::vector<Command> commands;
+    std::vector<Block> blocks;
+    size_t currentBlock = 0;
+    size_t blockOffset = 0;
+    std::vector<Entity> createdEntities; // Real handles for provisional indices, filled during playback
+    uint32_t pendingCount = 0;
+};
+
+/*
+One CommandBuffer per ThreadPool worker, plus one for threads off the pool, so systems
+running in parallel (and parallelFor chunks inside them) can record structural changes
+without locks. SystemScheduler owns one and plays it back at its sync points.
+
+Which worker runs a system varies from run to run, so commands from different systems
+may play back in either order; commands recorded by one system on one thread keep
+their order.
+*/
+class CommandBufferSet {
+public:
+    explicit CommandBufferSet(const ThreadPool& threadPool);
+
+    // The calling worker's buffer, or the shared one for threads off the pool; only one
+    // such thread (normally the one calling SystemScheduler::run) may record at a time
+    CommandBuffer& local();
+
+    // Plays back every buffer in worker order, the shared one last. If a command throws,
+    // the buffers not played back yet are cleared too before the exception propagates.
+    void playback(Scene& scene);
+
+    void clear();
+    bool empty() const;
+
+private:
+    // A cache line each, so workers recording at the same time don't share lines
+    struct alignas(64) PaddedBuffer {
+        CommandBuffer buffer;
+    };
+
+    const ThreadPool& threadPool;
+    size_t bufferCount;
+    std::unique_ptr<PaddedBuffer[]> buffers;
+};
+
+// Inline Definitions
+
+template <typename Manager, typename... Args>
+void CommandBuffer::addComponent(Entity entity, Args&&... args) {
+    using Arguments = std::tuple<std::decay_t<Args>...>;
+    void* arguments = allocate(sizeof(Arguments), alignof(Arguments));
+
+    auto apply = [](void* stored, Scene& scene, Entity target) {
+        std::apply([&](auto&... values) { scene.getManager<Manager>().create(target, std::move(values)...); },
+                   *static_cast<Arguments*>(stored));
+    };
+    auto destroy = [](void* stored) {
+        static_cast<Arguments*>(stored)->~Arguments();
+    };
+
+    // Record the command first: if copying the arguments throws, dropping it leaves nothing to destroy
+    commands.push_back({ CommandType::Component, entity, arguments, apply, nullptr });
+    try {
+        ::new (arguments) Arguments(std::forward<Args>(args)...);
+    } catch (...) {
+        commands.pop_back();
+        throw;
+    }
+    if constexpr (!std::is_trivially_destructible_v<Arguments>) {
+        commands.back().destroy = destroy;
+    }
+}
+
+template <typename Manager>
+void CommandBuffer::removeComponent(Entity entity) {
+    auto apply = [](void*, Scene& scene, Entity target) {
+        scene.getManager<Manager>().destroy(target);
+    };
+    commands.push_back({ CommandType::Component, entity, nullptr, apply, nullptr });
+}
+
+} // namespace virealis
+
+#endif // VIREALIS_COMMAND_BUFFER_H
@@ -0,0 +1,154 @@
+#ifndef VIREALIS_GROUP_H
+#define VIREALIS_GROUP_H
+
+#include <virealis/Core/Entity.hpp>
+#include <virealis/Core/SparseSet.hpp>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <cstddef>
+
+namespace virealis {
+
+class GroupBase {
+public:
+    virtual ~GroupBase() = default;
+};
+
+/*
+An owning group over the given component managers.
+
+The group takes control of the order of its managers: entities that have a component in
+all of them are kept at the front of every manager's dense arrays, in the same order.
+Slot i of each manager then belongs to the same entity for i < size(), so iterating the
+group is a straight walk over aligned arrays without any sparse lookups:
+
+    const auto* group = scene.findGroup<MeshComponentManager, TransformComponentManager>();
+    group->each([&](Entity entity, size_t index) {
+        meshManager.getVerticesAt(index); transformManager.getWorldTransformAt(index); ...
+    });
+
+The order is maintained through the managers' construct/destroy listeners, at the cost
+of up to one slot swap per manager when a member joins or leaves. A manager can be owned
+by at most one group. Managers must not be structurally modified while iterating.
+*/
+template <typename... Managers>
+class Group : public GroupBase {
+public:
+    static_assert(sizeof...(Managers) > 1, "A group needs at least two component managers.");
+
+    explicit Group(Managers&... managers);
+    ~Group() override;
+
+    Group(const Group&) = delete;
+    Group& operator=(const Group&) = delete;
+
+    // Number of entities with all components; they occupy slots [0, size()) everywhere
+    size_t size() const;
+    bool empty() const;
+    std::span<const Entity> getEntities() const;
+
+    // func(Entity, size_t index), where index is the entity's slot in every manager
+    template <typename Func>
+    void each(Func&& func) const;
+
+private:
+    static void onConstruct(void* context, Entity entity);
+    static void onDestroy(void* context, Entity entity);
+
+    bool containsAll(Entity entity) const;
+    void moveToSlot(Entity entity, size_t slot);
+
+    std::tuple<Managers*...> managers;
+    size_t packedCount = 0;
+};
+
+// Inline Definitions
+
+template <typename... Managers>
+Group<Managers...>::Group(Managers&... storages) : managers(&storages...) {
+    if (((storages.getOwner() != nullptr) || ...)) {
+        throw std::runtime_error("Component manager is already owned by another group.");
+    }
+    (storages.setOwner(this), ...);
+    (storages.addListener({ this, &Group::onConstruct, &Group::onDestroy }), ...);
+
+    // Pack the entities that already have every component. Walking the first manager
+    // forward is safe: each swap only moves an already-visited entity behind the cursor.
+    const SparseSet& lead = std::get<0>(managers)->getEntitySet();
+    for (size_t i = 0; i < lead.size(); ++i) {
+        Entity entity = lead[i];
+        if (containsAll(entity)) {
+            moveToSlot(entity, packedCount++);
+        }
+    }
+}
+
+template <typename... Managers>
+Group<Managers...>::~Group() {
+    std::apply([this](auto*... storage) {
+        ((storage->removeListener(this), storage->setOwner(nullptr)), ...);
+    }, managers);
+}
+
+template <typename... Managers>
+bool Group<Managers...>::containsAll(Entity entity) const {
+    return std::apply([entity](auto*... storage) {
+        return (storage->isValid(entity) && ...);
+    }, managers);
+}
+
+template <typename... Managers>
+void Group<Managers...>::moveToSlot(Entity entity, size_t slot) {
+    std::apply([entity, slot](auto*... storage) {
+        (storage->swapSlots(storage->getEntitySet().indexOf(entity), slot), ...);
+    }, managers);
+}
+
+template <typename... Managers>
+void Group<Managers...>::onConstruct(void* context, Entity entity) {
+    // The new component completes the set, and a new component always sits outside the
+    // packed range, so the entity cannot already be a member
+    Group& group = *static_cast<Group*>(context);
+    if (group.containsAll(entity)) {
+        group.moveToSlot(entity, group.packedCount++);
+    }
+}
+
+template <typename... Managers>
+void Group<Managers...>::onDestroy(void* context, Entity entity) {
+    // Called while the component is still present; move the member to the end of the
+    // packed range and shrink it, so the manager's swap-and-pop stays outside the range
+    Group& group = *static_cast<Group*>(context);
+    if (group.containsAll(entity)) {
+        group.moveToSlot(entity, --group.packedCount);
+    }
+}
+
+template <typename... Managers>
+size_t Group<Managers...>::size() const {
+    return packedCount;
+}
+
+template <typename... Managers>
+bool Group<Managers...>::empty() const {
+    return packedCount == 0;
+}
+
+template <typename... Managers>
+std::span<const Entity> Group<Managers...>::getEntities() const {
+    return std::span<const Entity>(std::get<0>(managers)->getEntitySet().getEntities()).first(packedCount);
+}
+
+template <typename... Managers>
+template <typename Func>
+void Group<Managers...>::each(Func&& func) const {
+    std::span<const Entity> entities = getEntities();
+    for (size_t index = 0; index < entities.size(); ++index) {
+        func(entities[index], index);
+    }
+}
+
+} // namespace virealis
+
+#endif // VIREALIS_GROUP_H
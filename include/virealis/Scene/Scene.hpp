@@ -2,29 +2,73 @@
 #define VIREALIS_SCENE_H
 
 #include <virealis/Core/Entity.hpp>
+#include <virealis/Core/EntityManager.hpp>
+#include <virealis/Core/SparseSet.hpp>
+#include <virealis/Core/ComponentRegistry.hpp>
 #include <virealis/Components/MeshComponentManager.hpp>
 #include <virealis/Components/MaterialComponentManager.hpp>
 #include <virealis/Components/TransformComponentManager.hpp>
 #include <virealis/Components/CameraComponentManager.hpp>
+#include <virealis/Components/BoundsComponentManager.hpp>
+#include <virealis/Core/TypeId.hpp>
+#include <virealis/Scene/View.hpp>
+#include <virealis/Scene/Group.hpp>
+#include <memory>
+#include <utility>
 #include <vector>
+#include <span>
+#include <type_traits>
 
 namespace virealis {
 
 class Scene {
 private:
-    std::vector<Entity> entities;
-    MeshComponentManager meshManager;
-    MaterialComponentManager materialManager;
-    TransformComponentManager transformManager;
-    CameraComponentManager cameraManager;
+    EntityManager entityManager;   // Hands out handles and recycles indices
+    SparseSet aliveEntities;       // Dense list of live entities with O(1) removal
+    uint32_t currentTick = 1;      // Frame tick used for component change tracking
+    ComponentRegistry registry;    // Component managers by type, built-in ones included
+    // Declared after the registry so groups detach before the managers are destroyed
+    std::vector<std::pair<TypeId, std::unique_ptr<GroupBase>>> groups;
 
 public:
-    Scene() = default;
+    Scene();
     ~Scene() = default;
 
+    // Groups keep pointers to the managers, so a scene stays where it was created
+    Scene(const Scene&) = delete;
+    Scene& operator=(const Scene&) = delete;
+
     // Entity management
     Entity createEntity();
     void destroyEntity(Entity entity);
+    bool isValid(Entity entity) const;
+
+    // Destroys the entity and every entity below it in the transform hierarchy (a ragdoll,
+    // a pile of debris), in time linear in the number destroyed
+    void destroySubtree(Entity root);
+
+    // Creates count entities. The returned span points into the alive list and stays
+    // valid until the next createEntity/createEntities/destroyEntity call.
+    std::span<const Entity> createEntities(size_t count);
+
+    // Change tracking: components created or modified are stamped with the current tick.
+    // Call advanceTick() once per frame; a system that remembers the tick it last ran at
+    // can then visit only what changed since, e.g. view<T>().changedSince<T>(lastTick).
+    uint32_t advanceTick();
+    uint32_t getCurrentTick() const;
+
+    // Reserves room for entityCount entities in the entity store; component managers
+    // are reserved individually since most entities only have a few components
+    void reserve(size_t entityCount);
+
+    // Registers a component manager type (any ComponentStorage subclass, e.g. a
+    // ComponentPool); throws if it is already registered
+    template <typename Manager, typename... Args>
+    Manager& registerComponent(Args&&... args);
+
+    // Whether the entity has a component in all of the given managers, from its component mask
+    template <typename... Managers>
+    bool hasComponents(Entity entity) const;
 
     // Access component managers
     // Non-const versions (used when you want to modify the scene)
@@ -32,18 +76,101 @@ public:
     MaterialComponentManager& getMaterialManager();
     TransformComponentManager& getTransformManager();
     CameraComponentManager& getCameraManager();
+    BoundsComponentManager& getBoundsManager();
 
     // Const versions (used when you want to read from the scene)
     const MeshComponentManager& getMeshManager() const;
     const MaterialComponentManager& getMaterialManager() const;
     const TransformComponentManager& getTransformManager() const;
     const CameraComponentManager& getCameraManager() const;
+    const BoundsComponentManager& getBoundsManager() const;
 
+    // Live entities in no particular order; destroyEntity() moves the last one into the freed slot
     const std::vector<Entity>& getEntities() const;
 
+    // Access a component manager by type, e.g. getManager<MeshComponentManager>(). The
+    // non-const version registers the type on first use; the const one throws instead.
+    template <typename Manager>
+    Manager& getManager();
+    template <typename Manager>
+    const Manager& getManager() const;
+
+    // Iterate the entities that have all of the given components (see View)
+    template <typename... Managers>
+    View<Managers...> view();
+    template <typename... Managers>
+    View<const Managers...> view() const;
+
+    // Owning group over the given managers, created on first use (see Group). Create
+    // groups at startup: the first call sorts the managers' existing components.
+    template <typename... Managers>
+    Group<Managers...>& group();
+    // The group if it has been created, nullptr otherwise
+    template <typename... Managers>
+    const Group<Managers...>* findGroup() const;
+
     // Scene serialization (to be implemented later)
 };
 
+// Inline Definitions
+
+template <typename Manager, typename... Args>
+Manager& Scene::registerComponent(Args&&... args) {
+    Manager& manager = registry.registerComponent<Manager>(std::forward<Args>(args)...);
+    manager.setCurrentTick(currentTick);
+    return manager;
+}
+
+template <typename... Managers>
+bool Scene::hasComponents(Entity entity) const {
+    return registry.hasAll(entity, registry.maskOf<std::remove_cv_t<Managers>...>());
+}
+
+template <typename Manager>
+Manager& Scene::getManager() {
+    if (Manager* manager = registry.find<Manager>()) {
+        return *manager;
+    }
+    return registerComponent<Manager>();
+}
+
+template <typename Manager>
+const Manager& Scene::getManager() const {
+    return registry.get<Manager>();
+}
+
+template <typename... Managers>
+View<Managers...> Scene::view() {
+    return View<Managers...>(getManager<Managers>()...);
+}
+
+template <typename... Managers>
+View<const Managers...> Scene::view() const {
+    return View<const Managers...>(getManager<Managers>()...);
+}
+
+template <typename... Managers>
+Group<Managers...>& Scene::group() {
+    if (const Group<Managers...>* existing = findGroup<Managers...>()) {
+        return const_cast<Group<Managers...>&>(*existing);
+    }
+    auto created = std::make_unique<Group<Managers...>>(getManager<Managers>()...);
+    Group<Managers...>& result = *created;
+    groups.emplace_back(getTypeId<Group<Managers...>>(), std::move(created));
+    return result;
+}
+
+template <typename... Managers>
+const Group<Managers...>* Scene::findGroup() const {
+    const TypeId id = getTypeId<Group<Managers...>>();
+    for (const auto& [groupId, group] : groups) {
+        if (groupId == id) {
+            return static_cast<const Group<Managers...>*>(group.get());
+        }
+    }
+    return nullptr;
+}
+
 } // namespace virealis
 
 #endif // VIREALIS_SCENE_H
@@ -0,0 +1,144 @@
+#ifndef VIREALIS_VIEW_H
+#define VIREALIS_VIEW_H
+
+#include <virealis/Core/Entity.hpp>
+#include <virealis/Core/SparseSet.hpp>
+#include <algorithm>
+#include <array>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace virealis {
+
+/*
+A view over every entity that has a component in all of the given managers.
+
+Iteration walks the dense entity array of the smallest manager and probes the others
+through their sparse sets, so entities lacking any of the components are never visited
+beyond that one probe. The callback receives the entity followed by its dense index in
+each manager, in the order the managers were listed:
+
+    scene.view<MeshComponentManager, TransformComponentManager>().each(
+        [&](Entity entity, size_t meshIndex, size_t transformIndex) { ... });
+
+changedSince<Manager>(tick) restricts the view to entities whose component in that
+manager was created or modified after the given tick (see Scene::advanceTick).
+
+Managers must not be structurally modified (create/destroy) while a view is iterating.
+*/
+template <typename... Managers>
+class View {
+public:
+    static_assert(sizeof...(Managers) > 0, "A view needs at least one component manager.");
+
+    explicit View(Managers&... managers) : managers(&managers...) {}
+
+    // Upper bound on the number of entities the view yields
+    size_t sizeHint() const;
+
+    // Only yield entities whose Manager component changed after tick
+    template <typename Manager>
+    View& changedSince(uint32_t tick);
+
+    template <typename Func>
+    void each(Func&& func) const;
+
+private:
+    template <size_t... Is>
+    size_t findLead(std::index_sequence<Is...>) const;
+
+    template <typename Func, size_t... Is>
+    void eachImpl(Func& func, std::index_sequence<Is...>) const;
+
+    template <typename Manager>
+    static constexpr size_t positionOf();
+
+    std::tuple<Managers*...> managers;
+    std::array<uint32_t, sizeof...(Managers)> sinceTicks{}; // 0 passes every component
+    bool filtered = false;
+};
+
+// Inline Definitions
+
+template <typename... Managers>
+template <size_t... Is>
+size_t View<Managers...>::findLead(std::index_sequence<Is...>) const {
+    std::array<size_t, sizeof...(Managers)> sizes{ std::get<Is>(managers)->getEntitySet().size()... };
+    size_t lead = 0;
+    for (size_t i = 1; i < sizes.size(); ++i) {
+        if (sizes[i] < sizes[lead]) {
+            lead = i;
+        }
+    }
+    return lead;
+}
+
+template <typename... Managers>
+template <typename Manager>
+constexpr size_t View<Managers...>::positionOf() {
+    constexpr std::array<bool, sizeof...(Managers)> matches{
+        std::is_same_v<std::remove_cv_t<Managers>, std::remove_cv_t<Manager>>...
+    };
+    for (size_t i = 0; i < matches.size(); ++i) {
+        if (matches[i]) {
+            return i;
+        }
+    }
+    return matches.size();
+}
+
+template <typename... Managers>
+template <typename Manager>
+View<Managers...>& View<Managers...>::changedSince(uint32_t tick) {
+    constexpr size_t position = positionOf<Manager>();
+    static_assert(position < sizeof...(Managers), "changedSince needs a manager that is part of the view.");
+    sinceTicks[position] = tick;
+    filtered = true;
+    return *this;
+}
+
+template <typename... Managers>
+size_t View<Managers...>::sizeHint() const {
+    return std::apply([](auto*... manager) {
+        return std::min({ manager->getEntitySet().size()... });
+    }, managers);
+}
+
+template <typename... Managers>
+template <typename Func, size_t... Is>
+void View<Managers...>::eachImpl(Func& func, std::index_sequence<Is...>) const {
+    const size_t lead = findLead(std::index_sequence<Is...>{});
+    const std::array<const SparseSet*, sizeof...(Managers)> sets{ &std::get<Is>(managers)->getEntitySet()... };
+    const std::vector<Entity>& entities = sets[lead]->getEntities();
+
+    for (size_t position = 0; position < entities.size(); ++position) {
+        const Entity entity = entities[position];
+
+        // The lead manager's slot is the loop position; probe the rest
+        const std::array<size_t, sizeof...(Managers)> indices{
+            (Is == lead ? position : sets[Is]->indexOf(entity))...
+        };
+
+        if (!((indices[Is] != SparseSet::npos) && ...)) {
+            continue;
+        }
+        if (filtered && !(sets[Is]->changedSince(indices[Is], sinceTicks[Is]) && ...)) {
+            continue;
+        }
+        func(entity, indices[Is]...);
+    }
+}
+
+template <typename... Managers>
+template <typename Func>
+void View<Managers...>::each(Func&& func) const {
+    eachImpl(func, std::index_sequence_for<Managers...>{});
+}
+
+} // namespace virealis
+
+#endif // VIREALIS_VIEW_H
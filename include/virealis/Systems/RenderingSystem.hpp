@@ -2,6 +2,7 @@
 #define VIREALIS_RENDERING_SYSTEM_H
 
 #include <virealis/Scene/Scene.hpp>
+#include <vector>
 #include <glad/glad.h>   // OpenGL function loader
 #include <GLFW/glfw3.h>  // For GLFW context management (if needed for windowing)
 
@@ -11,12 +12,26 @@ class RenderingSystem {
 private:
     GLuint shaderProgram;
 
+    // Per-frame scratch, kept to reuse the allocations: the slots of each entity drawn,
+    // then its interpolated world, model and MVP matrices, each computed in one batch
+    struct DrawItem {
+        size_t meshIndex;
+        size_t materialIndex;
+    };
+    std::vector<DrawItem> drawItems;
+    std::vector<size_t> transformIndices;
+    std::vector<Matrix3x4> worldTransforms;
+    TransformComponentManager::InterpolationScratch interpolationScratch;
+    std::vector<Matrix4x4> modelMatrices;
+    std::vector<Matrix4x4> mvpMatrices;
+
 public:
     // Constructor initializes with a compiled shader program
     RenderingSystem(GLuint shaderProgram);
     
-    // Render function that takes a scene and the active camera entity
-    void render(const Scene& scene, Entity activeCameraEntity);
+    // Render function that takes a scene and the active camera entity. With a fixed-step
+    // simulation, alpha blends between its last two steps (see swapTransformBuffers).
+    void render(const Scene& scene, Entity activeCameraEntity, float alpha = 1.0f);
 };
 
 } // namespace virealis
@@ -0,0 +1,113 @@
+#ifndef VIREALIS_SYSTEM_SCHEDULER_H
+#define VIREALIS_SYSTEM_SCHEDULER_H
+
+#include <virealis/Core/ThreadPool.hpp>
+#include <virealis/Core/TypeId.hpp>
+#include <virealis/Scene/CommandBuffer.hpp>
+#include <virealis/Scene/Scene.hpp>
+#include <exception>
+#include <functional>
+#include <string>
+#include <vector>
+#include <cstddef>
+
+namespace virealis {
+
+// The component managers a system reads and writes, e.g.
+// SystemAccess().read<MeshComponentManager>().write<TransformComponentManager>()
+class SystemAccess {
+public:
+    template <typename Manager>
+    SystemAccess& read();
+    template <typename Manager>
+    SystemAccess& write();
+
+    // Two systems conflict if either one writes a manager the other reads or writes
+    bool conflictsWith(const SystemAccess& other) const;
+
+private:
+    std::vector<TypeId> reads;
+    std::vector<TypeId> writes;
+};
+
+/*
+Runs systems in parallel on a ThreadPool according to their declared access.
+
+Systems are ordered by registration: a system depends on every earlier system it
+conflicts with, which gives a DAG. Systems with no unfinished dependencies run
+concurrently. Systems marked mainThreadOnly (e.g. anything issuing OpenGL calls) only
+run on the thread that called run().
+
+Systems must not create or destroy entities or components on the Scene directly while
+others may be running; they record those changes in getCommandBuffer() instead. Sync
+points split the systems into phases that run one after another: once a phase has
+finished, the commands its systems recorded are played back, so systems in later phases
+see the changes. run() ends with a final playback.
+*/
+class SystemScheduler {
+public:
+    using SystemFunction = std::function<void(Scene&)>;
+
+    struct SystemTiming {
+        std::string name;
+        double milliseconds;
+    };
+
+    explicit SystemScheduler(ThreadPool& threadPool);
+
+    void addSystem(const std::string& name, const SystemAccess& access,
+                   SystemFunction function, bool mainThreadOnly = false);
+
+    // Systems added after this wait for every system added before it, and see the
+    // structural changes those recorded
+    void addSyncPoint();
+
+    // The calling thread's buffer for structural changes; use it from inside a system
+    CommandBuffer& getCommandBuffer();
+
+    // Runs every system once and returns when all have finished. Rethrows the first
+    // exception a system threw, after the remaining systems have run.
+    void run(Scene& scene);
+
+    // Wall time of each system during the last run(), in registration order
+    const std::vector<SystemTiming>& getTimings() const;
+
+private:
+    struct System {
+        std::string name;
+        SystemAccess access;
+        SystemFunction function;
+        bool mainThreadOnly;
+        std::vector<size_t> dependents;
+        size_t dependencyCount = 0;
+    };
+
+    void buildGraph();
+    // Runs systems [first, last) and stores the first exception one threw in error
+    void runPhase(Scene& scene, size_t first, size_t last, std::exception_ptr& error);
+
+    ThreadPool& threadPool;
+    CommandBufferSet commandBuffers;
+    std::vector<System> systems;
+    std::vector<size_t> phaseStarts{ 0 }; // Index of the first system of each phase
+    std::vector<SystemTiming> timings;
+    bool graphDirty = false;
+};
+
+// Inline Definitions
+
+template <typename Manager>
+SystemAccess& SystemAccess::read() {
+    reads.push_back(getTypeId<Manager>());
+    return *this;
+}
+
+template <typename Manager>
+SystemAccess& SystemAccess::write() {
+    writes.push_back(getTypeId<Manager>());
+    return *this;
+}
+
+} // namespace virealis
+
+#endif // VIREALIS_SYSTEM_SCHEDULER_H
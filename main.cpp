@@ -3,44 +3,78 @@
 #include <virealis/Scene/Scene.hpp>
 #include <virealis/Rendering/Shader.hpp>
 #include <virealis/Systems/RenderingSystem.hpp>
+#include <virealis/Systems/SystemScheduler.hpp>
 #include <virealis/Math/Matrix4x4.hpp>
 #include <virealis/Math/Constants.hpp>
+#include <virealis/Math/ConstexprMath.hpp>
+#include <array>
 
 
-void generateSphereData(int latitudeSegments, int longitudeSegments, std::vector<virealis::Vector3>& vertices, std::vector<uint32_t>& indices) {
-    for (int lat = 0; lat <= latitudeSegments; ++lat) {
-        float theta = lat * virealis::Constants::PI / latitudeSegments;
-        float sinTheta = sin(theta);
-        float cosTheta = cos(theta);
+// Vertices and triangle indices of a unit sphere in latitude and longitude rings
+template <int LatitudeSegments, int LongitudeSegments>
+struct SphereData {
+    std::array<virealis::Vector3, (LatitudeSegments + 1) * (LongitudeSegments + 1)> vertices;
+    std::array<uint32_t, LatitudeSegments * LongitudeSegments * 6> indices;
+};
 
-        for (int lon = 0; lon <= longitudeSegments; ++lon) {
-            float phi = lon * 2 * virealis::Constants::PI / longitudeSegments;
-            float sinPhi = sin(phi);
-            float cosPhi = cos(phi);
+// constexpr, so fixed-size spheres are generated at compile time into read-only data
+template <int LatitudeSegments, int LongitudeSegments>
+constexpr SphereData<LatitudeSegments, LongitudeSegments> generateSphereData() {
+    SphereData<LatitudeSegments, LongitudeSegments> sphere{};
+
+    size_t vertex = 0;
+    for (int lat = 0; lat <= LatitudeSegments; ++lat) {
+        float theta = lat * virealis::Constants::PI / LatitudeSegments;
+        float sinTheta = virealis::ConstexprMath::sin(theta);
+        float cosTheta = virealis::ConstexprMath::cos(theta);
+
+        for (int lon = 0; lon <= LongitudeSegments; ++lon) {
+            float phi = lon * 2 * virealis::Constants::PI / LongitudeSegments;
+            float sinPhi = virealis::ConstexprMath::sin(phi);
+            float cosPhi = virealis::ConstexprMath::cos(phi);
 
             float x = cosPhi * sinTheta;
             float y = cosTheta;
             float z = sinPhi * sinTheta;
-            vertices.push_back({x, y, z});
+            sphere.vertices[vertex++] = {x, y, z};
         }
     }
 
-    for (int lat = 0; lat < latitudeSegments; ++lat) {
-        for (int lon = 0; lon < longitudeSegments; ++lon) {
-            uint32_t first = lat * (longitudeSegments + 1) + lon;
-            uint32_t second = first + longitudeSegments + 1;
+    size_t index = 0;
+    for (int lat = 0; lat < LatitudeSegments; ++lat) {
+        for (int lon = 0; lon < LongitudeSegments; ++lon) {
+            uint32_t first = lat * (LongitudeSegments + 1) + lon;
+            uint32_t second = first + LongitudeSegments + 1;
 
-            indices.push_back(first);
-            indices.push_back(second);
-            indices.push_back(first + 1);
+            sphere.indices[index++] = first;
+            sphere.indices[index++] = second;
+            sphere.indices[index++] = first + 1;
 
-            indices.push_back(second);
-            indices.push_back(second + 1);
-            indices.push_back(first + 1);
+            sphere.indices[index++] = second;
+            sphere.indices[index++] = second + 1;
+            sphere.indices[index++] = first + 1;
         }
     }
+    return sphere;
 }
 
+constexpr auto UnitSphere = generateSphereData<16, 16>();
+
+// Cube data
+constexpr std::array<virealis::Vector3, 8> CubeVertices = {{
+    {-0.5f, -0.5f, -0.5f}, {0.5f, -0.5f, -0.5f}, {0.5f,  0.5f, -0.5f}, {-0.5f,  0.5f, -0.5f}, // Back face
+    {-0.5f, -0.5f,  0.5f}, {0.5f, -0.5f,  0.5f}, {0.5f,  0.5f,  0.5f}, {-0.5f,  0.5f,  0.5f}, // Front face
+}};
+
+constexpr std::array<uint32_t, 36> CubeIndices = {
+    0, 1, 2, 2, 3, 0, // Back face
+    4, 5, 6, 6, 7, 4, // Front face
+    0, 4, 7, 7, 3, 0, // Left face
+    1, 5, 6, 6, 2, 1, // Right face
+    0, 1, 5, 5, 4, 0, // Bottom face
+    3, 2, 6, 6, 7, 3  // Top face
+};
+
 void GLAPIENTRY MessageCallback( GLenum source,
                                  GLenum type,
                                  GLuint id,
@@ -163,20 +197,13 @@ int main() {
     virealis::Scene scene;
     std::cout << "Scene Created" << std::endl;
 
-    // Cube data
-    std::vector<virealis::Vector3> cubeVertices = {
-        {-0.5f, -0.5f, -0.5f}, {0.5f, -0.5f, -0.5f}, {0.5f,  0.5f, -0.5f}, {-0.5f,  0.5f, -0.5f}, // Back face
-        {-0.5f, -0.5f,  0.5f}, {0.5f, -0.5f,  0.5f}, {0.5f,  0.5f,  0.5f}, {-0.5f,  0.5f,  0.5f}, // Front face
-    };
-
-    std::vector<uint32_t> cubeIndices = {
-        0, 1, 2, 2, 3, 0, // Back face
-        4, 5, 6, 6, 7, 4, // Front face
-        0, 4, 7, 7, 3, 0, // Left face
-        1, 5, 6, 6, 2, 1, // Right face
-        0, 1, 5, 5, 4, 0, // Bottom face
-        3, 2, 6, 6, 7, 3  // Top face
-    };
+    // Keep renderable entities packed in the same order across their three managers
+    scene.group<virealis::MeshComponentManager, virealis::TransformComponentManager,
+                virealis::MaterialComponentManager>();
+
+    // Cube data, copied out of the compile-time tables
+    std::vector<virealis::Vector3> cubeVertices(CubeVertices.begin(), CubeVertices.end());
+    std::vector<uint32_t> cubeIndices(CubeIndices.begin(), CubeIndices.end());
 
     // Create cube entity
     virealis::Entity cubeEntity = scene.createEntity();
@@ -187,12 +214,13 @@ int main() {
     std::cout << "Cube Material Created" << std::endl;
     scene.getTransformManager().create(cubeEntity, virealis::Matrix4x4::identity());
     std::cout << "Cube Transform Created" << std::endl;
+    scene.getBoundsManager().create(cubeEntity, scene.getMeshManager().getLocalBounds(cubeEntity),
+                                    scene.getMeshManager().getLocalSphere(cubeEntity));
+    std::cout << "Cube Bounds Created" << std::endl;
 
     // Sphere data
-    std::vector<virealis::Vector3> sphereVertices;
-    std::vector<uint32_t> sphereIndices;
-    generateSphereData(16, 16, sphereVertices, sphereIndices);
-    std::cout << "Sphere Data Generated" << std::endl;
+    std::vector<virealis::Vector3> sphereVertices(UnitSphere.vertices.begin(), UnitSphere.vertices.end());
+    std::vector<uint32_t> sphereIndices(UnitSphere.indices.begin(), UnitSphere.indices.end());
 
     // Create sphere entity
     virealis::Entity sphereEntity = scene.createEntity();
@@ -203,6 +231,9 @@ int main() {
     std::cout << "Sphere Material Created" << std::endl;
     scene.getTransformManager().create(sphereEntity, virealis::Matrix4x4::identity());
     std::cout << "Sphere Transform Created" << std::endl;
+    scene.getBoundsManager().create(sphereEntity, scene.getMeshManager().getLocalBounds(sphereEntity),
+                                    scene.getMeshManager().getLocalSphere(sphereEntity));
+    std::cout << "Sphere Bounds Created" << std::endl;
 
     // Create a camera entity
     virealis::Entity cameraEntity = scene.createEntity();
@@ -216,6 +247,28 @@ int main() {
     virealis::RenderingSystem renderingSystem(shaderProgram);
     std::cout << "Rendering System Created" << std::endl;
 
+    // Schedule the per-frame systems; rendering issues GL calls, so it stays on the main thread
+    virealis::ThreadPool threadPool;
+    virealis::SystemScheduler scheduler(threadPool);
+    // Updating the transforms also refreshes the world bounds of the entities that moved
+    scheduler.addSystem("Transform Propagation",
+                        virealis::SystemAccess()
+                            .write<virealis::TransformComponentManager>()
+                            .write<virealis::BoundsComponentManager>(),
+                        [](virealis::Scene& scene) {
+                            scene.getTransformManager().swapTransformBuffers();
+                            scene.getTransformManager().updateTransforms();
+                        });
+    scheduler.addSystem("Rendering",
+                        virealis::SystemAccess()
+                            .read<virealis::MeshComponentManager>()
+                            .read<virealis::MaterialComponentManager>()
+                            .read<virealis::TransformComponentManager>()
+                            .read<virealis::CameraComponentManager>(),
+                        [&](virealis::Scene& scene) { renderingSystem.render(scene, cameraEntity); },
+                        true);
+    std::cout << "System Scheduler Created" << std::endl;
+
     // Main loop
     while (!glfwWindowShouldClose(window)) {
         std::cout << "Rendering Loop Start" << std::endl;
@@ -224,8 +277,9 @@ int main() {
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
         std::cout << "Screen Cleared" << std::endl;
 
-        // Render the scene using the ECS rendering system
-        renderingSystem.render(scene, cameraEntity);
+        // Start a new change-tracking tick, then run the ECS systems for this frame (transform propagation, then rendering)
+        scene.advanceTick();
+        scheduler.run(scene);
         std::cout << "Rendered Scene" << std::endl;
 
         // Swap front and back buffers
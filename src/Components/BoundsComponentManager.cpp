@@ -0,0 +1,51 @@
+#include <virealis/Components/BoundsComponentManager.hpp>
+#include <stdexcept>
+
+namespace virealis {
+
+void BoundsComponentManager::create(Entity entity, const AABB& localBounds, const BoundingSphere& localSphere) {
+    if (entitySet.contains(entity)) {
+        throw std::runtime_error("Entity already has a bounds component.");
+    }
+
+    entitySet.insert(entity);
+    data.pushBack(localBounds, localSphere, localBounds, localSphere);
+    notifyConstruct(entity);
+}
+
+void BoundsComponentManager::reserve(size_t count) {
+    entitySet.reserve(count);
+    data.reserve(count);
+}
+
+void BoundsComponentManager::swapData(size_t a, size_t b) {
+    data.swapElements(a, b);
+}
+
+void BoundsComponentManager::popData() {
+    data.popBack();
+}
+
+void BoundsComponentManager::updateWorldBounds(size_t index, const Matrix3x4& worldTransform) {
+    data.get<WorldBounds>()[index] = data.get<LocalBounds>()[index].transformed(worldTransform);
+    data.get<WorldSphere>()[index] = data.get<LocalSphere>()[index].transformed(worldTransform);
+    entitySet.markChanged(index);
+}
+
+AABB BoundsComponentManager::getWorldBounds(Entity entity) const {
+    size_t index = entitySet.indexOf(entity);
+    if (index == SparseSet::npos) {
+        throw std::runtime_error("Entity does not have a bounds component.");
+    }
+    return data.get<WorldBounds>()[index];
+}
+
+BoundingSphere BoundsComponentManager::getWorldSphere(Entity entity) const {
+    size_t index = entitySet.indexOf(entity);
+    if (index == SparseSet::npos) {
+        throw std::runtime_error("Entity does not have a bounds component.");
+    }
+    return data.get<WorldSphere>()[index];
+}
+
+} // namespace virealis
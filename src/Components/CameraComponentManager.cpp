@@ -9,101 +9,80 @@ void CameraComponentManager::create(Entity entity, const Vector3& position,
                                     ProjectionType projectionType, float fov,
                                     float aspectRatio, float nearPlane,
                                     float farPlane) {
-    if (entityToIndexMap.find(entity) != entityToIndexMap.end()) {
+    if (entitySet.contains(entity)) {
         throw std::runtime_error("Entity already has a camera component.");
     }
 
-    size_t index = data.entities.size();
-    data.entities.push_back(entity);
-    data.positions.push_back(position);
-    data.orientations.push_back(orientation);
-    data.fovs.push_back(fov);
-    data.aspectRatios.push_back(aspectRatio);
-    data.nearPlanes.push_back(nearPlane);
-    data.farPlanes.push_back(farPlane);
-    data.projectionTypes.push_back(projectionType);
-
     // Calculate the initial view and projection matrices
     Matrix4x4 viewMatrix = Matrix4x4::lookAt(position, position + orientation, Vector3(0, 1, 0));
     Matrix4x4 projectionMatrix = (projectionType == ProjectionType::Perspective)
                                      ? Matrix4x4::perspective(fov, aspectRatio, nearPlane, farPlane)
                                      : Matrix4x4::orthographic(-aspectRatio, aspectRatio, -1.0f, 1.0f, nearPlane, farPlane);
 
-    data.viewMatrices.push_back(viewMatrix);
-    data.projectionMatrices.push_back(projectionMatrix);
-
-    entityToIndexMap[entity] = index;
+    entitySet.insert(entity);
+    data.pushBack(position, orientation, viewMatrix, projectionMatrix,
+                  fov, aspectRatio, nearPlane, farPlane, projectionType);
+    notifyConstruct(entity);
 }
 
-void CameraComponentManager::destroy(Entity entity) {
-    auto it = entityToIndexMap.find(entity);
-    if (it == entityToIndexMap.end()) {
-        return; // Entity doesn't have a camera component
+void CameraComponentManager::createBatch(std::span<const Entity> entities,
+                                         std::span<const Vector3> positions,
+                                         std::span<const Vector3> orientations,
+                                         ProjectionType projectionType, float fov,
+                                         float aspectRatio, float nearPlane,
+                                         float farPlane) {
+    if (positions.size() != entities.size() || orientations.size() != entities.size()) {
+        throw std::runtime_error("createBatch needs one position and orientation per entity.");
     }
+    checkBatchEntities(entities, "Entity already has a camera component.");
 
-    size_t index = it->second;
-    size_t lastIndex = data.entities.size() - 1;
+    // One allocation per array for the whole batch
+    reserve(entitySet.size() + entities.size());
+    for (size_t i = 0; i < entities.size(); ++i) {
+        create(entities[i], positions[i], orientations[i], projectionType, fov, aspectRatio, nearPlane, farPlane);
+    }
+}
 
-    // Swap with the last element to maintain a compact array
-    data.entities[index] = data.entities[lastIndex];
-    data.positions[index] = data.positions[lastIndex];
-    data.orientations[index] = data.orientations[lastIndex];
-    data.viewMatrices[index] = data.viewMatrices[lastIndex];
-    data.projectionMatrices[index] = data.projectionMatrices[lastIndex];
-    data.fovs[index] = data.fovs[lastIndex];
-    data.aspectRatios[index] = data.aspectRatios[lastIndex];
-    data.nearPlanes[index] = data.nearPlanes[lastIndex];
-    data.farPlanes[index] = data.farPlanes[lastIndex];
-    data.projectionTypes[index] = data.projectionTypes[lastIndex];
+void CameraComponentManager::reserve(size_t count) {
+    entitySet.reserve(count);
+    data.reserve(count);
+}
 
-    // Update the index map
-    entityToIndexMap[data.entities[index]] = index;
+void CameraComponentManager::swapData(size_t a, size_t b) {
+    data.swapElements(a, b);
+}
 
-    // Remove the last element
-    data.entities.pop_back();
-    data.positions.pop_back();
-    data.orientations.pop_back();
-    data.viewMatrices.pop_back();
-    data.projectionMatrices.pop_back();
-    data.fovs.pop_back();
-    data.aspectRatios.pop_back();
-    data.nearPlanes.pop_back();
-    data.farPlanes.pop_back();
-    data.projectionTypes.pop_back();
-    entityToIndexMap.erase(entity);
+void CameraComponentManager::popData() {
+    data.popBack();
 }
 
 Matrix4x4 CameraComponentManager::getViewMatrix(Entity entity) const {
-    auto it = entityToIndexMap.find(entity);
-    if (it == entityToIndexMap.end()) {
+    size_t index = entitySet.indexOf(entity);
+    if (index == SparseSet::npos) {
         throw std::runtime_error("Entity does not have a camera component.");
     }
-    return data.viewMatrices[it->second];
+    return data.get<ViewMatrix>()[index];
 }
 
 Matrix4x4 CameraComponentManager::getProjectionMatrix(Entity entity) const {
-    auto it = entityToIndexMap.find(entity);
-    if (it == entityToIndexMap.end()) {
+    size_t index = entitySet.indexOf(entity);
+    if (index == SparseSet::npos) {
         throw std::runtime_error("Entity does not have a camera component.");
     }
-    return data.projectionMatrices[it->second];
+    return data.get<ProjectionMatrix>()[index];
 }
 
 void CameraComponentManager::updateCamera(Entity entity, const Vector3& position, const Vector3& orientation) {
-    auto it = entityToIndexMap.find(entity);
-    if (it == entityToIndexMap.end()) {
+    size_t index = entitySet.indexOf(entity);
+    if (index == SparseSet::npos) {
         throw std::runtime_error("Entity does not have a camera component.");
     }
 
-    size_t index = it->second;
-    data.positions[index] = position;
-    data.orientations[index] = orientation;
-
-    data.viewMatrices[index] = Matrix4x4::lookAt(position, position + orientation, Vector3(0, 1, 0));
-}
+    data.get<Position>()[index] = position;
+    data.get<Orientation>()[index] = orientation;
 
-bool CameraComponentManager::isValid(Entity entity) const {
-    return entityToIndexMap.find(entity) != entityToIndexMap.end();
+    data.get<ViewMatrix>()[index] = Matrix4x4::lookAt(position, position + orientation, Vector3(0, 1, 0));
+    entitySet.markChanged(index);
 }
 
 } // namespace virealis
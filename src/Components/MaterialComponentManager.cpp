@@ -7,104 +7,93 @@ void MaterialComponentManager::create(Entity entity, const Vector3& diffuseColor
                                       const Vector3& specularColor, float shininess,
                                       const std::string& texture,
                                       float opacity, float reflectivity) {
-    if (entityToIndexMap.find(entity) != entityToIndexMap.end()) {
+    if (entitySet.contains(entity)) {
         throw std::runtime_error("Entity already has a material component.");
     }
 
-    size_t index = data.entities.size();
-    data.entities.push_back(entity);
-    data.diffuseColors.push_back(diffuseColor);
-    data.specularColors.push_back(specularColor);
-    data.shininesses.push_back(shininess);
-    data.textures.push_back(texture);  // Optional texture
-    data.opacities.push_back(opacity);
-    data.reflectivities.push_back(reflectivity);
-
-    entityToIndexMap[entity] = index;
+    entitySet.insert(entity);
+    data.pushBack(diffuseColor, specularColor, shininess, texture, opacity, reflectivity);
+    notifyConstruct(entity);
 }
 
-void MaterialComponentManager::destroy(Entity entity) {
-    auto it = entityToIndexMap.find(entity);
-    if (it == entityToIndexMap.end()) {
-        return; // Entity doesn't have a material component
+void MaterialComponentManager::createBatch(std::span<const Entity> entities,
+                                           std::span<const Vector3> diffuseColors,
+                                           std::span<const Vector3> specularColors,
+                                           std::span<const float> shininesses) {
+    if (diffuseColors.size() != entities.size() || specularColors.size() != entities.size() ||
+        shininesses.size() != entities.size()) {
+        throw std::runtime_error("createBatch needs one material value per entity.");
     }
+    checkBatchEntities(entities, "Entity already has a material component.");
+
+    // One allocation per array for the whole batch
+    reserve(entitySet.size() + entities.size());
+    for (size_t i = 0; i < entities.size(); ++i) {
+        entitySet.insert(entities[i]);
+        data.pushBack(diffuseColors[i], specularColors[i], shininesses[i], std::string(), 1.0f, 0.0f);
+        notifyConstruct(entities[i]);
+    }
+}
 
-    size_t index = it->second;
-    size_t lastIndex = data.entities.size() - 1;
-
-    // Swap with the last element to maintain a compact array
-    data.entities[index] = data.entities[lastIndex];
-    data.diffuseColors[index] = data.diffuseColors[lastIndex];
-    data.specularColors[index] = data.specularColors[lastIndex];
-    data.shininesses[index] = data.shininesses[lastIndex];
-    data.textures[index] = data.textures[lastIndex];
-    data.opacities[index] = data.opacities[lastIndex];
-    data.reflectivities[index] = data.reflectivities[lastIndex];
+void MaterialComponentManager::reserve(size_t count) {
+    entitySet.reserve(count);
+    data.reserve(count);
+}
 
-    // Update the index map
-    entityToIndexMap[data.entities[index]] = index;
+void MaterialComponentManager::swapData(size_t a, size_t b) {
+    data.swapElements(a, b);
+}
 
-    // Remove the last element
-    data.entities.pop_back();
-    data.diffuseColors.pop_back();
-    data.specularColors.pop_back();
-    data.shininesses.pop_back();
-    data.textures.pop_back();
-    data.opacities.pop_back();
-    data.reflectivities.pop_back();
-    entityToIndexMap.erase(entity);
+void MaterialComponentManager::popData() {
+    data.popBack();
 }
 
 Vector3 MaterialComponentManager::getDiffuseColor(Entity entity) const {
-    auto it = entityToIndexMap.find(entity);
-    if (it == entityToIndexMap.end()) {
+    size_t index = entitySet.indexOf(entity);
+    if (index == SparseSet::npos) {
         throw std::runtime_error("Entity does not have a material component.");
     }
-    return data.diffuseColors[it->second];
+    return data.get<DiffuseColor>()[index];
 }
 
 Vector3 MaterialComponentManager::getSpecularColor(Entity entity) const {
-    auto it = entityToIndexMap.find(entity);
-    if (it == entityToIndexMap.end()) {
+    size_t index = entitySet.indexOf(entity);
+    if (index == SparseSet::npos) {
         throw std::runtime_error("Entity does not have a material component.");
     }
-    return data.specularColors[it->second];
+    return data.get<SpecularColor>()[index];
 }
 
 float MaterialComponentManager::getShininess(Entity entity) const {
-    auto it = entityToIndexMap.find(entity);
-    if (it == entityToIndexMap.end()) {
+    size_t index = entitySet.indexOf(entity);
+    if (index == SparseSet::npos) {
         throw std::runtime_error("Entity does not have a material component.");
     }
-    return data.shininesses[it->second];
+    return data.get<Shininess>()[index];
 }
 
 std::string MaterialComponentManager::getTexture(Entity entity) const {
-    auto it = entityToIndexMap.find(entity);
-    if (it == entityToIndexMap.end()) {
+    size_t index = entitySet.indexOf(entity);
+    if (index == SparseSet::npos) {
         throw std::runtime_error("Entity does not have a material component.");
     }
-    return data.textures[it->second];
+    return data.get<Texture>()[index];
 }
 
 float MaterialComponentManager::getOpacity(Entity entity) const {
-    auto it = entityToIndexMap.find(entity);
-    if (it == entityToIndexMap.end()) {
+    size_t index = entitySet.indexOf(entity);
+    if (index == SparseSet::npos) {
         throw std::runtime_error("Entity does not have a material component.");
     }
-    return data.opacities[it->second];
+    return data.get<Opacity>()[index];
 }
 
 float MaterialComponentManager::getReflectivity(Entity entity) const {
-    auto it = entityToIndexMap.find(entity);
-    if (it == entityToIndexMap.end()) {
+    size_t index = entitySet.indexOf(entity);
+    if (index == SparseSet::npos) {
         throw std::runtime_error("Entity does not have a material component.");
     }
-    return data.reflectivities[it->second];
-}
-
-bool MaterialComponentManager::isValid(Entity entity) const {
-    return entityToIndexMap.find(entity) != entityToIndexMap.end();
+    return data.get<Reflectivity>()[index];
 }
 
 } // namespace virealis
@@ -8,80 +8,95 @@ void MeshComponentManager::create(Entity entity,
                                   const std::vector<uint32_t>& indices,
                                   const std::vector<Vector3>& normals,
                                   const std::vector<Vector2>& uvCoords) {
-    if (entityToIndexMap.find(entity) != entityToIndexMap.end()) {
+    if (entitySet.contains(entity)) {
         throw std::runtime_error("Entity already has a mesh component.");
     }
 
-    size_t index = data.entities.size();
-    data.entities.push_back(entity);
-    data.vertices.push_back(vertices);
-    data.normals.push_back(normals);
-    data.uvCoordinates.push_back(uvCoords);  // Add UV coordinates
-    data.indices.push_back(indices);
-
-    entityToIndexMap[entity] = index;
+    entitySet.insert(entity);
+    data.pushBack(vertices, normals, uvCoords, indices,
+                  AABB::fromPoints(vertices), BoundingSphere::fromPoints(vertices));
+    notifyConstruct(entity);
 }
 
-void MeshComponentManager::destroy(Entity entity) {
-    auto it = entityToIndexMap.find(entity);
-    if (it == entityToIndexMap.end()) {
-        return; // Entity doesn't have a mesh component
+void MeshComponentManager::createBatch(std::span<const Entity> entities,
+                                       std::span<const std::vector<Vector3>> vertices,
+                                       std::span<const std::vector<uint32_t>> indices,
+                                       std::span<const std::vector<Vector3>> normals) {
+    if (vertices.size() != entities.size() || indices.size() != entities.size() ||
+        normals.size() != entities.size()) {
+        throw std::runtime_error("createBatch needs one mesh per entity.");
     }
+    checkBatchEntities(entities, "Entity already has a mesh component.");
 
-    size_t index = it->second;
-    size_t lastIndex = data.entities.size() - 1;
+    // One allocation per array for the whole batch
+    reserve(entitySet.size() + entities.size());
+    for (size_t i = 0; i < entities.size(); ++i) {
+        entitySet.insert(entities[i]);
+        data.pushBack(vertices[i], normals[i], std::vector<Vector2>{}, indices[i],
+                      AABB::fromPoints(vertices[i]), BoundingSphere::fromPoints(vertices[i]));
+        notifyConstruct(entities[i]);
+    }
+}
 
-    // Swap with the last element to maintain a compact array
-    data.entities[index] = data.entities[lastIndex];
-    data.vertices[index] = data.vertices[lastIndex];
-    data.normals[index] = data.normals[lastIndex];
-    data.indices[index] = data.indices[lastIndex];
+void MeshComponentManager::reserve(size_t count) {
+    entitySet.reserve(count);
+    data.reserve(count);
+}
 
-    // Update the index map
-    entityToIndexMap[data.entities[index]] = index;
+void MeshComponentManager::swapData(size_t a, size_t b) {
+    data.swapElements(a, b);
+}
 
-    // Remove the last element
-    data.entities.pop_back();
-    data.vertices.pop_back();
-    data.normals.pop_back();
-    data.indices.pop_back();
-    entityToIndexMap.erase(entity);
+void MeshComponentManager::popData() {
+    data.popBack();
 }
 
 std::vector<Vector3> MeshComponentManager::getVertices(Entity entity) const {
-    auto it = entityToIndexMap.find(entity);
-    if (it == entityToIndexMap.end()) {
+    size_t index = entitySet.indexOf(entity);
+    if (index == SparseSet::npos) {
         throw std::runtime_error("Entity does not have a mesh component.");
     }
-    return data.vertices[it->second];
+    return data.get<Vertices>()[index];
 }
 
 std::vector<Vector3> MeshComponentManager::getNormals(Entity entity) const {
-    auto it = entityToIndexMap.find(entity);
-    if (it == entityToIndexMap.end()) {
+    size_t index = entitySet.indexOf(entity);
+    if (index == SparseSet::npos) {
         throw std::runtime_error("Entity does not have a mesh component.");
     }
-    return data.normals[it->second];
+    return data.get<Normals>()[index];
 }
 
 std::vector<Vector2> MeshComponentManager::getUVCoordinates(Entity entity) const {
-    auto it = entityToIndexMap.find(entity);
-    if (it == entityToIndexMap.end()) {
+    size_t index = entitySet.indexOf(entity);
+    if (index == SparseSet::npos) {
         throw std::runtime_error("Entity does not have a mesh component.");
     }
-    return data.uvCoordinates[it->second];
+    return data.get<UVCoordinates>()[index];
 }
 
 std::vector<uint32_t> MeshComponentManager::getIndices(Entity entity) const {
-    auto it = entityToIndexMap.find(entity);
-    if (it == entityToIndexMap.end()) {
+    size_t index = entitySet.indexOf(entity);
+    if (index == SparseSet::npos) {
         throw std::runtime_error("Entity does not have a mesh component.");
     }
-    return data.indices[it->second];
+    return data.get<Indices>()[index];
 }
 
-bool MeshComponentManager::isValid(Entity entity) const {
-    return entityToIndexMap.find(entity) != entityToIndexMap.end();
+AABB MeshComponentManager::getLocalBounds(Entity entity) const {
+    size_t index = entitySet.indexOf(entity);
+    if (index == SparseSet::npos) {
+        throw std::runtime_error("Entity does not have a mesh component.");
+    }
+    return data.get<LocalBounds>()[index];
+}
+
+BoundingSphere MeshComponentManager::getLocalSphere(Entity entity) const {
+    size_t index = entitySet.indexOf(entity);
+    if (index == SparseSet::npos) {
+        throw std::runtime_error("Entity does not have a mesh component.");
+    }
+    return data.get<LocalSphere>()[index];
 }
 
 } // namespace virealis
@@ -1,112 +1,919 @@
 #include <virealis/Components/TransformComponentManager.hpp>
+#include <virealis/Components/BoundsComponentManager.hpp>
 #include <stdexcept>
+#include <limits>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
 
 namespace virealis {
 
+namespace {
+
+// Splits an affine matrix into translation, rotation and scale. A mirrored basis
+// (negative determinant) is folded into the x scale. A collapsed axis keeps its zero
+// scale and takes its direction from the others, so the rotation stays a rotation.
+template <typename Matrix>
+void decompose(const Matrix& matrix, Vector3& position, Quaternion& rotation, Vector3& scale) {
+    // Axes shorter than this are treated as collapsed
+    constexpr float epsilon = 1e-12f;
+
+    std::array<Vector3, 3> axes;
+    std::array<float, 3> lengths;
+    for (int column = 0; column < 3; ++column) {
+        axes[column] = Vector3(matrix(0, column), matrix(1, column), matrix(2, column));
+        lengths[column] = axes[column].magnitude();
+    }
+    if (axes[0].cross(axes[1]).dot(axes[2]) < 0.0f) {
+        lengths[0] = -lengths[0];
+    }
+    position = Vector3(matrix(0, 3), matrix(1, 3), matrix(2, 3));
+    scale = Vector3(lengths[0], lengths[1], lengths[2]);
+
+    std::array<bool, 3> valid;
+    int validCount = 0;
+    for (int axis = 0; axis < 3; ++axis) {
+        valid[axis] = std::abs(lengths[axis]) > epsilon;
+        if (valid[axis]) {
+            axes[axis] = axes[axis] / lengths[axis];
+            validCount++;
+        }
+    }
+
+    // One collapsed axis: the cross product of the other two, in cyclic order so the
+    // basis stays right-handed. Two that are parallel leave only one usable axis.
+    if (validCount == 2) {
+        int missing = !valid[0] ? 0 : (!valid[1] ? 1 : 2);
+        Vector3 cross = axes[(missing + 1) % 3].cross(axes[(missing + 2) % 3]);
+        if (cross.magnitude() > epsilon) {
+            axes[missing] = cross.normalized();
+        } else {
+            valid[(missing + 2) % 3] = false;
+            validCount = 1;
+        }
+    }
+    // One usable axis: any basis around it will do, since the other scales are zero.
+    // Start from the world axis least aligned with it.
+    if (validCount == 1) {
+        int kept = valid[0] ? 0 : (valid[1] ? 1 : 2);
+        const Vector3& axis = axes[kept];
+        Vector3 helper = std::abs(axis.x) <= std::abs(axis.y) && std::abs(axis.x) <= std::abs(axis.z)
+                             ? Vector3(1.0f, 0.0f, 0.0f)
+                             : (std::abs(axis.y) <= std::abs(axis.z) ? Vector3(0.0f, 1.0f, 0.0f)
+                                                                     : Vector3(0.0f, 0.0f, 1.0f));
+        Vector3 next = (helper - axis * axis.dot(helper)).normalized();
+        axes[(kept + 1) % 3] = next;
+        axes[(kept + 2) % 3] = axis.cross(next);
+    }
+    if (validCount == 0) {
+        rotation = Quaternion::identity();
+        return;
+    }
+
+    Matrix4x4 rotationMatrix = Matrix4x4::identity();
+    for (int row = 0; row < 3; ++row) {
+        for (int column = 0; column < 3; ++column) {
+            rotationMatrix(row, column) = axes[column][row];
+        }
+    }
+    rotation = Quaternion::fromRotationMatrix(rotationMatrix);
+}
+
+// What is left of an affine world once its rotation is taken out: the scale, and any
+// shear from a non-uniformly scaled parent
+Matrix3x4 removeRotation(const Matrix3x4& world, Quaternion& rotation) {
+    Vector3 position, scale;
+    decompose(world, position, rotation, scale);
+    Matrix3x4 inverseRotation = Matrix3x4::fromTranslationRotationScale(Vector3(0.0f, 0.0f, 0.0f),
+                                                                        rotation.conjugate(), Vector3(1.0f, 1.0f, 1.0f));
+    return inverseRotation * world;
+}
+
+// Blends the stretches of two worlds, with their blended translation in the last column,
+// and returns the rotations left to slerp
+Matrix3x4 blendStretches(const Matrix3x4& previous, const Matrix3x4& current, float alpha,
+                         Quaternion& previousRotation, Quaternion& currentRotation) {
+    Matrix3x4 stretch = Matrix3x4::lerp(removeRotation(previous, previousRotation),
+                                        removeRotation(current, currentRotation), alpha);
+    for (int row = 0; row < 3; ++row) {
+        stretch(row, 3) = previous(row, 3) + (current(row, 3) - previous(row, 3)) * alpha;
+    }
+    return stretch;
+}
+
+// The product rotation * stretch carries the rotated translation; puts the blended one back
+void restoreTranslation(Matrix3x4& world, const Matrix3x4& stretch) {
+    for (int row = 0; row < 3; ++row) {
+        world(row, 3) = stretch(row, 3);
+    }
+}
+
+} // namespace
+
+void TransformComponentManager::append(Entity entity, const Vector3& position, const Quaternion& rotation,
+                                       const Vector3& scale) {
+    // World transform starts as identity until the first update, with no previous one and
+    // no parent, children or siblings. The node joins the order as a root.
+    constexpr size_t none = std::numeric_limits<size_t>::max();
+    entitySet.insert(entity);
+    data.pushBack(position, rotation, scale, Matrix3x4::identity(), Matrix3x4::identity(), bufferFrame - 1,
+                  none, none, none, none, none, none, Created);
+    if (!hierarchyDirty) {
+        insertIntoOrder(entitySet.size() - 1, 0);
+    }
+    dirtyNodes.push_back(entity);
+    notifyConstruct(entity);
+}
+
+void TransformComponentManager::create(Entity entity, const Vector3& position, const Quaternion& rotation,
+                                       const Vector3& scale) {
+    if (entitySet.contains(entity)) {
+        throw std::runtime_error("Entity already has a transform component.");
+    }
+    append(entity, position, rotation, scale);
+}
+
 void TransformComponentManager::create(Entity entity, const Matrix4x4& localTransform) {
-    size_t index = data.entities.size();
+    Vector3 position, scale;
+    Quaternion rotation;
+    decompose(localTransform, position, rotation, scale);
+    create(entity, position, rotation, scale);
+}
 
-    data.entities.push_back(entity);
-    data.localTransforms.push_back(localTransform);
-    data.worldTransforms.push_back(Matrix4x4::identity()); // Initialize with identity matrix
-    data.parents.push_back(std::numeric_limits<size_t>::max()); // No parent initially
-    data.firstChildren.push_back(std::numeric_limits<size_t>::max()); // No children initially
-    data.nextSiblings.push_back(std::numeric_limits<size_t>::max()); // No siblings initially
+void TransformComponentManager::createBatch(std::span<const Entity> entities,
+                                            std::span<const Matrix4x4> localTransforms) {
+    if (localTransforms.size() != entities.size()) {
+        throw std::runtime_error("createBatch needs one local transform per entity.");
+    }
+    checkBatchEntities(entities, "Entity already has a transform component.");
+
+    // One allocation per array for the whole batch
+    reserve(entitySet.size() + entities.size());
+    for (size_t i = 0; i < entities.size(); ++i) {
+        Vector3 position, scale;
+        Quaternion rotation;
+        decompose(localTransforms[i], position, rotation, scale);
+        append(entities[i], position, rotation, scale);
+    }
+}
 
-    entityToIndexMap[entity] = index;
+void TransformComponentManager::reserve(size_t count) {
+    entitySet.reserve(count);
+    data.reserve(count);
+    hierarchyOrder.reserve(count);
 }
 
 void TransformComponentManager::destroy(Entity entity) {
-    auto it = entityToIndexMap.find(entity);
-    if (it != entityToIndexMap.end()) {
-        size_t index = it->second;
-        size_t lastIndex = data.entities.size() - 1;
+    constexpr size_t none = std::numeric_limits<size_t>::max();
+    size_t index = entitySet.indexOf(entity);
+    if (index == SparseSet::npos) {
+        return;
+    }
+
+    // The children become roots: move their subtrees up before the node leaves its level,
+    // so no level empties while the one below it still has nodes. A leaf just leaves.
+    if (!hierarchyDirty) {
+        std::span<const size_t> nextSiblings = data.get<NextSibling>();
+        for (size_t child = data.get<FirstChild>()[index]; child != none && !hierarchyDirty;
+             child = nextSiblings[child]) {
+            relevelSubtree(child, 0);
+        }
+        if (!hierarchyDirty) {
+            removeFromOrder(index);
+        }
+    }
+
+    // Detach from the hierarchy first so no link is left pointing at the freed slot
+    unlink(index);
+    ComponentStorage::destroy(entity);
+}
+
+void TransformComponentManager::destroySubtree(Entity root) {
+    if (!entitySet.contains(root)) {
+        return;
+    }
+
+    // Leaves first: every destroyed node is then childless, so unlinking it is O(1)
+    // and no descendant is orphaned (and marked dirty) only to be destroyed next
+    std::vector<Entity> subtree;
+    collectSubtree(root, subtree);
+    for (auto it = subtree.rbegin(); it != subtree.rend(); ++it) {
+        destroy(*it);
+    }
+}
+
+void TransformComponentManager::collectSubtree(Entity root, std::vector<Entity>& entities) const {
+    constexpr size_t none = std::numeric_limits<size_t>::max();
+    size_t rootIndex = entitySet.indexOf(root);
+    if (rootIndex == SparseSet::npos) {
+        throw std::runtime_error("Entity not found in TransformComponentManager.");
+    }
+
+    std::span<const size_t> firstChildren = data.get<FirstChild>();
+    std::span<const size_t> nextSiblings = data.get<NextSibling>();
+
+    // Depth-first, appending each node when it is popped
+    std::vector<size_t> stack{ rootIndex };
+    while (!stack.empty()) {
+        size_t index = stack.back();
+        stack.pop_back();
+        entities.push_back(entitySet[index]);
+        for (size_t child = firstChildren[index]; child != none; child = nextSiblings[child]) {
+            stack.push_back(child);
+        }
+    }
+}
+
+void TransformComponentManager::attach(size_t child, size_t parent) {
+    constexpr size_t none = std::numeric_limits<size_t>::max();
+    std::span<size_t> lastChildren = data.get<LastChild>();
+
+    // Append after the parent's current last child
+    size_t previous = lastChildren[parent];
+    data.get<Parent>()[child] = parent;
+    data.get<PrevSibling>()[child] = previous;
+    data.get<NextSibling>()[child] = none;
+    if (previous != none) {
+        data.get<NextSibling>()[previous] = child;
+    } else {
+        data.get<FirstChild>()[parent] = child;
+    }
+    lastChildren[parent] = child;
+}
+
+void TransformComponentManager::detach(size_t index) {
+    constexpr size_t none = std::numeric_limits<size_t>::max();
+    std::span<size_t> parents = data.get<Parent>();
+    std::span<size_t> nextSiblings = data.get<NextSibling>();
+    std::span<size_t> prevSiblings = data.get<PrevSibling>();
+
+    size_t parentIndex = parents[index];
+    if (parentIndex == none) {
+        return;
+    }
+
+    // Bridge the neighbours, or move the parent's ends when the node was one of them
+    size_t previous = prevSiblings[index];
+    size_t next = nextSiblings[index];
+    if (previous != none) {
+        nextSiblings[previous] = next;
+    } else {
+        data.get<FirstChild>()[parentIndex] = next;
+    }
+    if (next != none) {
+        prevSiblings[next] = previous;
+    } else {
+        data.get<LastChild>()[parentIndex] = previous;
+    }
+
+    parents[index] = none;
+    nextSiblings[index] = none;
+    prevSiblings[index] = none;
+}
+
+void TransformComponentManager::unlink(size_t index) {
+    constexpr size_t none = std::numeric_limits<size_t>::max();
+    std::span<size_t> parents = data.get<Parent>();
+    std::span<size_t> firstChildren = data.get<FirstChild>();
+    std::span<size_t> nextSiblings = data.get<NextSibling>();
+    std::span<size_t> prevSiblings = data.get<PrevSibling>();
+
+    detach(index);
 
-        // Move last element to the current index
-        data.entities[index] = data.entities[lastIndex];
-        data.localTransforms[index] = data.localTransforms[lastIndex];
-        data.worldTransforms[index] = data.worldTransforms[lastIndex];
-        data.parents[index] = data.parents[lastIndex];
-        data.firstChildren[index] = data.firstChildren[lastIndex];
-        data.nextSiblings[index] = data.nextSiblings[lastIndex];
+    // Its children become roots, so their world transforms change
+    size_t childIndex = firstChildren[index];
+    while (childIndex != none) {
+        size_t nextIndex = nextSiblings[childIndex];
+        parents[childIndex] = none;
+        nextSiblings[childIndex] = none;
+        prevSiblings[childIndex] = none;
+        markDirty(childIndex);
+        childIndex = nextIndex;
+    }
+
+    firstChildren[index] = none;
+    data.get<LastChild>()[index] = none;
+}
 
-        // Update the map with the new index
-        entityToIndexMap[data.entities[index]] = index;
+void TransformComponentManager::swapData(size_t a, size_t b) {
+    constexpr size_t none = std::numeric_limits<size_t>::max();
+    std::span<size_t> parents = data.get<Parent>();
+    std::span<size_t> firstChildren = data.get<FirstChild>();
+    std::span<size_t> lastChildren = data.get<LastChild>();
+    std::span<size_t> nextSiblings = data.get<NextSibling>();
+    std::span<size_t> prevSiblings = data.get<PrevSibling>();
 
-        // Remove the last element
-        data.entities.pop_back();
-        data.localTransforms.pop_back();
-        data.worldTransforms.pop_back();
-        data.parents.pop_back();
-        data.firstChildren.pop_back();
-        data.nextSiblings.pop_back();
+    auto remap = [a, b](size_t& link) {
+        if (link == a) {
+            link = b;
+        } else if (link == b) {
+            link = a;
+        }
+    };
 
-        // Remove the entity from the map
-        entityToIndexMap.erase(it);
+    // Every link that refers to slot a or b is remapped before the rows are swapped.
+    // Gather the ones held by parents and siblings first, since remapping the children's
+    // parent links below changes what parents[b] reads when b is a's child. Each link is
+    // gathered once: no two of these can be the same field.
+    std::array<size_t*, 8> links{};
+    size_t linkCount = 0;
+    for (size_t slot : { a, b }) {
+        size_t parentIndex = parents[slot];
+        if (parentIndex != none) {
+            if (firstChildren[parentIndex] == slot) {
+                links[linkCount++] = &firstChildren[parentIndex];
+            }
+            if (lastChildren[parentIndex] == slot) {
+                links[linkCount++] = &lastChildren[parentIndex];
+            }
+        }
+        if (prevSiblings[slot] != none) {
+            links[linkCount++] = &nextSiblings[prevSiblings[slot]];
+        }
+        if (nextSiblings[slot] != none) {
+            links[linkCount++] = &prevSiblings[nextSiblings[slot]];
+        }
     }
+    for (size_t slot : { a, b }) {
+        for (size_t child = firstChildren[slot]; child != none; child = nextSiblings[child]) {
+            remap(parents[child]);
+        }
+    }
+    for (size_t i = 0; i < linkCount; ++i) {
+        remap(*links[i]);
+    }
+
+    data.swapElements(a, b);
+
+    // The order positions moved with the rows; point the order entries at the new slots
+    // (a node being destroyed has already left the order)
+    if (!hierarchyDirty) {
+        std::span<const size_t> orderPositions = data.get<OrderPosition>();
+        for (size_t slot : { a, b }) {
+            if (orderPositions[slot] != none) {
+                hierarchyOrder[orderPositions[slot]] = slot;
+            }
+        }
+    }
+}
+
+void TransformComponentManager::popData() {
+    data.popBack();
 }
 
 Matrix4x4 TransformComponentManager::getWorldTransform(Entity entity) const {
-    auto it = entityToIndexMap.find(entity);
-    if (it != entityToIndexMap.end()) {
-        return data.worldTransforms[it->second];
+    size_t index = entitySet.indexOf(entity);
+    if (index != SparseSet::npos) {
+        return data.get<WorldTransform>()[index].toMatrix4x4();
     }
     throw std::runtime_error("Entity not found in TransformComponentManager.");
 }
 
+Matrix4x4 TransformComponentManager::getInterpolatedWorldTransform(Entity entity, float alpha) const {
+    size_t index = entitySet.indexOf(entity);
+    if (index == SparseSet::npos) {
+        throw std::runtime_error("Entity not found in TransformComponentManager.");
+    }
+    return getInterpolatedWorldTransformAt(index, alpha).toMatrix4x4();
+}
+
+Matrix3x4 TransformComponentManager::getInterpolatedWorldTransformAt(size_t index, float alpha) const {
+    const Matrix3x4& previous = getPreviousWorldTransformAt(index);
+    const Matrix3x4& current = getWorldTransformAt(index);
+    // Most nodes did not move, and the renderer's default alpha is 1; neither needs a blend
+    if (alpha >= 1.0f || previous == current) {
+        return current;
+    }
+    if (alpha <= 0.0f) {
+        return previous;
+    }
+
+    // Blending the matrices element-wise would shrink the basis partway through a turn.
+    // Split each world into rotation * stretch instead: the rotations are slerped, and the
+    // stretches and translations blended.
+    Quaternion rotations[2];
+    const Matrix3x4 stretch = blendStretches(previous, current, alpha, rotations[0], rotations[1]);
+    Matrix3x4 result = Matrix3x4::fromTranslationRotationScale(Vector3(0.0f, 0.0f, 0.0f),
+                                                               Quaternion::slerp(rotations[0], rotations[1], alpha),
+                                                               Vector3(1.0f, 1.0f, 1.0f)) *
+                       stretch;
+    restoreTranslation(result, stretch);
+    return result;
+}
+
+void TransformComponentManager::getInterpolatedWorldTransformsAt(std::span<const size_t> indices, float alpha,
+                                                                 std::span<Matrix3x4> out,
+                                                                 InterpolationScratch& scratch) const {
+    if (out.size() != indices.size()) {
+        throw std::runtime_error("Interpolated transform output does not match the index count.");
+    }
+    if (alpha >= 1.0f || alpha <= 0.0f) {
+        for (size_t i = 0; i < indices.size(); ++i) {
+            out[i] = alpha >= 1.0f ? getWorldTransformAt(indices[i]) : getPreviousWorldTransformAt(indices[i]);
+        }
+        return;
+    }
+
+    // Nodes that did not move are done here; the rest are split as in the single form,
+    // and their rotations slerped, rebuilt and applied in batches
+    scratch.moving.clear();
+    scratch.previousRotations.clear();
+    scratch.currentRotations.clear();
+    scratch.stretches.clear();
+    for (size_t i = 0; i < indices.size(); ++i) {
+        const Matrix3x4& previous = getPreviousWorldTransformAt(indices[i]);
+        const Matrix3x4& current = getWorldTransformAt(indices[i]);
+        if (previous == current) {
+            out[i] = current;
+            continue;
+        }
+        Quaternion previousRotation, currentRotation;
+        scratch.stretches.push_back(blendStretches(previous, current, alpha, previousRotation, currentRotation));
+        scratch.previousRotations.push_back(previousRotation);
+        scratch.currentRotations.push_back(currentRotation);
+        scratch.moving.push_back(i);
+    }
+
+    const size_t count = scratch.moving.size();
+    scratch.rotations.resize(count);
+    Quaternion::slerpArrays(scratch.previousRotations.data(), scratch.currentRotations.data(), alpha,
+                            scratch.previousRotations.data(), count);
+    Quaternion::toRotationMatrices(scratch.previousRotations.data(), scratch.rotations.data(), count);
+    Matrix3x4::multiplyArrays(scratch.rotations.data(), scratch.stretches.data(), scratch.rotations.data(), count);
+    for (size_t k = 0; k < count; ++k) {
+        Matrix3x4& world = out[scratch.moving[k]];
+        world = scratch.rotations[k];
+        restoreTranslation(world, scratch.stretches[k]);
+    }
+}
+
+void TransformComponentManager::swapTransformBuffers() {
+    // Every previous transform is now out of date, which is all a swap has to do. When the
+    // counter wraps, stale frame stamps could match again; equal buffers make that harmless.
+    if (++bufferFrame == 0) {
+        std::span<const Matrix3x4> worldTransforms = data.get<WorldTransform>();
+        std::copy(worldTransforms.begin(), worldTransforms.end(), data.get<PreviousWorldTransform>().begin());
+    }
+}
+
+void TransformComponentManager::setBoundsManager(BoundsComponentManager* manager) {
+    if (boundsManager != nullptr) {
+        boundsManager->removeListener(this);
+    }
+    boundsManager = manager;
+    if (boundsManager == nullptr) {
+        return;
+    }
+
+    // Bounds created later are placed when they are created, existing ones right away.
+    // Nothing here refers to bounds once they are gone, so removals need no listener.
+    boundsManager->addListener({ this, &TransformComponentManager::onBoundsConstruct, nullptr });
+    for (const Entity& entity : boundsManager->getEntitySet().getEntities()) {
+        onBoundsConstruct(this, entity);
+    }
+}
+
+void TransformComponentManager::onBoundsConstruct(void* context, Entity entity) {
+    TransformComponentManager& transforms = *static_cast<TransformComponentManager*>(context);
+    size_t index = transforms.entitySet.indexOf(entity);
+    if (index == SparseSet::npos) {
+        return; // Placed once the entity gets a transform
+    }
+
+    // A pending update that moves the transform refreshes the bounds again
+    size_t boundsIndex = transforms.boundsManager->getEntitySet().indexOf(entity);
+    transforms.boundsManager->updateWorldBounds(boundsIndex, transforms.data.get<WorldTransform>()[index]);
+}
+
 void TransformComponentManager::setLocalTransform(Entity entity, const Matrix4x4& localTransform) {
-    auto it = entityToIndexMap.find(entity);
-    if (it != entityToIndexMap.end()) {
-        data.localTransforms[it->second] = localTransform;
+    size_t index = entitySet.indexOf(entity);
+    if (index != SparseSet::npos) {
+        decompose(localTransform, data.get<Position>()[index], data.get<Rotation>()[index], data.get<Scale>()[index]);
+        entitySet.markChanged(index);
+        markDirty(index);
     } else {
         throw std::runtime_error("Entity not found in TransformComponentManager.");
     }
 }
 
-void TransformComponentManager::updateTransforms() {
-    for (size_t i = 0; i < data.entities.size(); ++i) {
-        size_t parentIndex = data.parents[i];
-        if (parentIndex != std::numeric_limits<size_t>::max()) {
-            data.worldTransforms[i] = data.localTransforms[i] * data.worldTransforms[parentIndex];
-        } else {
-            data.worldTransforms[i] = data.localTransforms[i];
+void TransformComponentManager::setPosition(Entity entity, const Vector3& position) {
+    size_t index = entitySet.indexOf(entity);
+    if (index == SparseSet::npos) {
+        throw std::runtime_error("Entity not found in TransformComponentManager.");
+    }
+    data.get<Position>()[index] = position;
+    entitySet.markChanged(index);
+    markDirty(index);
+}
+
+void TransformComponentManager::setRotation(Entity entity, const Quaternion& rotation) {
+    size_t index = entitySet.indexOf(entity);
+    if (index == SparseSet::npos) {
+        throw std::runtime_error("Entity not found in TransformComponentManager.");
+    }
+    data.get<Rotation>()[index] = rotation;
+    entitySet.markChanged(index);
+    markDirty(index);
+}
+
+void TransformComponentManager::setScale(Entity entity, const Vector3& scale) {
+    size_t index = entitySet.indexOf(entity);
+    if (index == SparseSet::npos) {
+        throw std::runtime_error("Entity not found in TransformComponentManager.");
+    }
+    data.get<Scale>()[index] = scale;
+    entitySet.markChanged(index);
+    markDirty(index);
+}
+
+Vector3 TransformComponentManager::getPosition(Entity entity) const {
+    size_t index = entitySet.indexOf(entity);
+    if (index == SparseSet::npos) {
+        throw std::runtime_error("Entity not found in TransformComponentManager.");
+    }
+    return data.get<Position>()[index];
+}
+
+Quaternion TransformComponentManager::getRotation(Entity entity) const {
+    size_t index = entitySet.indexOf(entity);
+    if (index == SparseSet::npos) {
+        throw std::runtime_error("Entity not found in TransformComponentManager.");
+    }
+    return data.get<Rotation>()[index];
+}
+
+Vector3 TransformComponentManager::getScale(Entity entity) const {
+    size_t index = entitySet.indexOf(entity);
+    if (index == SparseSet::npos) {
+        throw std::runtime_error("Entity not found in TransformComponentManager.");
+    }
+    return data.get<Scale>()[index];
+}
+
+void TransformComponentManager::rebuildHierarchyOrder() {
+    constexpr size_t none = std::numeric_limits<size_t>::max();
+    std::span<const size_t> parents = data.get<Parent>();
+    std::span<const size_t> firstChildren = data.get<FirstChild>();
+    std::span<const size_t> nextSiblings = data.get<NextSibling>();
+    std::span<size_t> orderPositions = data.get<OrderPosition>();
+
+    // Breadth-first from the roots, one depth level at a time
+    hierarchyOrder.clear();
+    levelStarts.clear();
+    for (size_t slot = 0; slot < entitySet.size(); ++slot) {
+        if (parents[slot] == none) {
+            hierarchyOrder.push_back(slot);
+        }
+    }
+    size_t levelBegin = 0;
+    while (levelBegin < hierarchyOrder.size()) {
+        size_t levelEnd = hierarchyOrder.size();
+        levelStarts.push_back(levelBegin);
+        for (size_t position = levelBegin; position < levelEnd; ++position) {
+            size_t slot = hierarchyOrder[position];
+            orderPositions[slot] = position;
+            for (size_t child = firstChildren[slot]; child != none; child = nextSiblings[child]) {
+                hierarchyOrder.push_back(child);
+            }
         }
+        levelBegin = levelEnd;
+    }
+    levelStarts.push_back(hierarchyOrder.size());
+    hierarchyDirty = false;
+}
+
+size_t TransformComponentManager::levelOf(size_t index) const {
+    size_t position = data.get<OrderPosition>()[index];
+    return std::upper_bound(levelStarts.begin(), levelStarts.end(), position) - levelStarts.begin() - 1;
+}
+
+void TransformComponentManager::insertIntoOrder(size_t index, size_t level) {
+    std::span<size_t> orderPositions = data.get<OrderPosition>();
+    if (level + 1 == levelStarts.size()) {
+        levelStarts.push_back(levelStarts.back()); // First node of a new deepest level
+    }
 
-        // Update children recursively (could be improved with a non-recursive implementation)
-        size_t childIndex = data.firstChildren[i];
-        while (childIndex != std::numeric_limits<size_t>::max()) {
-            data.worldTransforms[childIndex] = data.localTransforms[childIndex] * data.worldTransforms[i];
-            childIndex = data.nextSiblings[childIndex];
+    // Open a hole at the end and walk it up to the end of the target level: each deeper
+    // level moves its first node to its end, one past where it ended before
+    size_t hole = hierarchyOrder.size();
+    hierarchyOrder.push_back(index);
+    for (size_t deeper = levelStarts.size() - 2; deeper > level; --deeper) {
+        size_t first = levelStarts[deeper];
+        hierarchyOrder[hole] = hierarchyOrder[first];
+        orderPositions[hierarchyOrder[hole]] = hole;
+        hole = first;
+    }
+    hierarchyOrder[hole] = index;
+    orderPositions[index] = hole;
+    for (size_t deeper = level + 1; deeper < levelStarts.size(); ++deeper) {
+        levelStarts[deeper]++;
+    }
+}
+
+void TransformComponentManager::removeFromOrder(size_t index) {
+    std::span<size_t> orderPositions = data.get<OrderPosition>();
+
+    // Fill the hole with the last node of its level, which leaves the hole at the start
+    // of the next level, and so on down to the end of the order
+    size_t hole = orderPositions[index];
+    for (size_t level = levelOf(index); level + 1 < levelStarts.size(); ++level) {
+        size_t last = --levelStarts[level + 1];
+        if (last != hole) {
+            hierarchyOrder[hole] = hierarchyOrder[last];
+            orderPositions[hierarchyOrder[hole]] = hole;
         }
+        hole = last;
+    }
+    hierarchyOrder.pop_back();
+    orderPositions[index] = std::numeric_limits<size_t>::max();
+
+    // Only a childless node can leave, so only the deepest level can end up empty
+    if (levelStarts.size() > 1 && levelStarts[levelStarts.size() - 2] == levelStarts.back()) {
+        levelStarts.pop_back();
     }
 }
 
-void TransformComponentManager::setParent(Entity child, Entity parent) {
-    size_t childIndex = entityToIndexMap[child];
-    size_t parentIndex = entityToIndexMap[parent];
+void TransformComponentManager::relevelSubtree(size_t root, size_t rootLevel) {
+    constexpr size_t none = std::numeric_limits<size_t>::max();
+    std::span<const size_t> firstChildren = data.get<FirstChild>();
+    std::span<const size_t> nextSiblings = data.get<NextSibling>();
+
+    // Same depth as before: the parent is still a level above, so nothing moves
+    if (levelOf(root) == rootLevel) {
+        return;
+    }
+    if (firstChildren[root] == none) {
+        removeFromOrder(root);
+        insertIntoOrder(root, rootLevel);
+        return;
+    }
+
+    // Breadth-first, so every parent is listed before its children
+    std::vector<size_t> subtree{ root };
+    for (size_t i = 0; i < subtree.size(); ++i) {
+        for (size_t child = firstChildren[subtree[i]]; child != none; child = nextSiblings[child]) {
+            subtree.push_back(child);
+        }
+    }
+
+    // Moving a node shifts up to one node per level; past the size of the order, one
+    // rebuild is cheaper
+    if (subtree.size() * (levelStarts.size() - 1) > entitySet.size()) {
+        hierarchyDirty = true;
+        return;
+    }
+
+    // Deepest first, so no level empties while a deeper one still has nodes; then back
+    // in, each node one level below its parent's new level
+    std::span<const size_t> parents = data.get<Parent>();
+    for (auto it = subtree.rbegin(); it != subtree.rend(); ++it) {
+        removeFromOrder(*it);
+    }
+    insertIntoOrder(root, rootLevel);
+    for (size_t i = 1; i < subtree.size(); ++i) {
+        insertIntoOrder(subtree[i], levelOf(parents[subtree[i]]) + 1);
+    }
+}
+
+void TransformComponentManager::markDirty(size_t index) {
+    uint8_t& dirty = data.get<Dirty>()[index];
+    if (!dirty) {
+        dirty = 1;
+        dirtyNodes.push_back(entitySet[index]);
+    }
+}
 
-    // Set the parent of the child
-    data.parents[childIndex] = parentIndex;
+Matrix3x4 TransformComponentManager::computeLocal(size_t index) const {
+    return Matrix3x4::fromTranslationRotationScale(data.get<Position>()[index], data.get<Rotation>()[index],
+                                                   data.get<Scale>()[index]);
+}
+
+void TransformComponentManager::updateBatch(std::span<const size_t> slots, UpdateScratch& scratch) {
+    constexpr size_t none = std::numeric_limits<size_t>::max();
+    constexpr size_t BatchSize = 64;
+    std::span<const size_t> parents = data.get<Parent>();
+    std::span<const Matrix3x4> worldTransforms = data.get<WorldTransform>();
+
+    // Gather parent worlds and locals, multiply them in one SIMD call, then store. Roots
+    // get an identity parent; their products are replaced by the locals.
+    if (scratch.worlds.size() < BatchSize) {
+        scratch.parentWorlds.resize(BatchSize);
+        scratch.locals.resize(BatchSize);
+        scratch.worlds.resize(BatchSize);
+    }
+    for (size_t batchBegin = 0; batchBegin < slots.size(); batchBegin += BatchSize) {
+        const size_t count = std::min(BatchSize, slots.size() - batchBegin);
+        for (size_t i = 0; i < count; ++i) {
+            size_t slot = slots[batchBegin + i];
+            size_t parentIndex = parents[slot];
+            scratch.locals[i] = computeLocal(slot);
+            scratch.parentWorlds[i] = parentIndex != none ? worldTransforms[parentIndex] : Matrix3x4::identity();
+        }
+        Matrix3x4::multiplyArrays(scratch.parentWorlds.data(), scratch.locals.data(), scratch.worlds.data(), count);
+        for (size_t i = 0; i < count; ++i) {
+            size_t slot = slots[batchBegin + i];
+            storeWorld(slot, parents[slot] != none ? scratch.worlds[i] : scratch.locals[i]);
+        }
+    }
+}
+
+void TransformComponentManager::storeWorld(size_t index, const Matrix3x4& world) {
+    std::span<Matrix3x4> worldTransforms = data.get<WorldTransform>();
+
+    // Only stamp a transform as changed when its world matrix actually moved. The first
+    // move in a frame keeps the old matrix as the previous one; a new node has none.
+    uint8_t& dirty = data.get<Dirty>()[index];
+    if (worldTransforms[index] != world || dirty == Created) {
+        uint32_t& previousFrame = data.get<PreviousFrame>()[index];
+        if (previousFrame != bufferFrame && dirty != Created) {
+            data.get<PreviousWorldTransform>()[index] = worldTransforms[index];
+            previousFrame = bufferFrame;
+        }
+        worldTransforms[index] = world;
+        entitySet.markChanged(index);
+
+        if (boundsManager != nullptr) {
+            size_t boundsIndex = boundsManager->getEntitySet().indexOf(entitySet[index]);
+            if (boundsIndex != SparseSet::npos) {
+                boundsManager->updateWorldBounds(boundsIndex, world);
+            }
+        }
+    }
+    dirty = 0;
+}
+
+size_t TransformComponentManager::updateSubtree(size_t root, UpdateScratch& scratch) {
+    constexpr size_t none = std::numeric_limits<size_t>::max();
+    std::span<const size_t> firstChildren = data.get<FirstChild>();
+    std::span<const size_t> nextSiblings = data.get<NextSibling>();
+
+    // Breadth-first, one depth at a time, so each depth is a batch for the kernel
+    std::vector<size_t>& slots = scratch.slots;
+    slots.clear();
+    slots.push_back(root);
+    size_t levelBegin = 0;
+    while (levelBegin < slots.size()) {
+        const size_t levelEnd = slots.size();
+        updateBatch(std::span<const size_t>(slots).subspan(levelBegin, levelEnd - levelBegin), scratch);
+        for (size_t position = levelBegin; position < levelEnd; ++position) {
+            for (size_t child = firstChildren[slots[position]]; child != none; child = nextSiblings[child]) {
+                slots.push_back(child);
+            }
+        }
+        levelBegin = levelEnd;
+    }
+    return slots.size();
+}
+
+size_t TransformComponentManager::updateTransforms() {
+    return update(nullptr);
+}
+
+size_t TransformComponentManager::updateTransforms(ThreadPool& threadPool) {
+    return update(threadPool.getThreadCount() > 0 ? &threadPool : nullptr);
+}
+
+size_t TransformComponentManager::update(ThreadPool* threadPool) {
+    if (dirtyNodes.empty()) {
+        return 0;
+    }
+
+    size_t touched = dirtyNodes.size() * FullUpdateRatio >= entitySet.size()
+                         ? updateAll(threadPool)
+                         : updateDirtySubtrees(threadPool);
+    dirtyNodes.clear();
+    return touched;
+}
+
+size_t TransformComponentManager::updateAll(ThreadPool* threadPool) {
+    if (hierarchyDirty) {
+        rebuildHierarchyOrder();
+    }
 
-    // Link the child into the parent's children list
-    if (data.firstChildren[parentIndex] == std::numeric_limits<size_t>::max()) {
-        // If the parent has no children, this child becomes the first child
-        data.firstChildren[parentIndex] = childIndex;
+    // Level by level: nodes within a level only read the level above, so each level can
+    // be multiplied in batches
+    if (threadPool == nullptr || entitySet.size() < ParallelThreshold) {
+        for (size_t level = 0; level + 1 < levelStarts.size(); ++level) {
+            updateBatch(std::span<const size_t>(hierarchyOrder).subspan(levelStarts[level],
+                                                                        levelStarts[level + 1] - levelStarts[level]),
+                        updateScratch);
+        }
+        return hierarchyOrder.size();
+    }
+
+    // Enough roots to keep every thread busy: each task takes whole root subtrees, so no
+    // synchronization is needed between depths. Otherwise split each level across threads.
+    const size_t threadCount = threadPool->getThreadCount() + 1;
+    const size_t rootCount = levelStarts.size() > 1 ? levelStarts[1] - levelStarts[0] : 0;
+    if (rootCount >= threadCount * 8) {
+        threadPool->parallelFor(0, rootCount, rootCount / (threadCount * 8), [this](size_t begin, size_t end) {
+            UpdateScratch scratch;
+            for (size_t position = begin; position < end; ++position) {
+                updateSubtree(hierarchyOrder[position], scratch);
+            }
+        });
     } else {
-        // Otherwise, find the last sibling and link this child after it
-        size_t siblingIndex = data.firstChildren[parentIndex];
-        while (data.nextSiblings[siblingIndex] != std::numeric_limits<size_t>::max()) {
-            siblingIndex = data.nextSiblings[siblingIndex];
+        const size_t grainSize = ParallelThreshold / 4;
+        for (size_t level = 0; level + 1 < levelStarts.size(); ++level) {
+            threadPool->parallelFor(levelStarts[level], levelStarts[level + 1], grainSize,
+                                    [this](size_t begin, size_t end) {
+                UpdateScratch scratch;
+                updateBatch(std::span<const size_t>(hierarchyOrder).subspan(begin, end - begin), scratch);
+            });
+        }
+    }
+    return hierarchyOrder.size();
+}
+
+size_t TransformComponentManager::updateDirtySubtrees(ThreadPool* threadPool) {
+    constexpr size_t none = std::numeric_limits<size_t>::max();
+    std::span<const size_t> parents = data.get<Parent>();
+    std::span<const uint8_t> dirtyFlags = data.get<Dirty>();
+
+    // Keep only the dirty nodes without a dirty ancestor; the others are rebuilt as part
+    // of that ancestor's subtree. Flags are not cleared yet, so every check sees them all.
+    std::vector<size_t> roots;
+    roots.reserve(dirtyNodes.size());
+    for (const Entity& entity : dirtyNodes) {
+        size_t index = entitySet.indexOf(entity);
+        if (index == SparseSet::npos) {
+            continue; // Destroyed since it was marked
+        }
+        bool covered = false;
+        for (size_t ancestor = parents[index]; ancestor != none && !covered; ancestor = parents[ancestor]) {
+            covered = dirtyFlags[ancestor] != 0;
+        }
+        if (!covered) {
+            roots.push_back(index);
+        }
+    }
+
+    // A node marked, destroyed and created again is listed twice
+    std::sort(roots.begin(), roots.end());
+    roots.erase(std::unique(roots.begin(), roots.end()), roots.end());
+
+    // Every dirty node is touched at least once, which makes it a lower bound on the work
+    if (threadPool == nullptr || dirtyNodes.size() < ParallelThreshold || roots.size() < 2) {
+        size_t touched = 0;
+        for (size_t root : roots) {
+            touched += updateSubtree(root, updateScratch);
+        }
+        return touched;
+    }
+
+    // Subtrees of distinct roots are disjoint, so they can be rebuilt concurrently
+    std::atomic<size_t> touched{0};
+    const size_t grainSize = std::max<size_t>(1, roots.size() / ((threadPool->getThreadCount() + 1) * 8));
+    threadPool->parallelFor(0, roots.size(), grainSize, [&](size_t begin, size_t end) {
+        UpdateScratch scratch;
+        size_t count = 0;
+        for (size_t i = begin; i < end; ++i) {
+            count += updateSubtree(roots[i], scratch);
         }
-        data.nextSiblings[siblingIndex] = childIndex;
+        touched.fetch_add(count, std::memory_order_relaxed);
+    });
+    return touched.load(std::memory_order_relaxed);
+}
+
+void TransformComponentManager::setParent(Entity child, Entity parent) {
+    constexpr size_t none = std::numeric_limits<size_t>::max();
+    size_t childIndex = entitySet.indexOf(child);
+    size_t parentIndex = entitySet.indexOf(parent);
+    if (childIndex == SparseSet::npos || parentIndex == SparseSet::npos) {
+        throw std::runtime_error("Entity not found in TransformComponentManager.");
     }
 
-    // Initialize the child's next sibling as invalid
-    data.nextSiblings[childIndex] = std::numeric_limits<size_t>::max();
+    // Parenting a node under its own subtree would make a cycle
+    std::span<const size_t> parents = data.get<Parent>();
+    for (size_t ancestor = parentIndex; ancestor != none; ancestor = parents[ancestor]) {
+        if (ancestor == childIndex) {
+            throw std::runtime_error("Cannot parent a transform to itself or one of its descendants.");
+        }
+    }
+
+    detach(childIndex);
+    attach(childIndex, parentIndex);
+    markDirty(childIndex);
+    if (!hierarchyDirty) {
+        relevelSubtree(childIndex, levelOf(parentIndex) + 1);
+    }
 }
 
-bool TransformComponentManager::isValid(Entity entity) const {
-    return entityToIndexMap.find(entity) != entityToIndexMap.end();
+void TransformComponentManager::removeParent(Entity child) {
+    size_t childIndex = entitySet.indexOf(child);
+    if (childIndex == SparseSet::npos) {
+        throw std::runtime_error("Entity not found in TransformComponentManager.");
+    }
+    if (data.get<Parent>()[childIndex] == std::numeric_limits<size_t>::max()) {
+        return;
+    }
+
+    detach(childIndex);
+    markDirty(childIndex);
+    if (!hierarchyDirty) {
+        relevelSubtree(childIndex, 0);
+    }
 }
 
 }
@@ -119,5 +926,5 @@ create:
 Assign a new transform component to the input entity, and use the input local transform matrix
 to record this component's position in the world (world transform is set to identity initially).
 Because we keep data tightly packed, the entity's index is not the actual index to get its component,
-instead we have a map from an entity struct to the index that retrieves the component data.
+instead the SparseSet maps an entity's index to the dense slot that retrieves the component data.
 */
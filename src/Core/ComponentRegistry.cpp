@@ -0,0 +1,36 @@
+#include <virealis/Core/ComponentRegistry.hpp>
+#include <bit>
+
+namespace virealis {
+
+void ComponentRegistry::destroyAll(Entity entity) {
+    // Copy the mask: each destroy clears its own bit through the listener
+    ComponentMask mask = getMask(entity);
+    while (mask != 0) {
+        Pool& pool = pools[std::countr_zero(mask)];
+        pool.destroy(*pool.storage, entity);
+        mask &= mask - 1;
+    }
+}
+
+void ComponentRegistry::setCurrentTick(uint32_t tick) {
+    for (size_t i = 0; i < poolCount; ++i) {
+        pools[i].storage->setCurrentTick(tick);
+    }
+}
+
+void ComponentRegistry::onConstruct(void* context, Entity entity) {
+    Pool& pool = *static_cast<Pool*>(context);
+    std::vector<ComponentMask>& masks = pool.registry->masks;
+    if (entity.index >= masks.size()) {
+        masks.resize(entity.index + 1, 0);
+    }
+    masks[entity.index] |= pool.bit;
+}
+
+void ComponentRegistry::onDestroy(void* context, Entity entity) {
+    Pool& pool = *static_cast<Pool*>(context);
+    pool.registry->masks[entity.index] &= ~pool.bit;
+}
+
+} // namespace virealis
@@ -5,8 +5,8 @@ namespace virealis {
 Entity EntityManager::createEntity() {
     uint32_t index;
     if (!freeIndices.empty()) {
-        index = freeIndices.front();
-        freeIndices.pop();
+        index = freeIndices.back();
+        freeIndices.pop_back();
     } else {
         index = static_cast<uint32_t>(generations.size());
         generations.push_back(0); // start with generation 0
@@ -14,12 +14,18 @@ Entity EntityManager::createEntity() {
     return { index, generations[index] };
 }
 
+void EntityManager::reserve(size_t count) {
+    generations.reserve(count);
+    freeIndices.reserve(count);
+}
+
 void EntityManager::destroyEntity(Entity entity) {
-    const uint32_t index = entity.index;
-    if (index < generations.size()) {
-        generations[index]++;
-        freeIndices.push(index);
+    // Ignore stale handles so an index is never put on the free list twice
+    if (!isValid(entity)) {
+        return;
     }
+    generations[entity.index]++;
+    freeIndices.push_back(entity.index);
 }
 
 bool EntityManager::isValid(Entity entity) const {
@@ -27,4 +33,4 @@ bool EntityManager::isValid(Entity entity) const {
            generations[entity.index] == entity.generation;
 }
 
-} // namespace virealis
\ No newline at end of file
+} // namespace virealis
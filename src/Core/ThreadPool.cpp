@@ -0,0 +1,125 @@
+#include <virealis/Core/ThreadPool.hpp>
+#include <algorithm>
+
+namespace virealis {
+
+namespace {
+    // Lets submit() and getCurrentWorkerIndex() find the calling worker's own queue
+    thread_local const ThreadPool* currentPool = nullptr;
+    thread_local size_t currentWorkerIndex = ThreadPool::npos;
+}
+
+ThreadPool::ThreadPool()
+    : ThreadPool(std::max<size_t>(std::thread::hardware_concurrency(), 1) - 1) {}
+
+ThreadPool::ThreadPool(size_t threadCount) {
+    for (size_t i = 0; i <= threadCount; ++i) {
+        queues.push_back(std::make_unique<TaskQueue>());
+    }
+
+    threads.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; ++i) {
+        threads.emplace_back([this, i] { workerLoop(i); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wakeCondition.notify_all();
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+    size_t worker = getCurrentWorkerIndex();
+    TaskQueue& queue = worker != npos ? *queues[worker] : *queues.back();
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(std::move(task));
+    }
+
+    // Take the sleep lock so a worker can't miss the wakeup between its check and its wait
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        pendingTasks.fetch_add(1, std::memory_order_release);
+    }
+    wakeCondition.notify_one();
+}
+
+bool ThreadPool::runPendingTask() {
+    std::function<void()> task;
+    size_t worker = getCurrentWorkerIndex();
+    bool found = worker != npos ? (popTask(worker, task) || stealTask(worker, task))
+                                : stealTask(queues.size() - 1, task);
+    if (!found) {
+        return false;
+    }
+    task();
+    return true;
+}
+
+size_t ThreadPool::getThreadCount() const {
+    return threads.size();
+}
+
+size_t ThreadPool::getCurrentWorkerIndex() const {
+    return currentPool == this ? currentWorkerIndex : npos;
+}
+
+void ThreadPool::workerLoop(size_t workerIndex) {
+    currentPool = this;
+    currentWorkerIndex = workerIndex;
+
+    std::function<void()> task;
+    while (true) {
+        if (popTask(workerIndex, task) || stealTask(workerIndex, task)) {
+            task();
+            task = nullptr;
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wakeCondition.wait(lock, [this] {
+            return stopping || pendingTasks.load(std::memory_order_acquire) > 0;
+        });
+        if (stopping && pendingTasks.load(std::memory_order_acquire) == 0) {
+            return;
+        }
+    }
+}
+
+bool ThreadPool::popTask(size_t queueIndex, std::function<void()>& task) {
+    TaskQueue& queue = *queues[queueIndex];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) {
+        return false;
+    }
+
+    // Owner takes the newest task
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    pendingTasks.fetch_sub(1, std::memory_order_acq_rel);
+    return true;
+}
+
+bool ThreadPool::stealTask(size_t thiefIndex, std::function<void()>& task) {
+    // Visit every other queue once, starting after our own, taking the oldest task
+    for (size_t offset = 1; offset <= queues.size(); ++offset) {
+        TaskQueue& queue = *queues[(thiefIndex + offset) % queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.tasks.empty()) {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            pendingTasks.fetch_sub(1, std::memory_order_acq_rel);
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace virealis
@@ -0,0 +1,60 @@
+#include <virealis/Math/AABB.hpp>
+#include <virealis/Math/Simd.hpp>
+#include <cmath>
+
+namespace virealis {
+
+AABB AABB::fromPoints(std::span<const Vector3> points) {
+    if (points.empty()) {
+        return AABB();
+    }
+
+    AABB box(points[0], points[0]);
+    for (const Vector3& point : points.subspan(1)) {
+        box.min = Vector3::Min(box.min, point);
+        box.max = Vector3::Max(box.max, point);
+    }
+    return box;
+}
+
+// Transforms the center, and sums each axis's extent over the absolute values of the
+// matrix columns (Arvo's method), instead of transforming all eight corners
+AABB AABB::transformed(const Matrix3x4& transform) const {
+    const Vector3 center = getCenter();
+    const Vector3 extents = getExtents();
+
+#if VIREALIS_SIMD_SSE2
+    // Transposing the three rows (plus a zero row) yields the columns, with the
+    // translation in the last one; every lane then holds one world axis
+    __m128 column0 = _mm_loadu_ps(transform.data());
+    __m128 column1 = _mm_loadu_ps(transform.data() + 4);
+    __m128 column2 = _mm_loadu_ps(transform.data() + 8);
+    __m128 translation = _mm_setzero_ps();
+    _MM_TRANSPOSE4_PS(column0, column1, column2, translation);
+
+    __m128 worldCenter = _mm_add_ps(
+        _mm_add_ps(_mm_mul_ps(column0, _mm_set1_ps(center.x)), _mm_mul_ps(column1, _mm_set1_ps(center.y))),
+        _mm_add_ps(_mm_mul_ps(column2, _mm_set1_ps(center.z)), translation));
+
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    __m128 worldExtents = _mm_add_ps(
+        _mm_add_ps(_mm_mul_ps(_mm_andnot_ps(signMask, column0), _mm_set1_ps(extents.x)),
+                   _mm_mul_ps(_mm_andnot_ps(signMask, column1), _mm_set1_ps(extents.y))),
+        _mm_mul_ps(_mm_andnot_ps(signMask, column2), _mm_set1_ps(extents.z)));
+
+    alignas(16) float minimum[4];
+    alignas(16) float maximum[4];
+    _mm_store_ps(minimum, _mm_sub_ps(worldCenter, worldExtents));
+    _mm_store_ps(maximum, _mm_add_ps(worldCenter, worldExtents));
+    return AABB(Vector3(minimum[0], minimum[1], minimum[2]), Vector3(maximum[0], maximum[1], maximum[2]));
+#else
+    Vector3 worldCenter = transform * center;
+    Vector3 worldExtents(
+        std::abs(transform(0, 0)) * extents.x + std::abs(transform(0, 1)) * extents.y + std::abs(transform(0, 2)) * extents.z,
+        std::abs(transform(1, 0)) * extents.x + std::abs(transform(1, 1)) * extents.y + std::abs(transform(1, 2)) * extents.z,
+        std::abs(transform(2, 0)) * extents.x + std::abs(transform(2, 1)) * extents.y + std::abs(transform(2, 2)) * extents.z);
+    return AABB(worldCenter - worldExtents, worldCenter + worldExtents);
+#endif
+}
+
+} // namespace virealis
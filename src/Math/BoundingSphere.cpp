@@ -0,0 +1,26 @@
+#include <virealis/Math/BoundingSphere.hpp>
+#include <virealis/Math/AABB.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace virealis {
+
+BoundingSphere BoundingSphere::fromPoints(std::span<const Vector3> points) {
+    Vector3 center = AABB::fromPoints(points).getCenter();
+    float radiusSquared = 0.0f;
+    for (const Vector3& point : points) {
+        radiusSquared = std::max(radiusSquared, (point - center).magnitudeSquared());
+    }
+    return BoundingSphere(center, std::sqrt(radiusSquared));
+}
+
+BoundingSphere BoundingSphere::transformed(const Matrix3x4& transform) const {
+    float scaleSquared = 0.0f;
+    for (int col = 0; col < 3; ++col) {
+        Vector3 axis(transform(0, col), transform(1, col), transform(2, col));
+        scaleSquared = std::max(scaleSquared, axis.magnitudeSquared());
+    }
+    return BoundingSphere(transform * center, radius * std::sqrt(scaleSquared));
+}
+
+} // namespace virealis
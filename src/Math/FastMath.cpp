@@ -0,0 +1,749 @@
+#include <virealis/Math/FastMath.hpp>
+#include <virealis/Math/Simd.hpp>
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#if VIREALIS_SIMD_X86
+#include <immintrin.h>
+#endif
+
+/*
+The scalar, SSE and AVX2 paths share the argument reductions and coefficients below, so
+they agree except in the last bit or so (AVX2 fuses multiply-adds). Reductions subtract
+multiples of a constant split into parts whose products with the multiple are exact
+(Cody-Waite), so the reduced argument keeps full precision.
+
+Precise coefficients are the Cephes single-precision ones; Fast coefficients are minimax
+fits of lower degree over the same intervals. Polynomials are listed from the highest
+degree down, for Horner's rule.
+*/
+
+namespace virealis::FastMath {
+
+namespace {
+
+constexpr float Pi = 3.14159265f;
+constexpr float PiOver2 = 1.57079633f;
+constexpr float PiOver4 = 0.785398163f;
+
+// sincos: x = n pi/2 + r with |r| <= pi/4, then sin(r) = r + r z P(z) and cos(r) = Q(z)
+// for z = r^2; n mod 4 picks the quadrant. pi/2 is split in four so that n times each of
+// the first three parts is exact for |n| < 2^13 and the last part leaves an error below
+// 1e-19; three parts would leave 2e-15, costing hundreds of ulps next to multiples of pi.
+constexpr float TwoOverPi = 0.636619772f;
+constexpr float PiOver2A = 1.5703125f;
+constexpr float PiOver2B = 4.8375129699707031e-4f;
+constexpr float PiOver2C = 7.5495336204767227e-8f;
+constexpr float PiOver2D = 2.5633441e-12f;
+// Beyond this n leaves the exact range of the split, so larger arguments (and infinities)
+// go to std::sin and std::cos instead
+constexpr float SincosMax = 8192.0f;
+constexpr float SinPrecise[] = { -1.9515295891e-4f, 8.3321608736e-3f, -1.6666654611e-1f };
+constexpr float SinFast[] = { 8.163281921e-3f, -1.666339038e-1f };
+constexpr float CosPrecise[] = { 2.443315711809948e-5f, -1.388731625493765e-3f, 4.166664568298827e-2f, -0.5f, 1.0f };
+constexpr float CosFast[] = { 4.045845227e-2f, -4.997605571e-1f, 1.0f };
+
+// exp: x = n ln 2 + r with |r| <= ln 2 / 2, then exp(x) = 2^n P(r)
+constexpr float Log2E = 1.44269504f;
+constexpr float Ln2A = 0.693359375f;
+constexpr float Ln2B = -2.12194440e-4f;
+constexpr float ExpMax = 88.7228394f;  // ln(FLT_MAX)
+constexpr float ExpMin = -87.3365448f; // ln(FLT_MIN)
+constexpr float ExpPrecise[] = { 1.9875691500e-4f, 1.3981999507e-3f, 8.3334519073e-3f, 4.1665795894e-2f,
+                                 1.6666665459e-1f, 5.0000001201e-1f, 1.0f, 1.0f };
+constexpr float ExpFast[] = { 4.127768983e-2f, 1.675352713e-1f, 5.000511756e-1f, 1.0f, 1.0f };
+
+// atan2: t = min(|x|, |y|) / max(|x|, |y|), moved within tan(pi/8) by atan(t) = pi/4 +
+// atan((t - 1) / (t + 1)), then atan(t) = t + t z P(z) for z = t^2; the signs and which
+// of |x| and |y| is larger place the angle
+constexpr float TanPiOver8 = 0.414213562f;
+constexpr float AtanPrecise[] = { 8.05374449538e-2f, -1.38776856032e-1f, 1.99777106478e-1f, -3.33329491539e-1f };
+constexpr float AtanFast[] = { 1.703417785e-1f, -3.318337752e-1f };
+
+// acos: acos(x) = pi/2 - asin(x) for |x| <= 1/2, else 2 asin(sqrt((1 - |x|) / 2)) mirrored
+// for negative x; asin(s) = s + s z P(z) for z = s^2
+constexpr float AsinPrecise[] = { 4.2163199048e-2f, 2.4181311049e-2f, 4.5470025998e-2f, 7.4953002686e-2f,
+                                  1.6666752422e-1f };
+constexpr float AsinFast[] = { 9.429868111e-2f, 1.650577587e-1f };
+
+template <Precision P, size_t PreciseSize, size_t FastSize>
+constexpr auto& coefficients(const float (&precise)[PreciseSize], const float (&fast)[FastSize]) {
+    if constexpr (P == Precision::Precise) {
+        return precise;
+    } else {
+        return fast;
+    }
+}
+
+// Scalar
+
+template <size_t N>
+float horner(float x, const float (&c)[N]) {
+    float p = c[0];
+    for (size_t i = 1; i < N; ++i) {
+        p = p * x + c[i];
+    }
+    return p;
+}
+
+// Nearest integer, ties to even like the SIMD conversions; exact for |x| < 2^22, which
+// covers every reduction's domain
+float roundToNearest(float x) {
+    constexpr float Shift = 12582912.0f; // 1.5 * 2^23
+    return (x + Shift) - Shift;
+}
+
+template <Precision P>
+void sincosScalar(float x, float& sine, float& cosine) {
+    if (!(std::fabs(x) <= SincosMax)) { // NaN too, which the quadrant cast could not take
+        sine = std::sin(x);
+        cosine = std::cos(x);
+        return;
+    }
+    const float n = roundToNearest(x * TwoOverPi);
+    const float r = (((x - n * PiOver2A) - n * PiOver2B) - n * PiOver2C) - n * PiOver2D;
+    const float z = r * r;
+    const float s = r + r * z * horner(z, coefficients<P>(SinPrecise, SinFast));
+    const float c = horner(z, coefficients<P>(CosPrecise, CosFast));
+
+    const int quadrant = static_cast<int>(n);
+    sine = quadrant & 1 ? c : s;
+    cosine = quadrant & 1 ? s : c;
+    if (quadrant & 2) {
+        sine = -sine;
+    }
+    if ((quadrant + 1) & 2) {
+        cosine = -cosine;
+    }
+    if (x == 0.0f) {
+        sine = x; // The reduction turns -0 into +0
+    }
+}
+
+template <Precision P>
+float expScalar(float x) {
+    if (!(x >= ExpMin)) {
+        return x < ExpMin ? 0.0f : x; // Underflow or NaN
+    }
+    if (x > ExpMax) {
+        return std::numeric_limits<float>::infinity();
+    }
+    float n = roundToNearest(x * Log2E);
+    const float r = (x - n * Ln2A) - n * Ln2B;
+    float p = horner(r, coefficients<P>(ExpPrecise, ExpFast));
+    // n reaches 128 just below ExpMax, one more than the exponent field holds
+    if (n > 127.0f) {
+        p *= 2.0f;
+        n = 127.0f;
+    }
+    // Up to ExpMax the result is finite, even where the polynomial rounds above FLT_MAX
+    return std::min(p * std::bit_cast<float>((static_cast<int32_t>(n) + 127) << 23),
+                    std::numeric_limits<float>::max());
+}
+
+template <Precision P>
+float rsqrtScalar(float x) {
+#if VIREALIS_SIMD_SSE2
+    if constexpr (P == Precision::Fast) {
+        // The hardware estimate, refined by one Newton-Raphson step as in the SIMD paths;
+        // zero, subnormals and infinity keep the estimate, which is already exact
+        const float estimate = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(x)));
+        if (x < std::numeric_limits<float>::min() || x == std::numeric_limits<float>::infinity()) {
+            return estimate;
+        }
+        return estimate * (1.5f - x * estimate * estimate * 0.5f);
+    }
+#endif
+    return 1.0f / std::sqrt(x);
+}
+
+template <Precision P>
+float atan2Scalar(float y, float x) {
+    if (std::isnan(x) || std::isnan(y)) {
+        return x + y;
+    }
+    const float ax = std::fabs(x);
+    const float ay = std::fabs(y);
+    const float hi = std::max(ax, ay);
+    const float lo = std::min(ax, ay);
+    // Both zero give 0 and both infinite 1, as in std::atan2
+    float t = hi == 0.0f ? 0.0f : (lo == hi ? 1.0f : lo / hi);
+
+    float angle = 0.0f;
+    if (t > TanPiOver8) {
+        t = (t - 1.0f) / (t + 1.0f);
+        angle = PiOver4;
+    }
+    angle += t + t * (t * t) * horner(t * t, coefficients<P>(AtanPrecise, AtanFast));
+
+    if (ay > ax) {
+        angle = PiOver2 - angle;
+    }
+    if (std::signbit(x)) {
+        angle = Pi - angle;
+    }
+    return std::copysign(angle, y);
+}
+
+template <Precision P>
+float acosScalar(float x) {
+    const float a = std::fabs(x);
+    if (a > 0.5f) {
+        const float z = 0.5f * (1.0f - a);
+        const float s = std::sqrt(z); // NaN beyond [-1, 1]
+        const float angle = 2.0f * (s + s * z * horner(z, coefficients<P>(AsinPrecise, AsinFast)));
+        return x < 0.0f ? Pi - angle : angle;
+    }
+    const float z = x * x;
+    return PiOver2 - (x + x * z * horner(z, coefficients<P>(AsinPrecise, AsinFast)));
+}
+
+template <Precision P>
+void sincosArrayScalar(const float* x, float* sines, float* cosines, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        sincosScalar<P>(x[i], sines[i], cosines[i]);
+    }
+}
+
+template <auto Function>
+void unaryScalar(const float* in, float* out, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = Function(in[i]);
+    }
+}
+
+template <Precision P>
+void atan2ArrayScalar(const float* y, const float* x, float* out, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = atan2Scalar<P>(y[i], x[i]);
+    }
+}
+
+#if VIREALIS_SIMD_X86
+
+// Replaces the lanes flagged in mask (bit i for lane i) with std::sin and std::cos, for the
+// SIMD paths' arguments beyond SincosMax
+void sincosLargeLanes(const float* x, float* sines, float* cosines, int mask) {
+    for (int lane = 0; mask != 0; ++lane, mask >>= 1) {
+        if (mask & 1) {
+            sines[lane] = std::sin(x[lane]);
+            cosines[lane] = std::cos(x[lane]);
+        }
+    }
+}
+
+// SSE, four values per register
+
+template <size_t N>
+VIREALIS_TARGET_SSE41 inline __m128 horner4(__m128 x, const float (&c)[N]) {
+    __m128 p = _mm_set1_ps(c[0]);
+    for (size_t i = 1; i < N; ++i) {
+        p = _mm_add_ps(_mm_mul_ps(p, x), _mm_set1_ps(c[i]));
+    }
+    return p;
+}
+
+VIREALIS_TARGET_SSE41 inline __m128 signBits4(__m128 v) {
+    return _mm_and_ps(v, _mm_set1_ps(-0.0f));
+}
+
+template <Precision P>
+VIREALIS_TARGET_SSE41 inline void sincos4(__m128 x, __m128& sine, __m128& cosine) {
+    const __m128 n = _mm_round_ps(_mm_mul_ps(x, _mm_set1_ps(TwoOverPi)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    __m128 r = _mm_sub_ps(x, _mm_mul_ps(n, _mm_set1_ps(PiOver2A)));
+    r = _mm_sub_ps(r, _mm_mul_ps(n, _mm_set1_ps(PiOver2B)));
+    r = _mm_sub_ps(r, _mm_mul_ps(n, _mm_set1_ps(PiOver2C)));
+    r = _mm_sub_ps(r, _mm_mul_ps(n, _mm_set1_ps(PiOver2D)));
+    const __m128 z = _mm_mul_ps(r, r);
+    const __m128 s = _mm_add_ps(r, _mm_mul_ps(_mm_mul_ps(r, z), horner4(z, coefficients<P>(SinPrecise, SinFast))));
+    const __m128 c = horner4(z, coefficients<P>(CosPrecise, CosFast));
+
+    // Odd quadrants swap sine and cosine; bit 1 of the quadrant, or of the quadrant + 1,
+    // moved to the sign bit negates them
+    const __m128i quadrant = _mm_cvtps_epi32(n);
+    const __m128i one = _mm_set1_epi32(1);
+    const __m128i two = _mm_set1_epi32(2);
+    const __m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(quadrant, one), one));
+    const __m128 sineSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(quadrant, two), 30));
+    const __m128 cosineSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(quadrant, one), two), 30));
+    sine = _mm_xor_ps(_mm_blendv_ps(s, c, swap), sineSign);
+    sine = _mm_blendv_ps(sine, x, _mm_cmpeq_ps(x, _mm_setzero_ps())); // The reduction turns -0 into +0
+    cosine = _mm_xor_ps(_mm_blendv_ps(c, s, swap), cosineSign);
+
+    const int large = _mm_movemask_ps(_mm_cmpgt_ps(_mm_andnot_ps(_mm_set1_ps(-0.0f), x), _mm_set1_ps(SincosMax)));
+    if (large != 0) {
+        alignas(16) float lanes[3][4];
+        _mm_store_ps(lanes[0], x);
+        _mm_store_ps(lanes[1], sine);
+        _mm_store_ps(lanes[2], cosine);
+        sincosLargeLanes(lanes[0], lanes[1], lanes[2], large);
+        sine = _mm_load_ps(lanes[1]);
+        cosine = _mm_load_ps(lanes[2]);
+    }
+}
+
+template <Precision P>
+VIREALIS_TARGET_SSE41 inline __m128 exp4(__m128 x) {
+    const __m128 clamped = _mm_min_ps(_mm_max_ps(x, _mm_set1_ps(ExpMin)), _mm_set1_ps(ExpMax));
+    __m128 n = _mm_round_ps(_mm_mul_ps(clamped, _mm_set1_ps(Log2E)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    __m128 r = _mm_sub_ps(clamped, _mm_mul_ps(n, _mm_set1_ps(Ln2A)));
+    r = _mm_sub_ps(r, _mm_mul_ps(n, _mm_set1_ps(Ln2B)));
+    __m128 p = horner4(r, coefficients<P>(ExpPrecise, ExpFast));
+
+    const __m128 nTooLarge = _mm_cmpgt_ps(n, _mm_set1_ps(127.0f));
+    p = _mm_blendv_ps(p, _mm_add_ps(p, p), nTooLarge);
+    n = _mm_min_ps(n, _mm_set1_ps(127.0f));
+    const __m128i exponent = _mm_add_epi32(_mm_cvtps_epi32(n), _mm_set1_epi32(127));
+    __m128 result = _mm_mul_ps(p, _mm_castsi128_ps(_mm_slli_epi32(exponent, 23)));
+    result = _mm_min_ps(result, _mm_set1_ps(std::numeric_limits<float>::max()));
+
+    result = _mm_blendv_ps(result, _mm_set1_ps(std::numeric_limits<float>::infinity()),
+                           _mm_cmpgt_ps(x, _mm_set1_ps(ExpMax)));
+    result = _mm_blendv_ps(result, _mm_setzero_ps(), _mm_cmplt_ps(x, _mm_set1_ps(ExpMin)));
+    return _mm_blendv_ps(result, x, _mm_cmpunord_ps(x, x));
+}
+
+template <Precision P>
+VIREALIS_TARGET_SSE41 inline __m128 rsqrt4(__m128 x) {
+    if constexpr (P == Precision::Precise) {
+        return _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(x));
+    } else {
+        const __m128 estimate = _mm_rsqrt_ps(x);
+        // x e^2 first: halving x before it would lose bits to subnormals next to FLT_MIN
+        const __m128 half = _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(x, estimate), estimate), _mm_set1_ps(0.5f));
+        const __m128 correction = _mm_sub_ps(_mm_set1_ps(1.5f), half);
+        const __m128 keepEstimate = _mm_or_ps(_mm_cmplt_ps(x, _mm_set1_ps(std::numeric_limits<float>::min())),
+                                              _mm_cmpeq_ps(x, _mm_set1_ps(std::numeric_limits<float>::infinity())));
+        return _mm_blendv_ps(_mm_mul_ps(estimate, correction), estimate, keepEstimate);
+    }
+}
+
+template <Precision P>
+VIREALIS_TARGET_SSE41 inline __m128 atan24(__m128 y, __m128 x) {
+    const __m128 ax = _mm_andnot_ps(_mm_set1_ps(-0.0f), x);
+    const __m128 ay = _mm_andnot_ps(_mm_set1_ps(-0.0f), y);
+    const __m128 hi = _mm_max_ps(ax, ay);
+    const __m128 lo = _mm_min_ps(ax, ay);
+    __m128 t = _mm_blendv_ps(_mm_div_ps(lo, hi), _mm_set1_ps(1.0f), _mm_cmpeq_ps(lo, hi));
+    t = _mm_blendv_ps(t, _mm_setzero_ps(), _mm_cmpeq_ps(hi, _mm_setzero_ps()));
+
+    const __m128 reduce = _mm_cmpgt_ps(t, _mm_set1_ps(TanPiOver8));
+    t = _mm_blendv_ps(t, _mm_div_ps(_mm_sub_ps(t, _mm_set1_ps(1.0f)), _mm_add_ps(t, _mm_set1_ps(1.0f))), reduce);
+    const __m128 z = _mm_mul_ps(t, t);
+    __m128 angle = _mm_add_ps(t, _mm_mul_ps(_mm_mul_ps(t, z), horner4(z, coefficients<P>(AtanPrecise, AtanFast))));
+    angle = _mm_add_ps(_mm_and_ps(reduce, _mm_set1_ps(PiOver4)), angle);
+
+    angle = _mm_blendv_ps(angle, _mm_sub_ps(_mm_set1_ps(PiOver2), angle), _mm_cmpgt_ps(ay, ax));
+    angle = _mm_blendv_ps(angle, _mm_sub_ps(_mm_set1_ps(Pi), angle), x); // blendv reads x's sign bit
+    angle = _mm_or_ps(angle, signBits4(y)); // The angle is non-negative here
+    const __m128 eitherNaN = _mm_cmpunord_ps(x, y);
+    return _mm_blendv_ps(angle, _mm_add_ps(x, y), eitherNaN);
+}
+
+template <Precision P>
+VIREALIS_TARGET_SSE41 inline __m128 acos4(__m128 x) {
+    const __m128 a = _mm_andnot_ps(_mm_set1_ps(-0.0f), x);
+    const __m128 large = _mm_cmpgt_ps(a, _mm_set1_ps(0.5f));
+    const __m128 z = _mm_blendv_ps(_mm_mul_ps(x, x), _mm_mul_ps(_mm_set1_ps(0.5f), _mm_sub_ps(_mm_set1_ps(1.0f), a)),
+                                   large);
+    const __m128 s = _mm_blendv_ps(x, _mm_sqrt_ps(z), large);
+    const __m128 asin = _mm_add_ps(s, _mm_mul_ps(_mm_mul_ps(s, z), horner4(z, coefficients<P>(AsinPrecise, AsinFast))));
+
+    __m128 largeAngle = _mm_add_ps(asin, asin);
+    largeAngle = _mm_blendv_ps(largeAngle, _mm_sub_ps(_mm_set1_ps(Pi), largeAngle), x);
+    const __m128 smallAngle = _mm_sub_ps(_mm_set1_ps(PiOver2), asin);
+    return _mm_blendv_ps(smallAngle, largeAngle, large);
+}
+
+template <Precision P>
+VIREALIS_TARGET_SSE41 void sincosArraySSE(const float* x, float* sines, float* cosines, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 sine, cosine;
+        sincos4<P>(_mm_loadu_ps(x + i), sine, cosine);
+        _mm_storeu_ps(sines + i, sine);
+        _mm_storeu_ps(cosines + i, cosine);
+    }
+    if (i < n) {
+        // Pad the tail to a full register, so it rounds like the rest
+        float lanes[4] = {};
+        std::copy(x + i, x + n, lanes);
+        __m128 sine, cosine;
+        sincos4<P>(_mm_loadu_ps(lanes), sine, cosine);
+        _mm_storeu_ps(lanes, sine);
+        std::copy(lanes, lanes + (n - i), sines + i);
+        _mm_storeu_ps(lanes, cosine);
+        std::copy(lanes, lanes + (n - i), cosines + i);
+    }
+}
+
+template <auto Function>
+VIREALIS_TARGET_SSE41 void unarySSE(const float* in, float* out, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        _mm_storeu_ps(out + i, Function(_mm_loadu_ps(in + i)));
+    }
+    if (i < n) {
+        float lanes[4] = {};
+        std::copy(in + i, in + n, lanes);
+        _mm_storeu_ps(lanes, Function(_mm_loadu_ps(lanes)));
+        std::copy(lanes, lanes + (n - i), out + i);
+    }
+}
+
+template <Precision P>
+VIREALIS_TARGET_SSE41 void atan2ArraySSE(const float* y, const float* x, float* out, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        _mm_storeu_ps(out + i, atan24<P>(_mm_loadu_ps(y + i), _mm_loadu_ps(x + i)));
+    }
+    if (i < n) {
+        float yLanes[4] = {};
+        float xLanes[4] = {};
+        std::copy(y + i, y + n, yLanes);
+        std::copy(x + i, x + n, xLanes);
+        _mm_storeu_ps(yLanes, atan24<P>(_mm_loadu_ps(yLanes), _mm_loadu_ps(xLanes)));
+        std::copy(yLanes, yLanes + (n - i), out + i);
+    }
+}
+
+// AVX2, eight values per register, with fused multiply-adds
+
+template <size_t N>
+VIREALIS_TARGET_AVX2 inline __m256 horner8(__m256 x, const float (&c)[N]) {
+    __m256 p = _mm256_set1_ps(c[0]);
+    for (size_t i = 1; i < N; ++i) {
+        p = _mm256_fmadd_ps(p, x, _mm256_set1_ps(c[i]));
+    }
+    return p;
+}
+
+template <Precision P>
+VIREALIS_TARGET_AVX2 inline void sincos8(__m256 x, __m256& sine, __m256& cosine) {
+    const __m256 n = _mm256_round_ps(_mm256_mul_ps(x, _mm256_set1_ps(TwoOverPi)),
+                                     _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    __m256 r = _mm256_fnmadd_ps(n, _mm256_set1_ps(PiOver2A), x);
+    r = _mm256_fnmadd_ps(n, _mm256_set1_ps(PiOver2B), r);
+    r = _mm256_fnmadd_ps(n, _mm256_set1_ps(PiOver2C), r);
+    r = _mm256_fnmadd_ps(n, _mm256_set1_ps(PiOver2D), r);
+    const __m256 z = _mm256_mul_ps(r, r);
+    const __m256 s = _mm256_fmadd_ps(_mm256_mul_ps(r, z), horner8(z, coefficients<P>(SinPrecise, SinFast)), r);
+    const __m256 c = horner8(z, coefficients<P>(CosPrecise, CosFast));
+
+    const __m256i quadrant = _mm256_cvtps_epi32(n);
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256i two = _mm256_set1_epi32(2);
+    const __m256 swap = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(quadrant, one), one));
+    const __m256 sineSign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(quadrant, two), 30));
+    const __m256 cosineSign =
+        _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(_mm256_add_epi32(quadrant, one), two), 30));
+    sine = _mm256_xor_ps(_mm256_blendv_ps(s, c, swap), sineSign);
+    sine = _mm256_blendv_ps(sine, x, _mm256_cmp_ps(x, _mm256_setzero_ps(), _CMP_EQ_OQ));
+    cosine = _mm256_xor_ps(_mm256_blendv_ps(c, s, swap), cosineSign);
+
+    const int large = _mm256_movemask_ps(
+        _mm256_cmp_ps(_mm256_andnot_ps(_mm256_set1_ps(-0.0f), x), _mm256_set1_ps(SincosMax), _CMP_GT_OQ));
+    if (large != 0) {
+        alignas(32) float lanes[3][8];
+        _mm256_store_ps(lanes[0], x);
+        _mm256_store_ps(lanes[1], sine);
+        _mm256_store_ps(lanes[2], cosine);
+        sincosLargeLanes(lanes[0], lanes[1], lanes[2], large);
+        sine = _mm256_load_ps(lanes[1]);
+        cosine = _mm256_load_ps(lanes[2]);
+    }
+}
+
+template <Precision P>
+VIREALIS_TARGET_AVX2 inline __m256 exp8(__m256 x) {
+    const __m256 clamped = _mm256_min_ps(_mm256_max_ps(x, _mm256_set1_ps(ExpMin)), _mm256_set1_ps(ExpMax));
+    __m256 n = _mm256_round_ps(_mm256_mul_ps(clamped, _mm256_set1_ps(Log2E)),
+                               _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    __m256 r = _mm256_fnmadd_ps(n, _mm256_set1_ps(Ln2A), clamped);
+    r = _mm256_fnmadd_ps(n, _mm256_set1_ps(Ln2B), r);
+    __m256 p = horner8(r, coefficients<P>(ExpPrecise, ExpFast));
+
+    const __m256 nTooLarge = _mm256_cmp_ps(n, _mm256_set1_ps(127.0f), _CMP_GT_OQ);
+    p = _mm256_blendv_ps(p, _mm256_add_ps(p, p), nTooLarge);
+    n = _mm256_min_ps(n, _mm256_set1_ps(127.0f));
+    const __m256i exponent = _mm256_add_epi32(_mm256_cvtps_epi32(n), _mm256_set1_epi32(127));
+    __m256 result = _mm256_mul_ps(p, _mm256_castsi256_ps(_mm256_slli_epi32(exponent, 23)));
+    result = _mm256_min_ps(result, _mm256_set1_ps(std::numeric_limits<float>::max()));
+
+    result = _mm256_blendv_ps(result, _mm256_set1_ps(std::numeric_limits<float>::infinity()),
+                              _mm256_cmp_ps(x, _mm256_set1_ps(ExpMax), _CMP_GT_OQ));
+    result = _mm256_blendv_ps(result, _mm256_setzero_ps(), _mm256_cmp_ps(x, _mm256_set1_ps(ExpMin), _CMP_LT_OQ));
+    return _mm256_blendv_ps(result, x, _mm256_cmp_ps(x, x, _CMP_UNORD_Q));
+}
+
+template <Precision P>
+VIREALIS_TARGET_AVX2 inline __m256 rsqrt8(__m256 x) {
+    if constexpr (P == Precision::Precise) {
+        return _mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_sqrt_ps(x));
+    } else {
+        const __m256 estimate = _mm256_rsqrt_ps(x);
+        const __m256 xe = _mm256_mul_ps(x, estimate);
+        const __m256 correction = _mm256_fnmadd_ps(_mm256_mul_ps(xe, estimate), _mm256_set1_ps(0.5f),
+                                                   _mm256_set1_ps(1.5f));
+        const __m256 keepEstimate = _mm256_or_ps(
+            _mm256_cmp_ps(x, _mm256_set1_ps(std::numeric_limits<float>::min()), _CMP_LT_OQ),
+            _mm256_cmp_ps(x, _mm256_set1_ps(std::numeric_limits<float>::infinity()), _CMP_EQ_OQ));
+        return _mm256_blendv_ps(_mm256_mul_ps(estimate, correction), estimate, keepEstimate);
+    }
+}
+
+template <Precision P>
+VIREALIS_TARGET_AVX2 inline __m256 atan28(__m256 y, __m256 x) {
+    const __m256 ax = _mm256_andnot_ps(_mm256_set1_ps(-0.0f), x);
+    const __m256 ay = _mm256_andnot_ps(_mm256_set1_ps(-0.0f), y);
+    const __m256 hi = _mm256_max_ps(ax, ay);
+    const __m256 lo = _mm256_min_ps(ax, ay);
+    __m256 t = _mm256_blendv_ps(_mm256_div_ps(lo, hi), _mm256_set1_ps(1.0f), _mm256_cmp_ps(lo, hi, _CMP_EQ_OQ));
+    t = _mm256_blendv_ps(t, _mm256_setzero_ps(), _mm256_cmp_ps(hi, _mm256_setzero_ps(), _CMP_EQ_OQ));
+
+    const __m256 reduce = _mm256_cmp_ps(t, _mm256_set1_ps(TanPiOver8), _CMP_GT_OQ);
+    t = _mm256_blendv_ps(
+        t, _mm256_div_ps(_mm256_sub_ps(t, _mm256_set1_ps(1.0f)), _mm256_add_ps(t, _mm256_set1_ps(1.0f))), reduce);
+    const __m256 z = _mm256_mul_ps(t, t);
+    __m256 angle = _mm256_fmadd_ps(_mm256_mul_ps(t, z), horner8(z, coefficients<P>(AtanPrecise, AtanFast)), t);
+    angle = _mm256_add_ps(_mm256_and_ps(reduce, _mm256_set1_ps(PiOver4)), angle);
+
+    angle = _mm256_blendv_ps(angle, _mm256_sub_ps(_mm256_set1_ps(PiOver2), angle), _mm256_cmp_ps(ay, ax, _CMP_GT_OQ));
+    angle = _mm256_blendv_ps(angle, _mm256_sub_ps(_mm256_set1_ps(Pi), angle), x);
+    angle = _mm256_or_ps(angle, _mm256_and_ps(y, _mm256_set1_ps(-0.0f)));
+    return _mm256_blendv_ps(angle, _mm256_add_ps(x, y), _mm256_cmp_ps(x, y, _CMP_UNORD_Q));
+}
+
+template <Precision P>
+VIREALIS_TARGET_AVX2 inline __m256 acos8(__m256 x) {
+    const __m256 a = _mm256_andnot_ps(_mm256_set1_ps(-0.0f), x);
+    const __m256 large = _mm256_cmp_ps(a, _mm256_set1_ps(0.5f), _CMP_GT_OQ);
+    const __m256 z = _mm256_blendv_ps(_mm256_mul_ps(x, x),
+                                      _mm256_mul_ps(_mm256_set1_ps(0.5f), _mm256_sub_ps(_mm256_set1_ps(1.0f), a)), large);
+    const __m256 s = _mm256_blendv_ps(x, _mm256_sqrt_ps(z), large);
+    const __m256 asin = _mm256_fmadd_ps(_mm256_mul_ps(s, z), horner8(z, coefficients<P>(AsinPrecise, AsinFast)), s);
+
+    __m256 largeAngle = _mm256_add_ps(asin, asin);
+    largeAngle = _mm256_blendv_ps(largeAngle, _mm256_sub_ps(_mm256_set1_ps(Pi), largeAngle), x);
+    const __m256 smallAngle = _mm256_sub_ps(_mm256_set1_ps(PiOver2), asin);
+    return _mm256_blendv_ps(smallAngle, largeAngle, large);
+}
+
+template <Precision P>
+VIREALIS_TARGET_AVX2 void sincosArrayAVX2(const float* x, float* sines, float* cosines, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 sine, cosine;
+        sincos8<P>(_mm256_loadu_ps(x + i), sine, cosine);
+        _mm256_storeu_ps(sines + i, sine);
+        _mm256_storeu_ps(cosines + i, cosine);
+    }
+    if (i < n) {
+        float lanes[8] = {};
+        std::copy(x + i, x + n, lanes);
+        __m256 sine, cosine;
+        sincos8<P>(_mm256_loadu_ps(lanes), sine, cosine);
+        _mm256_storeu_ps(lanes, sine);
+        std::copy(lanes, lanes + (n - i), sines + i);
+        _mm256_storeu_ps(lanes, cosine);
+        std::copy(lanes, lanes + (n - i), cosines + i);
+    }
+}
+
+template <auto Function>
+VIREALIS_TARGET_AVX2 void unaryAVX2(const float* in, float* out, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        _mm256_storeu_ps(out + i, Function(_mm256_loadu_ps(in + i)));
+    }
+    if (i < n) {
+        float lanes[8] = {};
+        std::copy(in + i, in + n, lanes);
+        _mm256_storeu_ps(lanes, Function(_mm256_loadu_ps(lanes)));
+        std::copy(lanes, lanes + (n - i), out + i);
+    }
+}
+
+template <Precision P>
+VIREALIS_TARGET_AVX2 void atan2ArrayAVX2(const float* y, const float* x, float* out, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        _mm256_storeu_ps(out + i, atan28<P>(_mm256_loadu_ps(y + i), _mm256_loadu_ps(x + i)));
+    }
+    if (i < n) {
+        float yLanes[8] = {};
+        float xLanes[8] = {};
+        std::copy(y + i, y + n, yLanes);
+        std::copy(x + i, x + n, xLanes);
+        _mm256_storeu_ps(yLanes, atan28<P>(_mm256_loadu_ps(yLanes), _mm256_loadu_ps(xLanes)));
+        std::copy(yLanes, yLanes + (n - i), out + i);
+    }
+}
+
+#endif // VIREALIS_SIMD_X86
+
+using SincosKernel = void (*)(const float* x, float* sines, float* cosines, size_t n);
+using UnaryKernel = void (*)(const float* in, float* out, size_t n);
+using Atan2Kernel = void (*)(const float* y, const float* x, float* out, size_t n);
+
+template <Precision P>
+SincosKernel selectSincos() {
+#if VIREALIS_SIMD_X86
+    switch (getSimdPath()) {
+    case SimdPath::AVX2:
+        return sincosArrayAVX2<P>;
+    case SimdPath::SSE:
+        return sincosArraySSE<P>;
+    default:
+        break;
+    }
+#endif
+    return sincosArrayScalar<P>;
+}
+
+template <Precision P>
+UnaryKernel selectExp() {
+#if VIREALIS_SIMD_X86
+    switch (getSimdPath()) {
+    case SimdPath::AVX2:
+        return unaryAVX2<exp8<P>>;
+    case SimdPath::SSE:
+        return unarySSE<exp4<P>>;
+    default:
+        break;
+    }
+#endif
+    return unaryScalar<expScalar<P>>;
+}
+
+template <Precision P>
+UnaryKernel selectRsqrt() {
+#if VIREALIS_SIMD_X86
+    switch (getSimdPath()) {
+    case SimdPath::AVX2:
+        return unaryAVX2<rsqrt8<P>>;
+    case SimdPath::SSE:
+        return unarySSE<rsqrt4<P>>;
+    default:
+        break;
+    }
+#endif
+    return unaryScalar<rsqrtScalar<P>>;
+}
+
+template <Precision P>
+Atan2Kernel selectAtan2() {
+#if VIREALIS_SIMD_X86
+    switch (getSimdPath()) {
+    case SimdPath::AVX2:
+        return atan2ArrayAVX2<P>;
+    case SimdPath::SSE:
+        return atan2ArraySSE<P>;
+    default:
+        break;
+    }
+#endif
+    return atan2ArrayScalar<P>;
+}
+
+template <Precision P>
+UnaryKernel selectAcos() {
+#if VIREALIS_SIMD_X86
+    switch (getSimdPath()) {
+    case SimdPath::AVX2:
+        return unaryAVX2<acos8<P>>;
+    case SimdPath::SSE:
+        return unarySSE<acos4<P>>;
+    default:
+        break;
+    }
+#endif
+    return unaryScalar<acosScalar<P>>;
+}
+
+void checkLengths(size_t expected, size_t actual, const char* function) {
+    if (actual != expected) {
+        throw std::runtime_error(std::string(function) + " needs spans of the same length.");
+    }
+}
+
+} // namespace
+
+void sincos(float x, float& sine, float& cosine, Precision precision) {
+    if (precision == Precision::Precise) {
+        sincosScalar<Precision::Precise>(x, sine, cosine);
+    } else {
+        sincosScalar<Precision::Fast>(x, sine, cosine);
+    }
+}
+
+float exp(float x, Precision precision) {
+    return precision == Precision::Precise ? expScalar<Precision::Precise>(x) : expScalar<Precision::Fast>(x);
+}
+
+float rsqrt(float x, Precision precision) {
+    return precision == Precision::Precise ? rsqrtScalar<Precision::Precise>(x) : rsqrtScalar<Precision::Fast>(x);
+}
+
+float atan2(float y, float x, Precision precision) {
+    return precision == Precision::Precise ? atan2Scalar<Precision::Precise>(y, x) : atan2Scalar<Precision::Fast>(y, x);
+}
+
+float acos(float x, Precision precision) {
+    return precision == Precision::Precise ? acosScalar<Precision::Precise>(x) : acosScalar<Precision::Fast>(x);
+}
+
+void sincos(std::span<const float> x, std::span<float> sines, std::span<float> cosines, Precision precision) {
+    checkLengths(x.size(), sines.size(), "FastMath::sincos");
+    checkLengths(x.size(), cosines.size(), "FastMath::sincos");
+    if (!x.empty()) {
+        SincosKernel kernel = precision == Precision::Precise ? selectSincos<Precision::Precise>()
+                                                              : selectSincos<Precision::Fast>();
+        kernel(x.data(), sines.data(), cosines.data(), x.size());
+    }
+}
+
+void exp(std::span<const float> x, std::span<float> out, Precision precision) {
+    checkLengths(x.size(), out.size(), "FastMath::exp");
+    if (!x.empty()) {
+        UnaryKernel kernel = precision == Precision::Precise ? selectExp<Precision::Precise>()
+                                                             : selectExp<Precision::Fast>();
+        kernel(x.data(), out.data(), x.size());
+    }
+}
+
+void rsqrt(std::span<const float> x, std::span<float> out, Precision precision) {
+    checkLengths(x.size(), out.size(), "FastMath::rsqrt");
+    if (!x.empty()) {
+        UnaryKernel kernel = precision == Precision::Precise ? selectRsqrt<Precision::Precise>()
+                                                             : selectRsqrt<Precision::Fast>();
+        kernel(x.data(), out.data(), x.size());
+    }
+}
+
+void atan2(std::span<const float> y, std::span<const float> x, std::span<float> out, Precision precision) {
+    checkLengths(y.size(), x.size(), "FastMath::atan2");
+    checkLengths(y.size(), out.size(), "FastMath::atan2");
+    if (!y.empty()) {
+        Atan2Kernel kernel = precision == Precision::Precise ? selectAtan2<Precision::Precise>()
+                                                             : selectAtan2<Precision::Fast>();
+        kernel(y.data(), x.data(), out.data(), y.size());
+    }
+}
+
+void acos(std::span<const float> x, std::span<float> out, Precision precision) {
+    checkLengths(x.size(), out.size(), "FastMath::acos");
+    if (!x.empty()) {
+        UnaryKernel kernel = precision == Precision::Precise ? selectAcos<Precision::Precise>()
+                                                             : selectAcos<Precision::Fast>();
+        kernel(x.data(), out.data(), x.size());
+    }
+}
+
+} // namespace virealis::FastMath
@@ -0,0 +1,41 @@
+#include <virealis/Math/Matrix3x4.hpp>
+#include <virealis/Math/Matrix4x4.hpp>
+
+namespace virealis {
+
+// Translation * Rotation * Scale, built directly from the quaternion
+Matrix3x4 Matrix3x4::fromTranslationRotationScale(const Vector3& translation, const Quaternion& rotation,
+                                                  const Vector3& scale) {
+    const float x = rotation.x, y = rotation.y, z = rotation.z, w = rotation.w;
+    const float xx = x * x, yy = y * y, zz = z * z;
+    const float xy = x * y, xz = x * z, yz = y * z;
+    const float wx = w * x, wy = w * y, wz = w * z;
+
+    return Matrix3x4({
+        (1.0f - 2.0f * (yy + zz)) * scale.x, 2.0f * (xy - wz) * scale.y,          2.0f * (xz + wy) * scale.z,          translation.x,
+        2.0f * (xy + wz) * scale.x,          (1.0f - 2.0f * (xx + zz)) * scale.y, 2.0f * (yz - wx) * scale.z,          translation.y,
+        2.0f * (xz - wy) * scale.x,          2.0f * (yz + wx) * scale.y,          (1.0f - 2.0f * (xx + yy)) * scale.z, translation.z
+    });
+}
+
+Matrix3x4 Matrix3x4::fromMatrix4x4(const Matrix4x4& matrix) {
+    Matrix3x4 result;
+    for (int row = 0; row < 3; ++row) {
+        for (int col = 0; col < 4; ++col) {
+            result(row, col) = matrix(row, col);
+        }
+    }
+    return result;
+}
+
+Matrix4x4 Matrix3x4::toMatrix4x4() const {
+    Matrix4x4 result = Matrix4x4::identity();
+    for (int row = 0; row < 3; ++row) {
+        for (int col = 0; col < 4; ++col) {
+            result(row, col) = (*this)(row, col);
+        }
+    }
+    return result;
+}
+
+} // namespace virealis
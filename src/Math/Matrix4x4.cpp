@@ -2,25 +2,6 @@
 
 namespace virealis {
 
-// Identity Matrix
-Matrix4x4 Matrix4x4::identity() {
-    return Matrix4x4({
-        1.0f, 0.0f, 0.0f, 0.0f,
-        0.0f, 1.0f, 0.0f, 0.0f,
-        0.0f, 0.0f, 1.0f, 0.0f,
-        0.0f, 0.0f, 0.0f, 1.0f
-    });
-}
-
-// Translation Matrix
-Matrix4x4 Matrix4x4::translation(const Vector3& translation) {
-    Matrix4x4 result = Matrix4x4::identity();
-    result(0, 3) = translation.x;
-    result(1, 3) = translation.y;
-    result(2, 3) = translation.z;
-    return result;
-}
-
 // Rotation Matrix (using the axis-angle method)
 Matrix4x4 Matrix4x4::rotation(float angle, const Vector3& axis) {
     Matrix4x4 result = Matrix4x4::identity();
@@ -48,15 +29,6 @@ Matrix4x4 Matrix4x4::rotation(float angle, const Vector3& axis) {
     return result;
 }
 
-// Scale Matrix
-Matrix4x4 Matrix4x4::scale(const Vector3& scale) {
-    Matrix4x4 result = Matrix4x4::identity();
-    result(0, 0) = scale.x;
-    result(1, 0) = scale.y;
-    result(2, 0) = scale.z;
-    return result;
-}
-
 Matrix4x4 Matrix4x4::perspective(float fov, float aspectRatio, float nearPlane, float farPlane) {
     Matrix4x4 projection = Matrix4x4::identity();
 
@@ -109,17 +81,6 @@ Matrix4x4 Matrix4x4::lookAt(const Vector3& eye, const Vector3& target, const Vec
     return result;
 }
 
-// Transpose Matrix
-Matrix4x4 Matrix4x4::transpose() const {
-    Matrix4x4 result;
-    for (int i = 0; i < 4; ++i) {
-        for (int j = 0; j < 4; ++j) {
-            result(i, j) = (*this)(j, i);
-        }
-    }
-    return result;
-}
-
 // Determinant of the Matrix
 float Matrix4x4::determinant() const {
     // Assuming the matrix is 4x4, we calculate the determinant using cofactor expansion.
@@ -140,9 +101,7 @@ float Matrix4x4::determinant() const {
 // Inverse Matrix
 Matrix4x4 Matrix4x4::inverse() const {
     Matrix4x4 result;
-    // Implementation of matrix inversion can be quite involved; for simplicity, assume a valid invertible matrix.
-    // Calculate the inverse using an appropriate method (e.g., Gaussian elimination or cofactor method).
-    // ...
+    inverseArrays(this, &result, 1);
     return result;
 }
 
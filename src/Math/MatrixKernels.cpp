@@ -0,0 +1,460 @@
+#include <virealis/Math/Matrix4x4.hpp>
+#include <virealis/Math/Matrix3x4.hpp>
+#include <virealis/Math/Simd.hpp>
+#include <algorithm>
+#include <type_traits>
+
+#if VIREALIS_SIMD_X86
+#include <immintrin.h>
+#endif
+
+/*
+Batch matrix products, out[i] = a[i * aStride] * b[i], on raw row-major floats.
+
+Each output row is a combination of the rows of b weighted by one row of a, so every
+path broadcasts a's elements and multiplies whole rows of b: SSE handles one row per
+register, AVX2 two. All loads of a product happen before its stores, which lets out be
+the same array as a or b.
+
+Batch point transforms work the other way around: the matrix is transposed once, and
+each point becomes a combination of its columns weighted by the point's coordinates.
+Column-major output for the GPU is the same transpose, one matrix at a time.
+
+General inverses split the matrix into 2x2 blocks, one per register, so the cofactors
+come from a few 2x2 products rather than sixteen 3x3 determinants.
+*/
+
+namespace virealis {
+
+static_assert(sizeof(Matrix4x4) == 16 * sizeof(float) && std::is_standard_layout_v<Matrix4x4>,
+              "The batch kernels treat Matrix4x4 arrays as packed floats.");
+static_assert(sizeof(Matrix3x4) == 12 * sizeof(float) && std::is_standard_layout_v<Matrix3x4>,
+              "The batch kernels treat Matrix3x4 arrays as packed floats.");
+static_assert(sizeof(Vector3A) == 4 * sizeof(float) && alignof(Vector3A) == 16,
+              "The batch kernels treat Vector3A arrays as aligned groups of four floats.");
+
+namespace {
+
+void multiply4x4Scalar(const float* a, size_t aStride, const float* b, float* out, size_t n) {
+    for (size_t i = 0; i < n; ++i, a += aStride, b += 16, out += 16) {
+        float result[16];
+        for (int row = 0; row < 4; ++row) {
+            for (int col = 0; col < 4; ++col) {
+                result[row * 4 + col] = a[row * 4 + 0] * b[0 * 4 + col] + a[row * 4 + 1] * b[1 * 4 + col] +
+                                        a[row * 4 + 2] * b[2 * 4 + col] + a[row * 4 + 3] * b[3 * 4 + col];
+            }
+        }
+        std::copy(result, result + 16, out);
+    }
+}
+
+void multiply3x4Scalar(const float* a, size_t aStride, const float* b, float* out, size_t n) {
+    for (size_t i = 0; i < n; ++i, a += aStride, b += 12, out += 12) {
+        float result[12];
+        for (int row = 0; row < 3; ++row) {
+            for (int col = 0; col < 4; ++col) {
+                result[row * 4 + col] = a[row * 4 + 0] * b[0 * 4 + col] + a[row * 4 + 1] * b[1 * 4 + col] +
+                                        a[row * 4 + 2] * b[2 * 4 + col];
+            }
+            result[row * 4 + 3] += a[row * 4 + 3]; // Implied bottom row of b is (0, 0, 0, 1)
+        }
+        std::copy(result, result + 12, out);
+    }
+}
+
+void transformPointsScalar(const float* m, const float* in, float* out, size_t n) {
+    for (size_t i = 0; i < n; ++i, in += 4, out += 4) {
+        const float x = in[0];
+        const float y = in[1];
+        const float z = in[2];
+        for (int row = 0; row < 3; ++row) {
+            out[row] = m[row * 4 + 0] * x + m[row * 4 + 1] * y + m[row * 4 + 2] * z + m[row * 4 + 3];
+        }
+        out[3] = 0.0f;
+    }
+}
+
+void inverse4x4Scalar(const float* in, float* out, size_t n) {
+    for (size_t i = 0; i < n; ++i, in += 16, out += 16) {
+        const float* m = in;
+        // 2x2 determinants of the top two rows and of the bottom two
+        const float s0 = m[0] * m[5] - m[4] * m[1];
+        const float s1 = m[0] * m[6] - m[4] * m[2];
+        const float s2 = m[0] * m[7] - m[4] * m[3];
+        const float s3 = m[1] * m[6] - m[5] * m[2];
+        const float s4 = m[1] * m[7] - m[5] * m[3];
+        const float s5 = m[2] * m[7] - m[6] * m[3];
+        const float c0 = m[8] * m[13] - m[12] * m[9];
+        const float c1 = m[8] * m[14] - m[12] * m[10];
+        const float c2 = m[8] * m[15] - m[12] * m[11];
+        const float c3 = m[9] * m[14] - m[13] * m[10];
+        const float c4 = m[9] * m[15] - m[13] * m[11];
+        const float c5 = m[10] * m[15] - m[14] * m[11];
+        const float inverseDeterminant = 1.0f / (s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0);
+
+        float result[16];
+        result[0] = (m[5] * c5 - m[6] * c4 + m[7] * c3) * inverseDeterminant;
+        result[1] = (-m[1] * c5 + m[2] * c4 - m[3] * c3) * inverseDeterminant;
+        result[2] = (m[13] * s5 - m[14] * s4 + m[15] * s3) * inverseDeterminant;
+        result[3] = (-m[9] * s5 + m[10] * s4 - m[11] * s3) * inverseDeterminant;
+        result[4] = (-m[4] * c5 + m[6] * c2 - m[7] * c1) * inverseDeterminant;
+        result[5] = (m[0] * c5 - m[2] * c2 + m[3] * c1) * inverseDeterminant;
+        result[6] = (-m[12] * s5 + m[14] * s2 - m[15] * s1) * inverseDeterminant;
+        result[7] = (m[8] * s5 - m[10] * s2 + m[11] * s1) * inverseDeterminant;
+        result[8] = (m[4] * c4 - m[5] * c2 + m[7] * c0) * inverseDeterminant;
+        result[9] = (-m[0] * c4 + m[1] * c2 - m[3] * c0) * inverseDeterminant;
+        result[10] = (m[12] * s4 - m[13] * s2 + m[15] * s0) * inverseDeterminant;
+        result[11] = (-m[8] * s4 + m[9] * s2 - m[11] * s0) * inverseDeterminant;
+        result[12] = (-m[4] * c3 + m[5] * c1 - m[6] * c0) * inverseDeterminant;
+        result[13] = (m[0] * c3 - m[1] * c1 + m[2] * c0) * inverseDeterminant;
+        result[14] = (-m[12] * s3 + m[13] * s1 - m[14] * s0) * inverseDeterminant;
+        result[15] = (m[8] * s3 - m[9] * s1 + m[10] * s0) * inverseDeterminant;
+        std::copy(result, result + 16, out);
+    }
+}
+
+#if VIREALIS_SIMD_X86
+
+VIREALIS_TARGET_SSE41 void multiply4x4SSE(const float* a, size_t aStride, const float* b, float* out, size_t n) {
+    for (size_t i = 0; i < n; ++i, a += aStride, b += 16, out += 16) {
+        const __m128 b0 = _mm_loadu_ps(b);
+        const __m128 b1 = _mm_loadu_ps(b + 4);
+        const __m128 b2 = _mm_loadu_ps(b + 8);
+        const __m128 b3 = _mm_loadu_ps(b + 12);
+        __m128 rows[4];
+        for (int row = 0; row < 4; ++row) {
+            const __m128 aRow = _mm_loadu_ps(a + row * 4);
+            __m128 result = _mm_mul_ps(_mm_shuffle_ps(aRow, aRow, 0x00), b0);
+            result = _mm_add_ps(result, _mm_mul_ps(_mm_shuffle_ps(aRow, aRow, 0x55), b1));
+            result = _mm_add_ps(result, _mm_mul_ps(_mm_shuffle_ps(aRow, aRow, 0xAA), b2));
+            rows[row] = _mm_add_ps(result, _mm_mul_ps(_mm_shuffle_ps(aRow, aRow, 0xFF), b3));
+        }
+        for (int row = 0; row < 4; ++row) {
+            _mm_storeu_ps(out + row * 4, rows[row]);
+        }
+    }
+}
+
+VIREALIS_TARGET_SSE41 void multiply3x4SSE(const float* a, size_t aStride, const float* b, float* out, size_t n) {
+    // Keeps a's translation, the term b's implied (0, 0, 0, 1) row contributes
+    const __m128 translationMask = _mm_castsi128_ps(_mm_set_epi32(-1, 0, 0, 0));
+    for (size_t i = 0; i < n; ++i, a += aStride, b += 12, out += 12) {
+        const __m128 b0 = _mm_loadu_ps(b);
+        const __m128 b1 = _mm_loadu_ps(b + 4);
+        const __m128 b2 = _mm_loadu_ps(b + 8);
+        __m128 rows[3];
+        for (int row = 0; row < 3; ++row) {
+            const __m128 aRow = _mm_loadu_ps(a + row * 4);
+            __m128 result = _mm_and_ps(aRow, translationMask);
+            result = _mm_add_ps(result, _mm_mul_ps(_mm_shuffle_ps(aRow, aRow, 0x00), b0));
+            result = _mm_add_ps(result, _mm_mul_ps(_mm_shuffle_ps(aRow, aRow, 0x55), b1));
+            rows[row] = _mm_add_ps(result, _mm_mul_ps(_mm_shuffle_ps(aRow, aRow, 0xAA), b2));
+        }
+        for (int row = 0; row < 3; ++row) {
+            _mm_storeu_ps(out + row * 4, rows[row]);
+        }
+    }
+}
+
+VIREALIS_TARGET_AVX2 void multiply4x4AVX2(const float* a, size_t aStride, const float* b, float* out, size_t n) {
+    for (size_t i = 0; i < n; ++i, a += aStride, b += 16, out += 16) {
+        // Each row of b in both halves, against two rows of a per register
+        const __m256 b0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b));
+        const __m256 b1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b + 4));
+        const __m256 b2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b + 8));
+        const __m256 b3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b + 12));
+        const __m256 a01 = _mm256_loadu_ps(a);
+        const __m256 a23 = _mm256_loadu_ps(a + 8);
+
+        __m256 r01 = _mm256_mul_ps(_mm256_permute_ps(a01, 0x00), b0);
+        r01 = _mm256_fmadd_ps(_mm256_permute_ps(a01, 0x55), b1, r01);
+        r01 = _mm256_fmadd_ps(_mm256_permute_ps(a01, 0xAA), b2, r01);
+        r01 = _mm256_fmadd_ps(_mm256_permute_ps(a01, 0xFF), b3, r01);
+
+        __m256 r23 = _mm256_mul_ps(_mm256_permute_ps(a23, 0x00), b0);
+        r23 = _mm256_fmadd_ps(_mm256_permute_ps(a23, 0x55), b1, r23);
+        r23 = _mm256_fmadd_ps(_mm256_permute_ps(a23, 0xAA), b2, r23);
+        r23 = _mm256_fmadd_ps(_mm256_permute_ps(a23, 0xFF), b3, r23);
+
+        _mm256_storeu_ps(out, r01);
+        _mm256_storeu_ps(out + 8, r23);
+    }
+}
+
+VIREALIS_TARGET_AVX2 void multiply3x4AVX2(const float* a, size_t aStride, const float* b, float* out, size_t n) {
+    const __m256 translationMask = _mm256_castsi256_ps(_mm256_set_epi32(-1, 0, 0, 0, -1, 0, 0, 0));
+    for (size_t i = 0; i < n; ++i, a += aStride, b += 12, out += 12) {
+        // Rows 0 and 1 share a register, row 2 takes the lower half of one
+        const __m256 b0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b));
+        const __m256 b1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b + 4));
+        const __m256 b2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b + 8));
+        const __m256 a01 = _mm256_loadu_ps(a);
+        const __m128 a2 = _mm_loadu_ps(a + 8);
+
+        __m256 r01 = _mm256_and_ps(a01, translationMask);
+        r01 = _mm256_fmadd_ps(_mm256_permute_ps(a01, 0x00), b0, r01);
+        r01 = _mm256_fmadd_ps(_mm256_permute_ps(a01, 0x55), b1, r01);
+        r01 = _mm256_fmadd_ps(_mm256_permute_ps(a01, 0xAA), b2, r01);
+
+        __m128 r2 = _mm_and_ps(a2, _mm256_castps256_ps128(translationMask));
+        r2 = _mm_fmadd_ps(_mm_permute_ps(a2, 0x00), _mm256_castps256_ps128(b0), r2);
+        r2 = _mm_fmadd_ps(_mm_permute_ps(a2, 0x55), _mm256_castps256_ps128(b1), r2);
+        r2 = _mm_fmadd_ps(_mm_permute_ps(a2, 0xAA), _mm256_castps256_ps128(b2), r2);
+
+        _mm256_storeu_ps(out, r01);
+        _mm_storeu_ps(out + 8, r2);
+    }
+}
+
+// Helpers for 2x2 row-major blocks held as (m00, m01, m10, m11)
+#define VIREALIS_SWIZZLE(v, x, y, z, w) _mm_shuffle_ps(v, v, _MM_SHUFFLE(w, z, y, x))
+
+// a * b
+VIREALIS_TARGET_SSE41 inline __m128 multiply2x2(__m128 a, __m128 b) {
+    return _mm_add_ps(_mm_mul_ps(a, VIREALIS_SWIZZLE(b, 0, 3, 0, 3)),
+                      _mm_mul_ps(VIREALIS_SWIZZLE(a, 1, 0, 3, 2), VIREALIS_SWIZZLE(b, 2, 1, 2, 1)));
+}
+
+// adjugate(a) * b
+VIREALIS_TARGET_SSE41 inline __m128 adjugateMultiply2x2(__m128 a, __m128 b) {
+    return _mm_sub_ps(_mm_mul_ps(VIREALIS_SWIZZLE(a, 3, 3, 0, 0), b),
+                      _mm_mul_ps(VIREALIS_SWIZZLE(a, 1, 1, 2, 2), VIREALIS_SWIZZLE(b, 2, 3, 0, 1)));
+}
+
+// a * adjugate(b)
+VIREALIS_TARGET_SSE41 inline __m128 multiplyAdjugate2x2(__m128 a, __m128 b) {
+    return _mm_sub_ps(_mm_mul_ps(a, VIREALIS_SWIZZLE(b, 3, 0, 3, 0)),
+                      _mm_mul_ps(VIREALIS_SWIZZLE(a, 1, 0, 3, 2), VIREALIS_SWIZZLE(b, 2, 1, 2, 1)));
+}
+
+// With M = [A B; C D] in 2x2 blocks, the blocks of adjugate(M) are
+//   X = |D| A - B adj(D) C,   Y = |B| C - D adj(adj(A) B),
+//   Z = |C| B - A adj(adj(D) C),   W = |A| D - C adj(A) B   (each then adjugated),
+// and |M| = |A||D| + |B||C| - trace(adj(A) B adj(D) C)
+VIREALIS_TARGET_SSE41 void inverse4x4SSE(const float* in, float* out, size_t n) {
+    for (size_t i = 0; i < n; ++i, in += 16, out += 16) {
+        const __m128 row0 = _mm_loadu_ps(in);
+        const __m128 row1 = _mm_loadu_ps(in + 4);
+        const __m128 row2 = _mm_loadu_ps(in + 8);
+        const __m128 row3 = _mm_loadu_ps(in + 12);
+
+        const __m128 a = _mm_movelh_ps(row0, row1);
+        const __m128 b = _mm_movehl_ps(row1, row0);
+        const __m128 c = _mm_movelh_ps(row2, row3);
+        const __m128 d = _mm_movehl_ps(row3, row2);
+
+        // (|A|, |B|, |C|, |D|)
+        const __m128 blockDeterminants = _mm_sub_ps(
+            _mm_mul_ps(_mm_shuffle_ps(row0, row2, _MM_SHUFFLE(2, 0, 2, 0)),
+                       _mm_shuffle_ps(row1, row3, _MM_SHUFFLE(3, 1, 3, 1))),
+            _mm_mul_ps(_mm_shuffle_ps(row0, row2, _MM_SHUFFLE(3, 1, 3, 1)),
+                       _mm_shuffle_ps(row1, row3, _MM_SHUFFLE(2, 0, 2, 0))));
+        const __m128 detA = VIREALIS_SWIZZLE(blockDeterminants, 0, 0, 0, 0);
+        const __m128 detB = VIREALIS_SWIZZLE(blockDeterminants, 1, 1, 1, 1);
+        const __m128 detC = VIREALIS_SWIZZLE(blockDeterminants, 2, 2, 2, 2);
+        const __m128 detD = VIREALIS_SWIZZLE(blockDeterminants, 3, 3, 3, 3);
+
+        const __m128 adjDC = adjugateMultiply2x2(d, c);
+        const __m128 adjAB = adjugateMultiply2x2(a, b);
+        __m128 x = _mm_sub_ps(_mm_mul_ps(detD, a), multiply2x2(b, adjDC));
+        __m128 w = _mm_sub_ps(_mm_mul_ps(detA, d), multiply2x2(c, adjAB));
+        __m128 y = _mm_sub_ps(_mm_mul_ps(detB, c), multiplyAdjugate2x2(d, adjAB));
+        __m128 z = _mm_sub_ps(_mm_mul_ps(detC, b), multiplyAdjugate2x2(a, adjDC));
+
+        __m128 trace = _mm_mul_ps(adjAB, VIREALIS_SWIZZLE(adjDC, 0, 2, 1, 3));
+        trace = _mm_hadd_ps(trace, trace);
+        trace = _mm_hadd_ps(trace, trace);
+        const __m128 determinant =
+            _mm_sub_ps(_mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC)), trace);
+
+        // The signs complete the adjugate of each block
+        const __m128 scale = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), determinant);
+        x = _mm_mul_ps(x, scale);
+        y = _mm_mul_ps(y, scale);
+        z = _mm_mul_ps(z, scale);
+        w = _mm_mul_ps(w, scale);
+
+        // Adjugating swaps each block's diagonal; the shuffles do that and reassemble rows
+        _mm_storeu_ps(out, _mm_shuffle_ps(x, y, _MM_SHUFFLE(1, 3, 1, 3)));
+        _mm_storeu_ps(out + 4, _mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 2, 0, 2)));
+        _mm_storeu_ps(out + 8, _mm_shuffle_ps(z, w, _MM_SHUFFLE(1, 3, 1, 3)));
+        _mm_storeu_ps(out + 12, _mm_shuffle_ps(z, w, _MM_SHUFFLE(0, 2, 0, 2)));
+    }
+}
+
+#undef VIREALIS_SWIZZLE
+
+// Columns of the top three rows; the zero fourth lane keeps the points' padding at zero
+VIREALIS_TARGET_SSE41 void loadColumns(const float* m, __m128 columns[4]) {
+    __m128 row0 = _mm_loadu_ps(m);
+    __m128 row1 = _mm_loadu_ps(m + 4);
+    __m128 row2 = _mm_loadu_ps(m + 8);
+    __m128 row3 = _mm_setzero_ps();
+    _MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+    columns[0] = row0;
+    columns[1] = row1;
+    columns[2] = row2;
+    columns[3] = row3;
+}
+
+VIREALIS_TARGET_SSE41 void transformPointsSSE(const float* m, const float* in, float* out, size_t n) {
+    __m128 columns[4];
+    loadColumns(m, columns);
+    for (size_t i = 0; i < n; ++i, in += 4, out += 4) {
+        const __m128 point = _mm_load_ps(in);
+        __m128 result = _mm_add_ps(columns[3], _mm_mul_ps(_mm_shuffle_ps(point, point, 0x00), columns[0]));
+        result = _mm_add_ps(result, _mm_mul_ps(_mm_shuffle_ps(point, point, 0x55), columns[1]));
+        result = _mm_add_ps(result, _mm_mul_ps(_mm_shuffle_ps(point, point, 0xAA), columns[2]));
+        _mm_store_ps(out, result);
+    }
+}
+
+VIREALIS_TARGET_AVX2 void transformPointsAVX2(const float* m, const float* in, float* out, size_t n) {
+    __m128 columns[4];
+    loadColumns(m, columns);
+    // Two points per register, so each column goes in both halves
+    const __m256 c0 = _mm256_set_m128(columns[0], columns[0]);
+    const __m256 c1 = _mm256_set_m128(columns[1], columns[1]);
+    const __m256 c2 = _mm256_set_m128(columns[2], columns[2]);
+    const __m256 c3 = _mm256_set_m128(columns[3], columns[3]);
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2, in += 8, out += 8) {
+        const __m256 points = _mm256_loadu_ps(in); // Pairs are only 16-byte aligned
+        __m256 result = _mm256_fmadd_ps(_mm256_permute_ps(points, 0x00), c0, c3);
+        result = _mm256_fmadd_ps(_mm256_permute_ps(points, 0x55), c1, result);
+        result = _mm256_fmadd_ps(_mm256_permute_ps(points, 0xAA), c2, result);
+        _mm256_storeu_ps(out, result);
+    }
+    if (i < n) {
+        const __m128 point = _mm_load_ps(in);
+        __m128 result = _mm_fmadd_ps(_mm_permute_ps(point, 0x00), columns[0], columns[3]);
+        result = _mm_fmadd_ps(_mm_permute_ps(point, 0x55), columns[1], result);
+        result = _mm_fmadd_ps(_mm_permute_ps(point, 0xAA), columns[2], result);
+        _mm_store_ps(out, result);
+    }
+}
+
+#endif // VIREALIS_SIMD_X86
+
+using Kernel = void (*)(const float* a, size_t aStride, const float* b, float* out, size_t n);
+
+Kernel select4x4() {
+#if VIREALIS_SIMD_X86
+    switch (getSimdPath()) {
+    case SimdPath::AVX2:
+        return multiply4x4AVX2;
+    case SimdPath::SSE:
+        return multiply4x4SSE;
+    default:
+        break;
+    }
+#endif
+    return multiply4x4Scalar;
+}
+
+Kernel select3x4() {
+#if VIREALIS_SIMD_X86
+    switch (getSimdPath()) {
+    case SimdPath::AVX2:
+        return multiply3x4AVX2;
+    case SimdPath::SSE:
+        return multiply3x4SSE;
+    default:
+        break;
+    }
+#endif
+    return multiply3x4Scalar;
+}
+
+using InverseKernel = void (*)(const float* in, float* out, size_t n);
+
+InverseKernel selectInverse() {
+#if VIREALIS_SIMD_X86
+    // One matrix fills the SSE registers already; the AVX2 path reuses the SSE kernel
+    if (getSimdPath() != SimdPath::Scalar) {
+        return inverse4x4SSE;
+    }
+#endif
+    return inverse4x4Scalar;
+}
+
+using TransformKernel = void (*)(const float* m, const float* in, float* out, size_t n);
+
+TransformKernel selectTransformPoints() {
+#if VIREALIS_SIMD_X86
+    switch (getSimdPath()) {
+    case SimdPath::AVX2:
+        return transformPointsAVX2;
+    case SimdPath::SSE:
+        return transformPointsSSE;
+    default:
+        break;
+    }
+#endif
+    return transformPointsScalar;
+}
+
+} // namespace
+
+void Matrix4x4::multiplyArrays(const Matrix4x4* a, const Matrix4x4* b, Matrix4x4* out, size_t n) {
+    if (n > 0) {
+        select4x4()(a->elements.data(), 16, b->elements.data(), out->elements.data(), n);
+    }
+}
+
+void Matrix4x4::multiplyArrays(const Matrix4x4& a, const Matrix4x4* b, Matrix4x4* out, size_t n) {
+    if (n > 0) {
+        select4x4()(a.elements.data(), 0, b->elements.data(), out->elements.data(), n);
+    }
+}
+
+void Matrix4x4::transformPoints(const Matrix4x4& matrix, const Vector3A* in, Vector3A* out, size_t n) {
+    if (n > 0) {
+        selectTransformPoints()(matrix.elements.data(), &in->x, &out->x, n);
+    }
+}
+
+void Matrix4x4::inverseArrays(const Matrix4x4* in, Matrix4x4* out, size_t n) {
+    if (n > 0) {
+        selectInverse()(in->elements.data(), out->elements.data(), n);
+    }
+}
+
+void Matrix4x4::writeColumnMajor(std::span<const Matrix4x4> matrices, float* dst) {
+    // A 4x4 transpose is a handful of SSE2 shuffles, which every x86-64 build has, so
+    // this needs no runtime dispatch
+    for (const Matrix4x4& matrix : matrices) {
+#if VIREALIS_SIMD_SSE2
+        __m128 column0 = _mm_load_ps(&matrix.elements[0]);
+        __m128 column1 = _mm_load_ps(&matrix.elements[4]);
+        __m128 column2 = _mm_load_ps(&matrix.elements[8]);
+        __m128 column3 = _mm_load_ps(&matrix.elements[12]);
+        _MM_TRANSPOSE4_PS(column0, column1, column2, column3);
+        _mm_storeu_ps(dst, column0);
+        _mm_storeu_ps(dst + 4, column1);
+        _mm_storeu_ps(dst + 8, column2);
+        _mm_storeu_ps(dst + 12, column3);
+#else
+        for (int row = 0; row < 4; ++row) {
+            for (int col = 0; col < 4; ++col) {
+                dst[col * 4 + row] = matrix.elements[row * 4 + col];
+            }
+        }
+#endif
+        dst += 16;
+    }
+}
+
+void Matrix3x4::multiplyArrays(const Matrix3x4* a, const Matrix3x4* b, Matrix3x4* out, size_t n) {
+    if (n > 0) {
+        select3x4()(a->elements.data(), 12, b->elements.data(), out->elements.data(), n);
+    }
+}
+
+void Matrix3x4::multiplyArrays(const Matrix3x4& a, const Matrix3x4* b, Matrix3x4* out, size_t n) {
+    if (n > 0) {
+        select3x4()(a.elements.data(), 0, b->elements.data(), out->elements.data(), n);
+    }
+}
+
+} // namespace virealis
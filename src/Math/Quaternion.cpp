@@ -0,0 +1,55 @@
+#include <virealis/Math/Quaternion.hpp>
+#include <virealis/Math/Matrix4x4.hpp>
+
+namespace virealis {
+
+// Shepperd's method: branch on the largest diagonal term to keep the square root well away from zero
+Quaternion Quaternion::fromRotationMatrix(const Matrix4x4& m) {
+    float trace = m(0, 0) + m(1, 1) + m(2, 2);
+    Quaternion q;
+    if (trace > 0.0f) {
+        float s = std::sqrt(trace + 1.0f) * 2.0f;
+        q = Quaternion((m(2, 1) - m(1, 2)) / s, (m(0, 2) - m(2, 0)) / s, (m(1, 0) - m(0, 1)) / s, 0.25f * s);
+    } else if (m(0, 0) > m(1, 1) && m(0, 0) > m(2, 2)) {
+        float s = std::sqrt(1.0f + m(0, 0) - m(1, 1) - m(2, 2)) * 2.0f;
+        q = Quaternion(0.25f * s, (m(0, 1) + m(1, 0)) / s, (m(0, 2) + m(2, 0)) / s, (m(2, 1) - m(1, 2)) / s);
+    } else if (m(1, 1) > m(2, 2)) {
+        float s = std::sqrt(1.0f + m(1, 1) - m(0, 0) - m(2, 2)) * 2.0f;
+        q = Quaternion((m(0, 1) + m(1, 0)) / s, 0.25f * s, (m(1, 2) + m(2, 1)) / s, (m(0, 2) - m(2, 0)) / s);
+    } else {
+        float s = std::sqrt(1.0f + m(2, 2) - m(0, 0) - m(1, 1)) * 2.0f;
+        q = Quaternion((m(0, 2) + m(2, 0)) / s, (m(1, 2) + m(2, 1)) / s, 0.25f * s, (m(1, 0) - m(0, 1)) / s);
+    }
+    return q.normalized();
+}
+
+Matrix4x4 Quaternion::toRotationMatrix() const {
+    const float xx = x * x, yy = y * y, zz = z * z;
+    const float xy = x * y, xz = x * z, yz = y * z;
+    const float wx = w * x, wy = w * y, wz = w * z;
+
+    return Matrix4x4({
+        1.0f - 2.0f * (yy + zz), 2.0f * (xy - wz),        2.0f * (xz + wy),        0.0f,
+        2.0f * (xy + wz),        1.0f - 2.0f * (xx + zz), 2.0f * (yz - wx),        0.0f,
+        2.0f * (xz - wy),        2.0f * (yz + wx),        1.0f - 2.0f * (xx + yy), 0.0f,
+        0.0f,                    0.0f,                    0.0f,                    1.0f
+    });
+}
+
+Quaternion Quaternion::slerp(const Quaternion& a, const Quaternion& b, float t) {
+    float cosTheta = a.dot(b);
+    const Quaternion end = cosTheta < 0.0f ? -b : b;
+    cosTheta = std::fabs(cosTheta);
+    // Nearly equal rotations: sin(theta) is too small to divide by, and nlerp is as exact
+    if (cosTheta > 0.9995f) {
+        return nlerp(a, end, t);
+    }
+
+    const float theta = std::acos(cosTheta);
+    const float sinTheta = std::sin(theta);
+    const float ta = std::sin((1.0f - t) * theta) / sinTheta;
+    const float tb = std::sin(t * theta) / sinTheta;
+    return Quaternion(a.x * ta + end.x * tb, a.y * ta + end.y * tb, a.z * ta + end.z * tb, a.w * ta + end.w * tb);
+}
+
+} // namespace virealis
@@ -0,0 +1,74 @@
+#include <virealis/Math/Simd.hpp>
+#include <algorithm>
+#include <atomic>
+
+#if VIREALIS_SIMD_X86 && defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+namespace virealis {
+
+namespace {
+
+SimdPath detectSimdPath() {
+#if VIREALIS_SIMD_X86 && (defined(__GNUC__) || defined(__clang__))
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        return SimdPath::AVX2;
+    }
+    if (__builtin_cpu_supports("sse4.1")) {
+        return SimdPath::SSE;
+    }
+    return SimdPath::Scalar;
+#elif VIREALIS_SIMD_X86 && defined(_MSC_VER)
+    int registers[4];
+    __cpuid(registers, 1);
+    const bool sse41 = (registers[2] & (1 << 19)) != 0;
+    const bool fma = (registers[2] & (1 << 12)) != 0;
+    const bool osSavesAvx = (registers[2] & (1 << 27)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+    __cpuidex(registers, 7, 0);
+    const bool avx2 = (registers[1] & (1 << 5)) != 0;
+    if (avx2 && fma && osSavesAvx) {
+        return SimdPath::AVX2;
+    }
+    return sse41 ? SimdPath::SSE : SimdPath::Scalar;
+#else
+    return SimdPath::Scalar;
+#endif
+}
+
+std::atomic<SimdPath>& activePath() {
+    static std::atomic<SimdPath> path{ getSupportedSimdPath() };
+    return path;
+}
+
+} // namespace
+
+SimdPath getSupportedSimdPath() {
+    static const SimdPath supported = detectSimdPath();
+    return supported;
+}
+
+SimdPath getSimdPath() {
+    return activePath().load(std::memory_order_relaxed);
+}
+
+SimdPath setSimdPath(SimdPath path) {
+    path = std::min(path, getSupportedSimdPath());
+    activePath().store(path, std::memory_order_relaxed);
+    return path;
+}
+
+const char* getSimdPathName(SimdPath path) {
+    switch (path) {
+    case SimdPath::AVX2:
+        return "AVX2";
+    case SimdPath::SSE:
+        return "SSE4.1";
+    default:
+        return "scalar";
+    }
+}
+
+} // namespace virealis
@@ -0,0 +1,82 @@
+#include <virealis/Math/Vector3A.hpp>
+#include <virealis/Math/Simd.hpp>
+#include <cmath>
+
+#if VIREALIS_SIMD_X86
+#include <immintrin.h>
+#endif
+
+/*
+Batch vector operations on Vector3A arrays, as aligned groups of four floats whose last
+lane is zero. SSE handles one vector per register, AVX2 two; every path keeps the
+padding lane at zero.
+*/
+
+namespace virealis {
+
+namespace {
+
+void normalizeScalar(const float* in, float* out, size_t n) {
+    for (size_t i = 0; i < n; ++i, in += 4, out += 4) {
+        const float length = std::sqrt(in[0] * in[0] + in[1] * in[1] + in[2] * in[2]);
+        out[0] = in[0] / length;
+        out[1] = in[1] / length;
+        out[2] = in[2] / length;
+        out[3] = 0.0f;
+    }
+}
+
+#if VIREALIS_SIMD_X86
+
+VIREALIS_TARGET_SSE41 void normalizeSSE(const float* in, float* out, size_t n) {
+    const __m128 xyzMask = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+    for (size_t i = 0; i < n; ++i, in += 4, out += 4) {
+        const __m128 v = _mm_load_ps(in);
+        const __m128 length = _mm_sqrt_ps(_mm_dp_ps(v, v, 0x7F));
+        _mm_store_ps(out, _mm_and_ps(_mm_div_ps(v, length), xyzMask));
+    }
+}
+
+VIREALIS_TARGET_AVX2 void normalizeAVX2(const float* in, float* out, size_t n) {
+    const __m256 xyzMask = _mm256_castsi256_ps(_mm256_set_epi32(0, -1, -1, -1, 0, -1, -1, -1));
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2, in += 8, out += 8) {
+        const __m256 v = _mm256_loadu_ps(in); // Pairs are only 16-byte aligned
+        // The dot product works within each half, one vector each
+        const __m256 length = _mm256_sqrt_ps(_mm256_dp_ps(v, v, 0x7F));
+        _mm256_storeu_ps(out, _mm256_and_ps(_mm256_div_ps(v, length), xyzMask));
+    }
+    if (i < n) {
+        const __m128 v = _mm_load_ps(in);
+        const __m128 length = _mm_sqrt_ps(_mm_dp_ps(v, v, 0x7F));
+        _mm_store_ps(out, _mm_and_ps(_mm_div_ps(v, length), _mm256_castps256_ps128(xyzMask)));
+    }
+}
+
+#endif // VIREALIS_SIMD_X86
+
+using NormalizeKernel = void (*)(const float* in, float* out, size_t n);
+
+NormalizeKernel selectNormalize() {
+#if VIREALIS_SIMD_X86
+    switch (getSimdPath()) {
+    case SimdPath::AVX2:
+        return normalizeAVX2;
+    case SimdPath::SSE:
+        return normalizeSSE;
+    default:
+        break;
+    }
+#endif
+    return normalizeScalar;
+}
+
+} // namespace
+
+void Vector3A::normalizeArray(const Vector3A* in, Vector3A* out, size_t n) {
+    if (n > 0) {
+        selectNormalize()(&in->x, &out->x, n);
+    }
+}
+
+} // namespace virealis
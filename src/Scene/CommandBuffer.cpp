@@ -0,0 +1,138 @@
+#include <virealis/Scene/CommandBuffer.hpp>
+#include <algorithm>
+
+namespace virealis {
+
+namespace {
+    // Clears a buffer when playback ends, whether or not a command threw
+    template <typename Buffer>
+    struct ClearOnExit {
+        Buffer& buffer;
+        ~ClearOnExit() { buffer.clear(); }
+    };
+}
+
+CommandBuffer::~CommandBuffer() {
+    clear();
+}
+
+Entity CommandBuffer::createEntity() {
+    Entity provisional = { pendingCount, PendingGeneration };
+    commands.push_back({ CommandType::CreateEntity, provisional, nullptr, nullptr, nullptr });
+    pendingCount++;
+    return provisional;
+}
+
+void CommandBuffer::destroyEntity(Entity entity) {
+    commands.push_back({ CommandType::DestroyEntity, entity, nullptr, nullptr, nullptr });
+}
+
+void* CommandBuffer::allocate(size_t size, size_t alignment) {
+    // Fill the blocks in order; a request that doesn't fit moves on to the next one
+    while (currentBlock < blocks.size()) {
+        Block& block = blocks[currentBlock];
+        void* pointer = block.memory.get() + blockOffset;
+        size_t space = block.size - blockOffset;
+        if (std::align(alignment, size, pointer, space)) {
+            blockOffset = static_cast<std::byte*>(pointer) - block.memory.get() + size;
+            return pointer;
+        }
+        currentBlock++;
+        blockOffset = 0;
+    }
+
+    // Oversized arguments get a block of their own
+    size_t blockSize = std::max(BlockSize, size + alignment);
+    blocks.push_back({ std::make_unique_for_overwrite<std::byte[]>(blockSize), blockSize });
+    currentBlock = blocks.size() - 1;
+    void* pointer = blocks.back().memory.get();
+    size_t space = blockSize;
+    std::align(alignment, size, pointer, space);
+    blockOffset = static_cast<std::byte*>(pointer) - blocks.back().memory.get() + size;
+    return pointer;
+}
+
+Entity CommandBuffer::resolve(Entity entity) const {
+    if (entity.generation == PendingGeneration && entity.index < createdEntities.size()) {
+        return createdEntities[entity.index];
+    }
+    return entity;
+}
+
+void CommandBuffer::playback(Scene& scene) {
+    ClearOnExit<CommandBuffer> clearOnExit{ *this };
+    createdEntities.assign(pendingCount, Entity{ 0, PendingGeneration });
+
+    for (Command& command : commands) {
+        switch (command.type) {
+            case CommandType::CreateEntity:
+                createdEntities[command.entity.index] = scene.createEntity();
+                break;
+            case CommandType::DestroyEntity:
+                scene.destroyEntity(resolve(command.entity));
+                break;
+            case CommandType::Component: {
+                Entity target = resolve(command.entity);
+                if (scene.isValid(target)) {
+                    command.apply(command.arguments, scene, target);
+                }
+                break;
+            }
+        }
+    }
+}
+
+void CommandBuffer::clear() {
+    for (Command& command : commands) {
+        if (command.destroy) {
+            command.destroy(command.arguments);
+        }
+    }
+    commands.clear();
+    currentBlock = 0;
+    blockOffset = 0;
+    createdEntities.clear();
+    pendingCount = 0;
+}
+
+bool CommandBuffer::empty() const {
+    return commands.empty();
+}
+
+size_t CommandBuffer::size() const {
+    return commands.size();
+}
+
+CommandBufferSet::CommandBufferSet(const ThreadPool& threadPool)
+    : threadPool(threadPool),
+      bufferCount(threadPool.getThreadCount() + 1),
+      buffers(std::make_unique<PaddedBuffer[]>(bufferCount)) {}
+
+CommandBuffer& CommandBufferSet::local() {
+    size_t worker = threadPool.getCurrentWorkerIndex();
+    return buffers[worker != ThreadPool::npos ? worker : bufferCount - 1].buffer;
+}
+
+void CommandBufferSet::playback(Scene& scene) {
+    ClearOnExit<CommandBufferSet> clearOnExit{ *this };
+    for (size_t i = 0; i < bufferCount; ++i) {
+        buffers[i].buffer.playback(scene);
+    }
+}
+
+void CommandBufferSet::clear() {
+    for (size_t i = 0; i < bufferCount; ++i) {
+        buffers[i].buffer.clear();
+    }
+}
+
+bool CommandBufferSet::empty() const {
+    for (size_t i = 0; i < bufferCount; ++i) {
+        if (!buffers[i].buffer.empty()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace virealis
@@ -3,59 +3,127 @@
 
 namespace virealis {
 
+Scene::Scene() {
+    registry.registerComponent<MeshComponentManager>();
+    registry.registerComponent<MaterialComponentManager>();
+    registry.registerComponent<TransformComponentManager>();
+    registry.registerComponent<CameraComponentManager>();
+    BoundsComponentManager& boundsManager = registry.registerComponent<BoundsComponentManager>();
+
+    // World bounds are refreshed in the transform update pass
+    getTransformManager().setBoundsManager(&boundsManager);
+}
+
 Entity Scene::createEntity() {
-    Entity entity = { static_cast<uint32_t>(entities.size()), 0 };
-    entities.push_back(entity);
+    Entity entity = entityManager.createEntity();
+    aliveEntities.insert(entity);
     return entity;
 }
 
 void Scene::destroyEntity(Entity entity) {
-    auto it = std::find(entities.begin(), entities.end(), entity);
-    if (it != entities.end()) {
-        entities.erase(it);
-
-        // Destroy components associated with this entity
-        meshManager.destroy(entity);
-        materialManager.destroy(entity);
-        transformManager.destroy(entity);
-        cameraManager.destroy(entity);
+    if (!entityManager.isValid(entity)) {
+        return; // Already destroyed or never created by this scene
+    }
+
+    // Destroy components associated with this entity; only the managers in its mask are visited
+    registry.destroyAll(entity);
+
+    // Swap-remove from the alive list, then bump the generation and recycle the index
+    aliveEntities.remove(entity);
+    entityManager.destroyEntity(entity);
+}
+
+void Scene::destroySubtree(Entity root) {
+    if (!entityManager.isValid(root)) {
+        return;
+    }
+
+    TransformComponentManager& transformManager = getTransformManager();
+    if (!transformManager.isValid(root)) {
+        destroyEntity(root);
+        return;
+    }
+
+    // Leaves first, so each entity's transform is childless when it goes (see
+    // TransformComponentManager::destroySubtree)
+    std::vector<Entity> subtree;
+    transformManager.collectSubtree(root, subtree);
+    for (auto it = subtree.rbegin(); it != subtree.rend(); ++it) {
+        destroyEntity(*it);
     }
 }
 
+std::span<const Entity> Scene::createEntities(size_t count) {
+    // New entities are appended to the dense alive list, so they end up contiguous
+    size_t first = aliveEntities.size();
+    aliveEntities.reserve(first + count);
+    for (size_t i = 0; i < count; ++i) {
+        aliveEntities.insert(entityManager.createEntity());
+    }
+    return std::span<const Entity>(aliveEntities.getEntities()).subspan(first, count);
+}
+
+void Scene::reserve(size_t entityCount) {
+    entityManager.reserve(entityCount);
+    aliveEntities.reserve(entityCount);
+}
+
+uint32_t Scene::advanceTick() {
+    ++currentTick;
+    registry.setCurrentTick(currentTick);
+    return currentTick;
+}
+
+uint32_t Scene::getCurrentTick() const {
+    return currentTick;
+}
+
+bool Scene::isValid(Entity entity) const {
+    return entityManager.isValid(entity);
+}
+
 MeshComponentManager& Scene::getMeshManager() {
-    return meshManager;
+    return getManager<MeshComponentManager>();
 }
 
 const MeshComponentManager& Scene::getMeshManager() const {
-    return meshManager;
+    return getManager<MeshComponentManager>();
 }
 
 MaterialComponentManager& Scene::getMaterialManager() {
-    return materialManager;
+    return getManager<MaterialComponentManager>();
 }
 
 const MaterialComponentManager& Scene::getMaterialManager() const {
-    return materialManager;
+    return getManager<MaterialComponentManager>();
 }
 
 TransformComponentManager& Scene::getTransformManager() {
-    return transformManager;
+    return getManager<TransformComponentManager>();
 }
 
 const TransformComponentManager& Scene::getTransformManager() const {
-    return transformManager;
+    return getManager<TransformComponentManager>();
 }
 
 CameraComponentManager& Scene::getCameraManager() {
-    return cameraManager;
+    return getManager<CameraComponentManager>();
 }
 
 const CameraComponentManager& Scene::getCameraManager() const {
-    return cameraManager;
+    return getManager<CameraComponentManager>();
+}
+
+BoundsComponentManager& Scene::getBoundsManager() {
+    return getManager<BoundsComponentManager>();
+}
+
+const BoundsComponentManager& Scene::getBoundsManager() const {
+    return getManager<BoundsComponentManager>();
 }
 
 const std::vector<Entity>& Scene::getEntities() const {
-    return entities;
+    return aliveEntities.getEntities();
 }
 
 } // namespace virealis
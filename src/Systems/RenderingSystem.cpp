@@ -1,9 +1,10 @@
 #include <virealis/Systems/RenderingSystem.hpp>
+#include <algorithm>
 #include <iostream> // For debug logging
 
 namespace virealis {
 
-void RenderingSystem::render(const Scene& scene, Entity activeCameraEntity) {
+void RenderingSystem::render(const Scene& scene, Entity activeCameraEntity, float alpha) {
     // Get the camera component manager and retrieve the view/projection matrices
     const CameraComponentManager& cameraManager = scene.getCameraManager();
     const MeshComponentManager& meshManager = scene.getMeshManager();
@@ -16,26 +17,45 @@ void RenderingSystem::render(const Scene& scene, Entity activeCameraEntity) {
     // Use the shader program
     glUseProgram(shaderProgram);
 
-    // For each entity in the scene that has a mesh
-    for (const Entity& entity : scene.getEntities()) {
-        // Check if the entity has the necessary components
-        if (!meshManager.isValid(entity) || !transformManager.isValid(entity) || !materialManager.isValid(entity)) {
-            continue; // Skip if entity doesn't have required components
-        }
+    // Collect what to draw first, so the model and MVP matrices can be computed in batches
+    drawItems.clear();
+    transformIndices.clear();
+    auto collect = [&](size_t meshIndex, size_t transformIndex, size_t materialIndex) {
+        drawItems.push_back({ meshIndex, materialIndex });
+        transformIndices.push_back(transformIndex);
+    };
+
+    // For each entity in the scene that has a mesh, a transform and a material. The owning
+    // group (if the application created one) keeps them in the same slots in all three.
+    if (const auto* group = scene.findGroup<MeshComponentManager, TransformComponentManager, MaterialComponentManager>()) {
+        group->each([&](Entity, size_t index) { collect(index, index, index); });
+    } else {
+        scene.view<MeshComponentManager, TransformComponentManager, MaterialComponentManager>().each(
+            [&](Entity, size_t meshIndex, size_t transformIndex, size_t materialIndex) {
+            collect(meshIndex, transformIndex, materialIndex);
+        });
+    }
+
+    worldTransforms.resize(transformIndices.size());
+    transformManager.getInterpolatedWorldTransformsAt(transformIndices, alpha, worldTransforms, interpolationScratch);
+    modelMatrices.resize(worldTransforms.size());
+    std::transform(worldTransforms.begin(), worldTransforms.end(), modelMatrices.begin(),
+                   [](const Matrix3x4& world) { return world.toMatrix4x4(); });
 
+    Matrix4x4 viewProjectionMatrix = projectionMatrix * viewMatrix;
+    mvpMatrices.resize(modelMatrices.size());
+    Matrix4x4::multiplyArrays(viewProjectionMatrix, modelMatrices.data(), mvpMatrices.data(), modelMatrices.size());
+
+    for (size_t i = 0; i < drawItems.size(); ++i) {
         // Get the mesh data (vertices, indices)
-        auto vertices = meshManager.getVertices(entity);
-        auto indices = meshManager.getIndices(entity);
+        const std::vector<Vector3>& vertices = meshManager.getVerticesAt(drawItems[i].meshIndex);
+        const std::vector<uint32_t>& indices = meshManager.getIndicesAt(drawItems[i].meshIndex);
 
         // Get the material data (diffuse color)
-        Vector3 diffuseColor = materialManager.getDiffuseColor(entity);
-
-        // Get the transform data (model matrix)
-        Matrix4x4 modelMatrix = transformManager.getWorldTransform(entity);
+        const Vector3& diffuseColor = materialManager.getDiffuseColorAt(drawItems[i].materialIndex);
 
-        // Set shader uniforms (MVP matrix, diffuse color)
-        Matrix4x4 mvpMatrix = projectionMatrix * viewMatrix * modelMatrix;
-        glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "uMVP"), 1, GL_FALSE, mvpMatrix.data());
+        // Set shader uniforms (MVP matrix, diffuse color); matrices are stored row by row
+        glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "uMVP"), 1, GL_TRUE, mvpMatrices[i].data());
         glUniform3fv(glGetUniformLocation(shaderProgram, "uDiffuseColor"), 1, &diffuseColor.x);
 
         // Set up vertex buffers (VBOs) and index buffers (EBOs) for the mesh
@@ -0,0 +1,193 @@
+#include <virealis/Systems/SystemScheduler.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+
+namespace virealis {
+
+namespace {
+    bool intersects(const std::vector<TypeId>& a, const std::vector<TypeId>& b) {
+        for (TypeId id : a) {
+            if (std::find(b.begin(), b.end(), id) != b.end()) {
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+bool SystemAccess::conflictsWith(const SystemAccess& other) const {
+    return intersects(writes, other.writes) ||
+           intersects(writes, other.reads) ||
+           intersects(reads, other.writes);
+}
+
+SystemScheduler::SystemScheduler(ThreadPool& threadPool) : threadPool(threadPool), commandBuffers(threadPool) {}
+
+void SystemScheduler::addSystem(const std::string& name, const SystemAccess& access,
+                                SystemFunction function, bool mainThreadOnly) {
+    systems.push_back({ name, access, std::move(function), mainThreadOnly, {}, 0 });
+    timings.push_back({ name, 0.0 });
+    graphDirty = true;
+}
+
+void SystemScheduler::addSyncPoint() {
+    if (phaseStarts.back() != systems.size()) {
+        phaseStarts.push_back(systems.size());
+        graphDirty = true;
+    }
+}
+
+CommandBuffer& SystemScheduler::getCommandBuffer() {
+    return commandBuffers.local();
+}
+
+void SystemScheduler::buildGraph() {
+    for (System& system : systems) {
+        system.dependents.clear();
+        system.dependencyCount = 0;
+    }
+
+    // Phases run one after another, so dependencies only link systems of the same phase
+    for (size_t phase = 0; phase < phaseStarts.size(); ++phase) {
+        size_t begin = phaseStarts[phase];
+        size_t end = phase + 1 < phaseStarts.size() ? phaseStarts[phase + 1] : systems.size();
+        for (size_t later = begin; later < end; ++later) {
+            for (size_t earlier = begin; earlier < later; ++earlier) {
+                if (systems[earlier].access.conflictsWith(systems[later].access)) {
+                    systems[earlier].dependents.push_back(later);
+                    systems[later].dependencyCount++;
+                }
+            }
+        }
+    }
+    graphDirty = false;
+}
+
+void SystemScheduler::run(Scene& scene) {
+    if (graphDirty) {
+        buildGraph();
+    }
+
+    std::exception_ptr error;
+    for (size_t phase = 0; phase < phaseStarts.size(); ++phase) {
+        size_t end = phase + 1 < phaseStarts.size() ? phaseStarts[phase + 1] : systems.size();
+        runPhase(scene, phaseStarts[phase], end, error);
+
+        // Every system of the phase has finished, so nothing is iterating the managers
+        try {
+            commandBuffers.playback(scene);
+        } catch (...) {
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+void SystemScheduler::runPhase(Scene& scene, size_t first, size_t last, std::exception_ptr& error) {
+    if (first == last) {
+        return;
+    }
+
+    std::unique_ptr<std::atomic<size_t>[]> unfinishedDependencies(new std::atomic<size_t>[systems.size()]);
+    for (size_t i = first; i < last; ++i) {
+        unfinishedDependencies[i].store(systems[i].dependencyCount, std::memory_order_relaxed);
+    }
+    // Main-thread systems are handed back to the caller through this queue. remaining is
+    // only touched under the mutex, and the last system notifies while holding it, so the
+    // caller cannot see zero and destroy these while a worker still uses them.
+    std::mutex mainThreadMutex;
+    std::condition_variable mainThreadCondition;
+    std::vector<size_t> mainThreadQueue;
+    size_t remaining = last - first;
+
+    std::mutex errorMutex;
+
+    std::function<void(size_t)> launch;
+    auto execute = [&](size_t index) {
+        System& system = systems[index];
+        auto start = std::chrono::steady_clock::now();
+        try {
+            system.function(scene);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+        auto end = std::chrono::steady_clock::now();
+        timings[index].milliseconds = std::chrono::duration<double, std::milli>(end - start).count();
+
+        for (size_t dependent : system.dependents) {
+            if (unfinishedDependencies[dependent].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                launch(dependent);
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(mainThreadMutex);
+        if (--remaining == 0) {
+            mainThreadCondition.notify_all();
+        }
+    };
+
+    launch = [&](size_t index) {
+        if (systems[index].mainThreadOnly) {
+            {
+                std::lock_guard<std::mutex> lock(mainThreadMutex);
+                mainThreadQueue.push_back(index);
+            }
+            mainThreadCondition.notify_all();
+        } else {
+            threadPool.submit([&execute, index] { execute(index); });
+        }
+    };
+
+    for (size_t i = first; i < last; ++i) {
+        if (systems[i].dependencyCount == 0) {
+            launch(i);
+        }
+    }
+
+    // The calling thread runs main-thread systems and otherwise helps with pool work
+    while (true) {
+        size_t next = ThreadPool::npos;
+        {
+            std::lock_guard<std::mutex> lock(mainThreadMutex);
+            if (remaining == 0) {
+                break;
+            }
+            if (!mainThreadQueue.empty()) {
+                next = mainThreadQueue.back();
+                mainThreadQueue.pop_back();
+            }
+        }
+        if (next != ThreadPool::npos) {
+            execute(next);
+            continue;
+        }
+        if (threadPool.runPendingTask()) {
+            continue;
+        }
+
+        // Wake up periodically: with no worker threads, pool tasks only run here
+        std::unique_lock<std::mutex> lock(mainThreadMutex);
+        mainThreadCondition.wait_for(lock, std::chrono::microseconds(100), [&] {
+            return !mainThreadQueue.empty() || remaining == 0;
+        });
+    }
+}
+
+const std::vector<SystemScheduler::SystemTiming>& SystemScheduler::getTimings() const {
+    return timings;
+}
+
+} // namespace virealis
@@ -0,0 +1,278 @@
+#include "Test.hpp"
+#include <virealis/Math/FastMath.hpp>
+#include <virealis/Math/Simd.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <span>
+#include <vector>
+
+using namespace virealis;
+using FastMath::Precision;
+
+namespace {
+
+constexpr float Infinity = std::numeric_limits<float>::infinity();
+constexpr float NaN = std::numeric_limits<float>::quiet_NaN();
+
+// Bounds from the table in FastMath.hpp: ulps for Precise, relative error for Fast
+struct Bound {
+    double precise;
+    double fast;
+};
+constexpr Bound SincosBound{ 2.5, 1.6e-5 };
+constexpr Bound ExpBound{ 1.0, 5.5e-6 };
+constexpr Bound RsqrtBound{ 1.5, 4.0 }; // Fast rsqrt is in ulps as well
+constexpr Bound Atan2Bound{ 3.5, 2.3e-5 };
+constexpr Bound AcosBound{ 1.5, 3.8e-5 };
+
+// Distance from the double-precision reference in units of the float spacing at it
+double ulpError(float value, double reference) {
+    const float rounded = static_cast<float>(std::fabs(reference));
+    const double spacing = std::nextafter(rounded, Infinity) - rounded;
+    return std::fabs(value - reference) / spacing;
+}
+
+double relativeError(float value, double reference) {
+    return reference == 0.0 ? std::fabs(value) : std::fabs(value - reference) / std::fabs(reference);
+}
+
+// Same float, telling signed zeros apart; any NaN matches any NaN
+bool same(float a, float b) {
+    return (std::isnan(a) && std::isnan(b)) || (a == b && std::signbit(a) == std::signbit(b));
+}
+
+// Worst error over a sweep, checked against its bound and reported for the table
+class Sweep {
+public:
+    Sweep(const char* function, Precision precision, Bound bound, bool fastInUlps = false)
+        : function(function), precision(precision),
+          limit(precision == Precision::Precise ? bound.precise : bound.fast),
+          inUlps(precision == Precision::Precise || fastInUlps) {}
+
+    void add(float value, double reference, float input) {
+        double error = inUlps ? ulpError(value, reference) : relativeError(value, reference);
+        if (!(error <= worst)) {
+            worst = error;
+            worstInput = input;
+        }
+    }
+
+    void report() const {
+        std::printf("%-8s %-7s %-7s max %.3g %s (at %g)\n", function,
+                    precision == Precision::Precise ? "Precise" : "Fast", getSimdPathName(getSimdPath()), worst,
+                    inUlps ? "ulp" : "relative", worstInput);
+        VIREALIS_CHECK(worst <= limit);
+    }
+
+private:
+    const char* function;
+    Precision precision;
+    double limit;
+    bool inUlps;
+    double worst = 0.0;
+    float worstInput = 0.0f;
+};
+
+std::vector<float> uniform(std::mt19937& rng, float low, float high, size_t count) {
+    std::uniform_real_distribution<float> distribution(low, high);
+    std::vector<float> values(count);
+    for (float& value : values) {
+        value = distribution(rng);
+    }
+    return values;
+}
+
+// Positive values spread evenly over the exponents between low and high
+std::vector<float> logUniform(std::mt19937& rng, float low, float high, size_t count) {
+    std::uniform_real_distribution<double> distribution(std::log(low), std::log(high));
+    std::vector<float> values(count);
+    for (float& value : values) {
+        value = static_cast<float>(std::exp(distribution(rng)));
+    }
+    return values;
+}
+
+// Batch results, with the single-value form checked to match on the scalar path
+void testSincos(Precision precision, std::mt19937& rng) {
+    std::vector<float> x = uniform(rng, -8192.0f, 8192.0f, 1 << 20);
+    // Next to multiples of pi/2, where the reduction cancels the most
+    for (int k = -5215; k <= 5215; k += 7) {
+        float multiple = static_cast<float>(k * 1.5707963267948966);
+        x.push_back(multiple);
+        x.push_back(std::nextafter(multiple, Infinity));
+        x.push_back(std::nextafter(multiple, -Infinity));
+    }
+    // Past the reduction's domain, where std::sin and std::cos take over
+    for (float large : { 8192.5f, 1.3e4f, 1e5f, 1e8f, -1e8f, 1e10f, 1e30f, -3e38f }) {
+        x.push_back(large);
+    }
+    x.push_back(1e-30f);
+    x.push_back(-1e-40f);
+
+    std::vector<float> sines(x.size()), cosines(x.size());
+    FastMath::sincos(x, sines, cosines, precision);
+    Sweep sineSweep("sin", precision, SincosBound);
+    Sweep cosineSweep("cos", precision, SincosBound);
+    for (size_t i = 0; i < x.size(); ++i) {
+        sineSweep.add(sines[i], std::sin(static_cast<double>(x[i])), x[i]);
+        cosineSweep.add(cosines[i], std::cos(static_cast<double>(x[i])), x[i]);
+        if (getSimdPath() == SimdPath::Scalar) {
+            float sine, cosine;
+            FastMath::sincos(x[i], sine, cosine, precision);
+            VIREALIS_CHECK(same(sine, sines[i]) && same(cosine, cosines[i]));
+        }
+    }
+    sineSweep.report();
+    cosineSweep.report();
+
+    const float special[] = { 0.0f, -0.0f, Infinity, -Infinity, NaN };
+    std::vector<float> s(std::size(special)), c(std::size(special));
+    FastMath::sincos(special, s, c, precision);
+    for (size_t i = 0; i < std::size(special); ++i) {
+        VIREALIS_CHECK(same(s[i], std::sin(special[i])));
+        VIREALIS_CHECK(same(c[i], std::cos(special[i])));
+    }
+}
+
+void testExp(Precision precision, std::mt19937& rng) {
+    std::vector<float> x = uniform(rng, -87.33f, 88.72f, 1 << 20);
+    for (float edge : { -87.3365448f, 88.7228394f, 88.72f, -1e-8f, 1e-8f }) {
+        x.push_back(edge);
+    }
+    std::vector<float> out(x.size());
+    FastMath::exp(x, out, precision);
+    Sweep sweep("exp", precision, ExpBound);
+    for (size_t i = 0; i < x.size(); ++i) {
+        sweep.add(out[i], std::exp(static_cast<double>(x[i])), x[i]);
+    }
+    sweep.report();
+
+    // Results below FLT_MIN flush to zero; beyond FLT_MAX they overflow
+    const float special[] = { 0.0f, -0.0f, Infinity, -Infinity, NaN, -90.0f, -200.0f, 89.0f, 1000.0f };
+    const float expected[] = { 1.0f, 1.0f, Infinity, 0.0f, NaN, 0.0f, 0.0f, Infinity, Infinity };
+    std::vector<float> results(std::size(special));
+    FastMath::exp(special, results, precision);
+    for (size_t i = 0; i < std::size(special); ++i) {
+        VIREALIS_CHECK(same(results[i], expected[i]));
+        VIREALIS_CHECK(same(FastMath::exp(special[i], precision), expected[i]));
+    }
+}
+
+void testRsqrt(Precision precision, std::mt19937& rng) {
+    std::vector<float> x = logUniform(rng, std::numeric_limits<float>::min(), std::numeric_limits<float>::max(),
+                                      1 << 20);
+    for (float exact : { 1.0f, 4.0f, 0.25f, std::numeric_limits<float>::min(), std::numeric_limits<float>::max() }) {
+        x.push_back(exact);
+    }
+    std::vector<float> out(x.size());
+    FastMath::rsqrt(x, out, precision);
+    Sweep sweep("rsqrt", precision, RsqrtBound, true);
+    for (size_t i = 0; i < x.size(); ++i) {
+        sweep.add(out[i], 1.0 / std::sqrt(static_cast<double>(x[i])), x[i]);
+    }
+    sweep.report();
+
+    // Fast treats subnormals as zero where it uses the x86 estimate; Precise computes
+    // them like any other value
+    const float subnormal = std::numeric_limits<float>::denorm_min() * 12345.0f;
+    const float special[] = { 0.0f, -0.0f, Infinity, NaN, -1.0f, -Infinity, subnormal };
+    std::vector<float> results(std::size(special));
+    FastMath::rsqrt(special, results, precision);
+    for (size_t i = 0; i < std::size(special); ++i) {
+        float expected = special[i] == subnormal && precision == Precision::Fast && VIREALIS_SIMD_SSE2
+                             ? Infinity
+                             : static_cast<float>(1.0 / std::sqrt(static_cast<double>(special[i])));
+        VIREALIS_CHECK(same(results[i], expected));
+        VIREALIS_CHECK(same(FastMath::rsqrt(special[i], precision), expected));
+    }
+}
+
+void testAtan2(Precision precision, std::mt19937& rng) {
+    // Every angle, at magnitudes from tiny to huge, and both signs of each coordinate
+    std::vector<float> y, x;
+    std::vector<float> magnitudes = logUniform(rng, 1e-30f, 1e30f, 1 << 19);
+    std::vector<float> angles = uniform(rng, -3.14159265f, 3.14159265f, magnitudes.size());
+    for (size_t i = 0; i < magnitudes.size(); ++i) {
+        y.push_back(static_cast<float>(magnitudes[i] * std::sin(static_cast<double>(angles[i]))));
+        x.push_back(static_cast<float>(magnitudes[i] * std::cos(static_cast<double>(angles[i]))));
+    }
+    // Dense in y over a fixed x, which walks t = |y| / |x| through every reduction interval
+    for (float value = -64.0f; value <= 64.0f; value += 1.0f / 16384.0f) {
+        y.push_back(value);
+        x.push_back(1.0f);
+        y.push_back(1.0f);
+        x.push_back(value);
+    }
+    // Pairs of moderate coordinates, where the division rounds against the polynomial;
+    // the worst pair a longer search found (3.19 ulp) comes last
+    std::vector<float> ys = uniform(rng, -20.0f, 20.0f, 1 << 22);
+    std::vector<float> xs = uniform(rng, -20.0f, 20.0f, ys.size());
+    y.insert(y.end(), ys.begin(), ys.end());
+    x.insert(x.end(), xs.begin(), xs.end());
+    y.push_back(2.43798447f);
+    x.push_back(5.6742363f);
+
+    std::vector<float> out(y.size());
+    FastMath::atan2(y, x, out, precision);
+    Sweep sweep("atan2", precision, Atan2Bound);
+    for (size_t i = 0; i < y.size(); ++i) {
+        sweep.add(out[i], std::atan2(static_cast<double>(y[i]), static_cast<double>(x[i])), y[i]);
+    }
+    sweep.report();
+
+    const float special[] = { 0.0f, -0.0f, 1.0f, -1.0f, Infinity, -Infinity, NaN };
+    for (float a : special) {
+        for (float b : special) {
+            float result;
+            FastMath::atan2(std::span<const float>(&a, 1), std::span<const float>(&b, 1), std::span<float>(&result, 1),
+                            precision);
+            const float expected = std::atan2(a, b);
+            VIREALIS_CHECK(same(result, expected) || (std::isfinite(expected) && ulpError(result, expected) <= 1.0));
+        }
+    }
+}
+
+void testAcos(Precision precision, std::mt19937& rng) {
+    std::vector<float> x = uniform(rng, -1.0f, 1.0f, 1 << 20);
+    for (float edge : { -1.0f, 1.0f, 0.5f, -0.5f, std::nextafter(0.5f, 1.0f), std::nextafter(-1.0f, 0.0f) }) {
+        x.push_back(edge);
+    }
+    std::vector<float> out(x.size());
+    FastMath::acos(x, out, precision);
+    Sweep sweep("acos", precision, AcosBound);
+    for (size_t i = 0; i < x.size(); ++i) {
+        sweep.add(out[i], std::acos(static_cast<double>(x[i])), x[i]);
+    }
+    sweep.report();
+
+    const float special[] = { 1.0f, 1.5f, -1.5f, Infinity, -Infinity, NaN };
+    std::vector<float> results(std::size(special));
+    FastMath::acos(special, results, precision);
+    for (size_t i = 0; i < std::size(special); ++i) {
+        VIREALIS_CHECK(same(results[i], std::acos(special[i])));
+    }
+}
+
+} // namespace
+
+int main() {
+    for (SimdPath path : { SimdPath::Scalar, SimdPath::SSE, SimdPath::AVX2 }) {
+        if (setSimdPath(path) != path) {
+            std::printf("%s not supported, skipped\n", getSimdPathName(path));
+            continue;
+        }
+        for (Precision precision : { Precision::Precise, Precision::Fast }) {
+            std::mt19937 rng(1234);
+            testSincos(precision, rng);
+            testExp(precision, rng);
+            testRsqrt(precision, rng);
+            testAtan2(precision, rng);
+            testAcos(precision, rng);
+        }
+    }
+    setSimdPath(getSupportedSimdPath());
+    return test::result();
+}
@@ -0,0 +1,157 @@
+#include "Test.hpp"
+#include <virealis/Math/Matrix4x4.hpp>
+#include <virealis/Math/Simd.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace virealis;
+
+namespace {
+
+// Largest element of |a - b|
+float maxDifference(const Matrix4x4& a, const Matrix4x4& b) {
+    float difference = 0.0f;
+    for (int row = 0; row < 4; ++row) {
+        for (int col = 0; col < 4; ++col) {
+            difference = std::max(difference, std::fabs(a(row, col) - b(row, col)));
+        }
+    }
+    return difference;
+}
+
+float maxElement(const Matrix4x4& matrix) {
+    return maxDifference(matrix, Matrix4x4());
+}
+
+// How far inverse is from inverting matrix, from both sides, relative to the sizes of
+// the two: float rounding alone leaves about epsilon * |M| * |inverse(M)| in the products
+float inverseError(const Matrix4x4& matrix, const Matrix4x4& inverse) {
+    return std::max(maxDifference(matrix * inverse, Matrix4x4::identity()),
+                    maxDifference(inverse * matrix, Matrix4x4::identity())) /
+           (maxElement(matrix) * maxElement(inverse));
+}
+
+Vector3 randomVector(std::mt19937& rng, float low, float high) {
+    std::uniform_real_distribution<float> distribution(low, high);
+    return Vector3(distribution(rng), distribution(rng), distribution(rng));
+}
+
+Matrix4x4 randomRotation(std::mt19937& rng) {
+    std::uniform_real_distribution<float> angle(-3.14159265f, 3.14159265f);
+    Vector3 axis = randomVector(rng, -1.0f, 1.0f);
+    if (axis.magnitude() < 1e-3f) {
+        axis = Vector3(0.0f, 1.0f, 0.0f);
+    }
+    return Matrix4x4::rotation(angle(rng), axis.normalized());
+}
+
+Matrix4x4 randomRigid(std::mt19937& rng) {
+    return Matrix4x4::translation(randomVector(rng, -100.0f, 100.0f)) * randomRotation(rng);
+}
+
+// Rotation, non-uniform scale and translation, with a rotation before the scale too so
+// the upper 3x3 is sheared
+Matrix4x4 randomAffine(std::mt19937& rng) {
+    std::uniform_real_distribution<float> logScale(std::log(0.1f), std::log(10.0f));
+    const Vector3 scale(std::exp(logScale(rng)), std::exp(logScale(rng)), std::exp(logScale(rng)));
+    return Matrix4x4::translation(randomVector(rng, -100.0f, 100.0f)) * randomRotation(rng) *
+           Matrix4x4::scale(scale) * randomRotation(rng);
+}
+
+// Every element random, kept well conditioned by a dominant diagonal; every other one
+// is a perspective projection, the general matrix an engine actually inverts
+Matrix4x4 randomGeneral(std::mt19937& rng) {
+    std::uniform_real_distribution<float> element(-1.0f, 1.0f);
+    if (rng() % 2 == 0) {
+        std::uniform_real_distribution<float> fov(0.5f, 2.0f);
+        std::uniform_real_distribution<float> aspect(0.5f, 2.5f);
+        return Matrix4x4::perspective(fov(rng), aspect(rng), 0.1f, 100.0f) * randomRigid(rng);
+    }
+    Matrix4x4 matrix;
+    for (int row = 0; row < 4; ++row) {
+        for (int col = 0; col < 4; ++col) {
+            matrix(row, col) = element(rng) + (row == col ? 4.0f : 0.0f);
+        }
+    }
+    return matrix;
+}
+
+// Residuals from inverseError, a few epsilon
+constexpr float GeneralTolerance = 2e-6f;
+constexpr float AffineTolerance = 1e-6f;
+constexpr float RigidTolerance = 1e-6f;
+
+void testInverse(std::mt19937& rng) {
+    float worstGeneral = 0.0f, worstAffine = 0.0f, worstRigid = 0.0f;
+    for (int i = 0; i < 2000; ++i) {
+        const Matrix4x4 general = randomGeneral(rng);
+        worstGeneral = std::max(worstGeneral, inverseError(general, general.inverse()));
+
+        const Matrix4x4 affine = randomAffine(rng);
+        worstAffine = std::max(worstAffine, inverseError(affine, affine.inverseAffine()));
+        // The general inverse handles affine matrices too, and the two agree
+        worstGeneral = std::max(worstGeneral, inverseError(affine, affine.inverse()));
+
+        const Matrix4x4 rigid = randomRigid(rng);
+        worstRigid = std::max(worstRigid, inverseError(rigid, rigid.inverseRigid()));
+        worstAffine = std::max(worstAffine, inverseError(rigid, rigid.inverseAffine()));
+    }
+    std::printf("inverse  %-7s max %.3g general, %.3g affine, %.3g rigid\n", getSimdPathName(getSimdPath()),
+                worstGeneral, worstAffine, worstRigid);
+    VIREALIS_CHECK(worstGeneral <= GeneralTolerance);
+    VIREALIS_CHECK(worstAffine <= AffineTolerance);
+    VIREALIS_CHECK(worstRigid <= RigidTolerance);
+
+    // Exact cases stay exact
+    VIREALIS_CHECK(Matrix4x4::identity().inverse() == Matrix4x4::identity());
+    VIREALIS_CHECK(Matrix4x4::identity().inverseAffine() == Matrix4x4::identity());
+    VIREALIS_CHECK(Matrix4x4::identity().inverseRigid() == Matrix4x4::identity());
+    const Matrix4x4 scale = Matrix4x4::scale(Vector3(2.0f, 4.0f, 0.5f));
+    VIREALIS_CHECK(scale.inverse() == Matrix4x4::scale(Vector3(0.5f, 0.25f, 2.0f)));
+    VIREALIS_CHECK(scale.inverseAffine() == Matrix4x4::scale(Vector3(0.5f, 0.25f, 2.0f)));
+}
+
+// Batches of every length up to a few vector widths, so each kernel runs its tails,
+// both into a separate array and in place
+void testInverseArrays(std::mt19937& rng) {
+    for (size_t n = 0; n <= 19; ++n) {
+        std::vector<Matrix4x4> in(n), out(n);
+        for (Matrix4x4& matrix : in) {
+            matrix = randomGeneral(rng);
+        }
+        Matrix4x4::inverseArrays(in.data(), out.data(), n);
+        std::vector<Matrix4x4> inPlace = in;
+        Matrix4x4::inverseArrays(inPlace.data(), inPlace.data(), n);
+        for (size_t i = 0; i < n; ++i) {
+            VIREALIS_CHECK(out[i] == in[i].inverse());
+            VIREALIS_CHECK(inPlace[i] == out[i]);
+            VIREALIS_CHECK(inverseError(in[i], out[i]) <= GeneralTolerance);
+        }
+    }
+
+    // Elements past n are left alone
+    std::vector<Matrix4x4> in(5, Matrix4x4::scale(Vector3(2.0f, 2.0f, 2.0f)));
+    std::vector<Matrix4x4> out(5, Matrix4x4::identity());
+    Matrix4x4::inverseArrays(in.data(), out.data(), 3);
+    VIREALIS_CHECK(out[2] == Matrix4x4::scale(Vector3(0.5f, 0.5f, 0.5f)));
+    VIREALIS_CHECK(out[3] == Matrix4x4::identity() && out[4] == Matrix4x4::identity());
+}
+
+} // namespace
+
+int main() {
+    for (SimdPath path : { SimdPath::Scalar, SimdPath::SSE, SimdPath::AVX2 }) {
+        if (setSimdPath(path) != path) {
+            std::printf("%s not supported, skipped\n", getSimdPathName(path));
+            continue;
+        }
+        std::mt19937 rng(1234);
+        testInverse(rng);
+        testInverseArrays(rng);
+    }
+    setSimdPath(getSupportedSimdPath());
+    return test::result();
+}
@@ -0,0 +1,175 @@
+#include "Test.hpp"
+#include <virealis/Math/Quaternion.hpp>
+#include <virealis/Math/Matrix3x4.hpp>
+#include <virealis/Math/Matrix4x4.hpp>
+#include <virealis/Math/Simd.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace virealis;
+
+namespace {
+
+// The batch kernels against the scalar forms, component by component; slerpArrays is
+// documented to about 1e-6
+constexpr float SlerpTolerance = 2e-6f;
+constexpr float MatrixTolerance = 1e-6f;
+
+float maxDifference(const Quaternion& a, const Quaternion& b) {
+    return std::max({ std::fabs(a.x - b.x), std::fabs(a.y - b.y), std::fabs(a.z - b.z), std::fabs(a.w - b.w) });
+}
+
+// Slerp from a to end as given, without switching to -end when that is nearer
+Quaternion slerpTowards(const Quaternion& a, const Quaternion& end, float t) {
+    const double theta = std::acos(std::clamp(static_cast<double>(a.dot(end)), -1.0, 1.0));
+    const float ta = static_cast<float>(std::sin((1.0 - t) * theta) / std::sin(theta));
+    const float tb = static_cast<float>(std::sin(t * theta) / std::sin(theta));
+    return Quaternion(a.x * ta + end.x * tb, a.y * ta + end.y * tb, a.z * ta + end.z * tb, a.w * ta + end.w * tb);
+}
+
+// Distance from the scalar slerp. Pairs at right angles are a half turn apart, which is
+// as short one way round as the other; the sign of their rounded dot product picks the
+// way, and the kernels may round it differently, so either way counts.
+float slerpError(const Quaternion& result, const Quaternion& a, const Quaternion& b, float t) {
+    const float error = maxDifference(result, Quaternion::slerp(a, b, t));
+    if (std::fabs(a.dot(b)) > 1e-6f) {
+        return error;
+    }
+    return std::min({ error, maxDifference(result, slerpTowards(a, b, t)), maxDifference(result, slerpTowards(a, -b, t)) });
+}
+
+bool same(const Quaternion& a, const Quaternion& b) {
+    return a.x == b.x && a.y == b.y && a.z == b.z && a.w == b.w;
+}
+
+Quaternion randomRotation(std::mt19937& rng) {
+    std::normal_distribution<float> component;
+    Quaternion q(component(rng), component(rng), component(rng), component(rng));
+    return q.magnitude() < 1e-3f ? Quaternion::identity() : q.normalized();
+}
+
+Vector3 randomAxis(std::mt19937& rng) {
+    std::normal_distribution<float> component;
+    Vector3 axis(component(rng), component(rng), component(rng));
+    return axis.magnitude() < 1e-3f ? Vector3(0.0f, 0.0f, 1.0f) : axis.normalized();
+}
+
+// Pairs of every kind: random, nearly equal and nearly opposite (which slerp takes the
+// short way round), equal, opposite and at right angles
+void randomPair(std::mt19937& rng, Quaternion& a, Quaternion& b) {
+    std::uniform_real_distribution<float> logAngle(std::log(1e-7f), std::log(1e-2f));
+    a = randomRotation(rng);
+    switch (rng() % 6) {
+    case 0:
+        b = randomRotation(rng);
+        break;
+    case 1:
+        b = (a * Quaternion::fromAxisAngle(randomAxis(rng), std::exp(logAngle(rng)))).normalized();
+        break;
+    case 2:
+        b = -(a * Quaternion::fromAxisAngle(randomAxis(rng), std::exp(logAngle(rng)))).normalized();
+        break;
+    case 3:
+        b = a;
+        break;
+    case 4:
+        b = -a;
+        break;
+    default:
+        // Half of a 180 degree turn, so a . b = 0
+        b = (a * Quaternion::fromAxisAngle(randomAxis(rng), 3.14159265f)).normalized();
+        break;
+    }
+}
+
+// Batches of every length up to a few vector widths, so each kernel runs its tails
+void testSlerpArrays(std::mt19937& rng) {
+    float worst = 0.0f;
+    for (float t : { 0.0f, 0.25f, 0.5f, 0.7f, 0.999f, 1.0f }) {
+        for (size_t n = 0; n <= 19; ++n) {
+            std::vector<Quaternion> a(n), b(n), out(n);
+            for (size_t i = 0; i < n; ++i) {
+                randomPair(rng, a[i], b[i]);
+            }
+            Quaternion::slerpArrays(a.data(), b.data(), t, out.data(), n);
+            for (size_t i = 0; i < n; ++i) {
+                worst = std::max(worst, slerpError(out[i], a[i], b[i], t));
+            }
+
+            // In place over either input, with the same results
+            std::vector<Quaternion> overA = a, overB = b;
+            Quaternion::slerpArrays(overA.data(), b.data(), t, overA.data(), n);
+            Quaternion::slerpArrays(a.data(), overB.data(), t, overB.data(), n);
+            for (size_t i = 0; i < n; ++i) {
+                VIREALIS_CHECK(same(overA[i], out[i]));
+                VIREALIS_CHECK(same(overB[i], out[i]));
+            }
+        }
+    }
+
+    // A long batch, mostly through the vector loop
+    std::vector<Quaternion> a(1000), b(1000), out(1000);
+    for (size_t i = 0; i < a.size(); ++i) {
+        randomPair(rng, a[i], b[i]);
+    }
+    Quaternion::slerpArrays(a.data(), b.data(), 0.3f, out.data(), a.size());
+    for (size_t i = 0; i < a.size(); ++i) {
+        worst = std::max(worst, slerpError(out[i], a[i], b[i], 0.3f));
+    }
+    std::printf("slerpArrays        %-7s max %.3g\n", getSimdPathName(getSimdPath()), worst);
+    VIREALIS_CHECK(worst <= SlerpTolerance);
+
+    // Elements past n are left alone
+    const Quaternion marker(2.0f, 2.0f, 2.0f, 2.0f);
+    std::fill(out.begin(), out.end(), marker);
+    Quaternion::slerpArrays(a.data(), b.data(), 0.5f, out.data(), 3);
+    VIREALIS_CHECK(same(out[3], marker));
+}
+
+void testToRotationMatrices(std::mt19937& rng) {
+    float worst = 0.0f;
+    for (size_t n = 0; n <= 19; ++n) {
+        std::vector<Quaternion> in(n);
+        for (Quaternion& q : in) {
+            q = randomRotation(rng);
+        }
+        // Filled with a marker, to catch writes past n
+        std::vector<Matrix3x4> out(n + 1, Matrix3x4::identity());
+        Quaternion::toRotationMatrices(in.data(), out.data(), n);
+        for (size_t i = 0; i < n; ++i) {
+            const Matrix4x4 expected = in[i].toRotationMatrix();
+            for (int row = 0; row < 3; ++row) {
+                for (int col = 0; col < 4; ++col) {
+                    worst = std::max(worst, std::fabs(out[i](row, col) - expected(row, col)));
+                }
+            }
+        }
+        VIREALIS_CHECK(out[n] == Matrix3x4::identity());
+    }
+    std::printf("toRotationMatrices %-7s max %.3g\n", getSimdPathName(getSimdPath()), worst);
+    VIREALIS_CHECK(worst <= MatrixTolerance);
+
+    const Quaternion identity = Quaternion::identity();
+    Matrix3x4 matrix;
+    Quaternion::toRotationMatrices(&identity, &matrix, 1);
+    VIREALIS_CHECK(matrix == Matrix3x4::identity());
+}
+
+} // namespace
+
+int main() {
+    for (SimdPath path : { SimdPath::Scalar, SimdPath::SSE, SimdPath::AVX2 }) {
+        if (setSimdPath(path) != path) {
+            std::printf("%s not supported, skipped\n", getSimdPathName(path));
+            continue;
+        }
+        std::mt19937 rng(1234);
+        testSlerpArrays(rng);
+        testToRotationMatrices(rng);
+    }
+    setSimdPath(getSupportedSimdPath());
+    return test::result();
+}
@@ -0,0 +1,132 @@
+#include "Test.hpp"
+#include <virealis/Components/MaterialComponentManager.hpp>
+#include <virealis/Systems/SystemScheduler.hpp>
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace virealis;
+
+namespace {
+
+// Access tags only; the scheduler never looks the managers up
+struct ResourceA {};
+struct ResourceB {};
+
+// Many short worker-only systems, run many times: the last system to finish races the
+// caller leaving run(), which is where a scheduler keeping its sync state on the stack
+// breaks (run this under ThreadSanitizer to see it)
+void testWorkerOnlyStress() {
+    ThreadPool threadPool(4);
+    SystemScheduler scheduler(threadPool);
+
+    constexpr size_t SystemCount = 24;
+    constexpr int Runs = 2000;
+    std::vector<std::atomic<int>> runCounts(SystemCount);
+    std::atomic<int> chainStep{0};
+    std::atomic<bool> chainInOrder{true};
+
+    for (size_t i = 0; i < SystemCount; ++i) {
+        SystemAccess access;
+        if (i % 3 == 0) {
+            access.write<ResourceA>(); // A chain that has to run in registration order
+        } else if (i % 3 == 1) {
+            access.read<ResourceB>();
+        }
+        scheduler.addSystem("system " + std::to_string(i), access, [&, i](Scene&) {
+            runCounts[i].fetch_add(1, std::memory_order_relaxed);
+            if (i % 3 == 0 && chainStep.exchange(static_cast<int>(i / 3) + 1) != static_cast<int>(i / 3)) {
+                chainInOrder = false;
+            }
+        });
+    }
+
+    Scene scene;
+    for (int run = 0; run < Runs; ++run) {
+        chainStep = 0;
+        scheduler.run(scene);
+    }
+
+    for (size_t i = 0; i < SystemCount; ++i) {
+        VIREALIS_CHECK(runCounts[i].load() == Runs);
+    }
+    VIREALIS_CHECK(chainInOrder.load());
+}
+
+// With no worker threads everything runs on the caller
+void testNoWorkers() {
+    ThreadPool threadPool(0);
+    SystemScheduler scheduler(threadPool);
+    int order = 0;
+    int first = -1;
+    int second = -1;
+    scheduler.addSystem("first", SystemAccess().write<ResourceA>(), [&](Scene&) { first = order++; });
+    scheduler.addSystem("second", SystemAccess().read<ResourceA>(), [&](Scene&) { second = order++; }, true);
+
+    Scene scene;
+    scheduler.run(scene);
+    VIREALIS_CHECK(first == 0);
+    VIREALIS_CHECK(second == 1);
+}
+
+void testExceptionRethrownAfterOthersRun() {
+    ThreadPool threadPool(2);
+    SystemScheduler scheduler(threadPool);
+    std::atomic<int> ran{0};
+    scheduler.addSystem("throws", SystemAccess(), [](Scene&) { throw std::runtime_error("system failed"); });
+    for (int i = 0; i < 8; ++i) {
+        scheduler.addSystem("runs", SystemAccess(), [&](Scene&) { ran++; });
+    }
+
+    Scene scene;
+    bool threw = false;
+    try {
+        scheduler.run(scene);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    VIREALIS_CHECK(threw);
+    VIREALIS_CHECK(ran.load() == 8);
+}
+
+// Entities recorded by worker systems appear at the sync point, before the next phase
+void testCommandBuffersAtSyncPoints() {
+    ThreadPool threadPool(4);
+    SystemScheduler scheduler(threadPool);
+    constexpr int Spawners = 8;
+    constexpr int PerSpawner = 100;
+    for (int i = 0; i < Spawners; ++i) {
+        scheduler.addSystem("spawn", SystemAccess(), [&](Scene&) {
+            CommandBuffer& commands = scheduler.getCommandBuffer();
+            for (int j = 0; j < PerSpawner; ++j) {
+                Entity entity = commands.createEntity();
+                commands.addComponent<MaterialComponentManager>(entity, Vector3(1, 0, 0), Vector3(1, 1, 1), 8.0f,
+                                                                std::string("texture.png"), 1.0f, 0.0f);
+            }
+        });
+    }
+    scheduler.addSyncPoint();
+
+    size_t seen = 0;
+    scheduler.addSystem("count", SystemAccess().read<MaterialComponentManager>(), [&](Scene& scene) {
+        seen = scene.getMaterialManager().getEntitySet().size();
+    });
+
+    Scene scene;
+    scheduler.run(scene);
+    VIREALIS_CHECK(seen == Spawners * PerSpawner);
+    scheduler.run(scene);
+    VIREALIS_CHECK(seen == 2 * Spawners * PerSpawner);
+    VIREALIS_CHECK(scene.getEntities().size() == 2 * Spawners * PerSpawner);
+}
+
+} // namespace
+
+int main() {
+    testWorkerOnlyStress();
+    testNoWorkers();
+    testExceptionRethrownAfterOthersRun();
+    testCommandBuffersAtSyncPoints();
+    return test::result();
+}
@@ -0,0 +1,36 @@
+#ifndef VIREALIS_TEST_H
+#define VIREALIS_TEST_H
+
+#include <cmath>
+#include <iostream>
+
+namespace virealis::test {
+
+inline int failureCount = 0;
+
+// Records a failed check without stopping, so one run reports every failure
+inline void check(bool condition, const char* expression, const char* file, int line) {
+    if (!condition) {
+        std::cerr << file << ":" << line << ": check failed: " << expression << std::endl;
+        failureCount++;
+    }
+}
+
+inline bool near(float a, float b, float tolerance = 1e-5f) {
+    return std::fabs(a - b) <= tolerance;
+}
+
+// Exit status for main(): zero when every check passed
+inline int result() {
+    if (failureCount > 0) {
+        std::cerr << failureCount << " check(s) failed" << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+} // namespace virealis::test
+
+#define VIREALIS_CHECK(condition) ::virealis::test::check((condition), #condition, __FILE__, __LINE__)
+
+#endif // VIREALIS_TEST_H
@@ -0,0 +1,357 @@
+#include "Test.hpp"
+#include <virealis/Components/MeshComponentManager.hpp>
+#include <virealis/Components/TransformComponentManager.hpp>
+#include <virealis/Scene/Group.hpp>
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace virealis;
+
+namespace {
+
+bool finite(const Quaternion& q) {
+    return std::isfinite(q.x) && std::isfinite(q.y) && std::isfinite(q.z) && std::isfinite(q.w);
+}
+
+bool nearMatrix(const Matrix4x4& a, const Matrix4x4& b, float tolerance = 1e-5f) {
+    for (int row = 0; row < 4; ++row) {
+        for (int column = 0; column < 4; ++column) {
+            if (!test::near(a(row, column), b(row, column), tolerance)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+Matrix4x4 makeLocal(const Vector3& scale) {
+    return Matrix4x4::translation(Vector3(1.0f, -2.0f, 3.0f)) *
+           Matrix4x4::rotation(0.7f, Vector3(1.0f, 2.0f, -0.5f).normalized()) * Matrix4x4::scale(scale);
+}
+
+// Decomposing a matrix with collapsed axes keeps their scale at zero and still yields a
+// unit rotation, which recomposes to the same matrix
+void testZeroScaleDecompose() {
+    const Vector3 scales[] = {
+        Vector3(0.0f, 0.0f, 0.0f), Vector3(2.0f, 3.0f, 0.0f), Vector3(0.0f, 3.0f, 0.5f),
+        Vector3(0.0f, 0.0f, 4.0f), Vector3(2.0f, 0.0f, 0.0f), Vector3(-1.0f, 2.0f, 3.0f),
+    };
+
+    TransformComponentManager transforms;
+    uint32_t next = 0;
+    for (const Vector3& scale : scales) {
+        Entity entity{ next++, 0 };
+        Matrix4x4 local = makeLocal(scale);
+        transforms.create(entity, local);
+        transforms.updateTransforms();
+
+        Quaternion rotation = transforms.getRotation(entity);
+        Vector3 decomposed = transforms.getScale(entity);
+        VIREALIS_CHECK(finite(rotation));
+        VIREALIS_CHECK(test::near(rotation.magnitude(), 1.0f));
+        VIREALIS_CHECK(test::near(std::abs(decomposed.x), std::abs(scale.x)));
+        VIREALIS_CHECK(test::near(decomposed.y, scale.y));
+        VIREALIS_CHECK(test::near(decomposed.z, scale.z));
+        VIREALIS_CHECK(nearMatrix(transforms.getWorldTransform(entity), local));
+    }
+
+    // Same through setLocalTransform on an existing node
+    Entity entity{ next++, 0 };
+    transforms.create(entity, Vector3(0.0f, 0.0f, 0.0f));
+    transforms.setLocalTransform(entity, makeLocal(Vector3(0.0f, 1.5f, 0.0f)));
+    transforms.updateTransforms();
+    VIREALIS_CHECK(finite(transforms.getRotation(entity)));
+    VIREALIS_CHECK(test::near(transforms.getScale(entity).x, 0.0f));
+    VIREALIS_CHECK(nearMatrix(transforms.getWorldTransform(entity), makeLocal(Vector3(0.0f, 1.5f, 0.0f))));
+}
+
+// Halfway through a quarter turn, the interpolated basis is still a rotation (times the
+// node's scale), not the shrunken element-wise blend of the two matrices
+void testInterpolatedBasisStaysOrthonormal() {
+    TransformComponentManager transforms;
+    Entity entity{ 0, 0 };
+    const float scale = 2.0f;
+    const Vector3 axis(0.0f, 1.0f, 0.0f);
+    transforms.create(entity, Vector3(0.0f, 0.0f, 0.0f), Quaternion::identity(), Vector3(scale, scale, scale));
+    transforms.updateTransforms();
+
+    transforms.swapTransformBuffers();
+    transforms.setPosition(entity, Vector3(4.0f, 0.0f, 0.0f));
+    transforms.setRotation(entity, Quaternion::fromAxisAngle(axis, 1.5707963f));
+    transforms.updateTransforms();
+
+    for (float alpha : { 0.0f, 0.25f, 0.5f, 0.75f, 1.0f }) {
+        Matrix4x4 world = transforms.getInterpolatedWorldTransform(entity, alpha);
+        Vector3 columns[3];
+        for (int column = 0; column < 3; ++column) {
+            columns[column] = Vector3(world(0, column), world(1, column), world(2, column)) / scale;
+            VIREALIS_CHECK(test::near(columns[column].magnitude(), 1.0f));
+        }
+        VIREALIS_CHECK(test::near(columns[0].dot(columns[1]), 0.0f));
+        VIREALIS_CHECK(test::near(columns[1].dot(columns[2]), 0.0f));
+        VIREALIS_CHECK(test::near(columns[2].dot(columns[0]), 0.0f));
+        VIREALIS_CHECK(test::near(columns[0].cross(columns[1]).dot(columns[2]), 1.0f));
+        VIREALIS_CHECK(test::near(world(0, 3), 4.0f * alpha));
+
+        Matrix4x4 expected = Matrix4x4::translation(Vector3(4.0f * alpha, 0.0f, 0.0f)) *
+                             Quaternion::fromAxisAngle(axis, 1.5707963f * alpha).toRotationMatrix() *
+                             Matrix4x4::scale(Vector3(scale, scale, scale));
+        VIREALIS_CHECK(nearMatrix(world, expected));
+    }
+}
+
+// A child turning under a non-uniformly scaled parent has a sheared world; interpolation
+// still lands on both steps, bit for bit at alpha 0 and 1
+void testInterpolationKeepsShearedEndpoints() {
+    TransformComponentManager transforms;
+    Entity parent{ 0, 0 };
+    Entity child{ 1, 0 };
+    const Vector3 axis(0.0f, 0.0f, 1.0f);
+    transforms.create(parent, Vector3(0.0f, 0.0f, 0.0f), Quaternion::identity(), Vector3(1.0f, 3.0f, 1.0f));
+    transforms.create(child, Vector3(1.0f, 0.0f, 0.0f), Quaternion::fromAxisAngle(axis, 0.3f));
+    transforms.setParent(child, parent);
+    transforms.updateTransforms();
+    Matrix4x4 before = transforms.getWorldTransform(child);
+
+    transforms.swapTransformBuffers();
+    transforms.setRotation(child, Quaternion::fromAxisAngle(axis, 1.2f));
+    transforms.updateTransforms();
+    Matrix4x4 after = transforms.getWorldTransform(child);
+
+    VIREALIS_CHECK(transforms.getInterpolatedWorldTransform(child, 0.0f) == before);
+    VIREALIS_CHECK(transforms.getInterpolatedWorldTransform(child, 1.0f) == after);
+    VIREALIS_CHECK(transforms.getInterpolatedWorldTransform(child, -0.5f) == before);
+    VIREALIS_CHECK(transforms.getInterpolatedWorldTransform(child, 1.5f) == after);
+    VIREALIS_CHECK(nearMatrix(transforms.getInterpolatedWorldTransform(child, 0.999999f), after, 1e-4f));
+}
+
+// The batch form renderers use agrees with the single one on every SIMD path: exactly for
+// nodes that did not move and at the endpoints, and to the batch slerp's accuracy between
+void testBatchInterpolationMatchesSingle() {
+    TransformComponentManager transforms;
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> coordinate(-5.0f, 5.0f);
+    std::uniform_real_distribution<float> scale(0.5f, 2.0f);
+    std::uniform_real_distribution<float> angle(-3.0f, 3.0f);
+    auto randomRotation = [&] {
+        return Quaternion::fromAxisAngle(Vector3(coordinate(rng), coordinate(rng), 1.0f).normalized(), angle(rng));
+    };
+
+    // Chains of four, non-uniformly scaled so the deeper worlds are sheared
+    constexpr uint32_t NodeCount = 40;
+    for (uint32_t i = 0; i < NodeCount; ++i) {
+        Entity entity{ i, 0 };
+        transforms.create(entity, Vector3(coordinate(rng), coordinate(rng), coordinate(rng)), randomRotation(),
+                          Vector3(scale(rng), scale(rng), scale(rng)));
+        if (i % 4 != 0) {
+            transforms.setParent(entity, Entity{ i - 1, 0 });
+        }
+    }
+    transforms.updateTransforms();
+
+    // Every third chain stays put
+    transforms.swapTransformBuffers();
+    for (uint32_t i = 0; i < NodeCount; ++i) {
+        if ((i / 4) % 3 != 0) {
+            transforms.setRotation(Entity{ i, 0 }, randomRotation());
+            transforms.setPosition(Entity{ i, 0 }, Vector3(coordinate(rng), coordinate(rng), coordinate(rng)));
+        }
+    }
+    transforms.updateTransforms();
+
+    // Every slot, plus a few again in another order
+    std::vector<size_t> indices(NodeCount);
+    for (size_t i = 0; i < indices.size(); ++i) {
+        indices[i] = i;
+    }
+    indices.insert(indices.end(), { 39, 5, 5, 0, 17 });
+
+    TransformComponentManager::InterpolationScratch scratch;
+    std::vector<Matrix3x4> worlds(indices.size());
+    for (SimdPath path : { SimdPath::Scalar, SimdPath::SSE, SimdPath::AVX2 }) {
+        if (setSimdPath(path) != path) {
+            continue;
+        }
+        for (float alpha : { -0.5f, 0.0f, 0.3f, 0.5f, 0.999f, 1.0f, 1.5f }) {
+            transforms.getInterpolatedWorldTransformsAt(indices, alpha, worlds, scratch);
+            for (size_t i = 0; i < indices.size(); ++i) {
+                const Matrix3x4 expected = transforms.getInterpolatedWorldTransformAt(indices[i], alpha);
+                const bool exact = alpha <= 0.0f || alpha >= 1.0f || (indices[i] / 4) % 3 == 0;
+                VIREALIS_CHECK(exact ? worlds[i] == expected
+                                     : nearMatrix(worlds[i].toMatrix4x4(), expected.toMatrix4x4(), 1e-4f));
+            }
+        }
+    }
+    setSimdPath(getSupportedSimdPath());
+
+    worlds.pop_back();
+    bool threw = false;
+    try {
+        transforms.getInterpolatedWorldTransformsAt(indices, 0.5f, worlds, scratch);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    VIREALIS_CHECK(threw);
+}
+
+// What a node should be, kept apart from the manager: worlds are recomputed from it
+// recursively, without the hierarchy order the manager maintains
+struct ReferenceNode {
+    std::optional<Entity> parent;
+    Vector3 position;
+    Quaternion rotation;
+    Vector3 scale;
+};
+
+struct EntityOrder {
+    bool operator()(const Entity& a, const Entity& b) const {
+        return a.index != b.index ? a.index < b.index : a.generation < b.generation;
+    }
+};
+using ReferenceNodes = std::map<Entity, ReferenceNode, EntityOrder>;
+
+Matrix4x4 referenceWorld(const ReferenceNodes& nodes, Entity entity) {
+    const ReferenceNode& node = nodes.at(entity);
+    Matrix4x4 local = Matrix4x4::translation(node.position) * node.rotation.toRotationMatrix() *
+                      Matrix4x4::scale(node.scale);
+    return node.parent ? referenceWorld(nodes, *node.parent) * local : local;
+}
+
+bool isAncestor(const ReferenceNodes& nodes, Entity ancestor, Entity entity) {
+    for (std::optional<Entity> node = entity; node; node = nodes.at(*node).parent) {
+        if (*node == ancestor) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Random creates, reparents, unparents, destroys and subtree destroys, each followed by
+// a check of every world against the reference. The hierarchy order is patched in place
+// by these edits, so every few steps all nodes are marked dirty to force the level by
+// level pass that reads it. With grouped set, an owning Mesh+Transform group also
+// reorders the transform slots as meshes come and go.
+void testRandomHierarchyEdits(bool grouped) {
+    TransformComponentManager transforms;
+    MeshComponentManager meshes;
+    std::optional<Group<MeshComponentManager, TransformComponentManager>> group;
+    if (grouped) {
+        group.emplace(meshes, transforms);
+    }
+
+    std::mt19937 rng(grouped ? 11 : 7);
+    std::uniform_real_distribution<float> offset(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> angle(-3.0f, 3.0f);
+    std::uniform_real_distribution<float> scale(0.8f, 1.25f);
+    auto randomNode = [&]() {
+        return ReferenceNode{ std::nullopt, Vector3(offset(rng), offset(rng), offset(rng)),
+                              Quaternion::fromAxisAngle(Vector3(offset(rng), 1.0f, offset(rng)).normalized(), angle(rng)),
+                              Vector3(scale(rng), scale(rng), scale(rng)) };
+    };
+    auto pick = [&](const ReferenceNodes& nodes) {
+        auto it = nodes.begin();
+        std::advance(it, rng() % nodes.size());
+        return it->first;
+    };
+
+    ReferenceNodes nodes;
+    uint32_t nextIndex = 0;
+    int mismatches = 0;
+    for (int step = 0; step < 4000; ++step) {
+        const unsigned operation = rng() % 16;
+        if (nodes.size() < 8 || operation < 4) {
+            Entity entity{ nextIndex++, 0 };
+            ReferenceNode node = randomNode();
+            transforms.create(entity, node.position, node.rotation, node.scale);
+            nodes[entity] = node;
+        } else if (operation < 8) {
+            Entity child = pick(nodes);
+            Entity parent = pick(nodes);
+            if (isAncestor(nodes, child, parent)) {
+                bool threw = false;
+                try {
+                    transforms.setParent(child, parent);
+                } catch (const std::runtime_error&) {
+                    threw = true;
+                }
+                VIREALIS_CHECK(threw);
+            } else {
+                transforms.setParent(child, parent);
+                nodes[child].parent = parent;
+            }
+        } else if (operation < 9) {
+            Entity entity = pick(nodes);
+            transforms.removeParent(entity);
+            nodes[entity].parent.reset();
+        } else if (operation < 11) {
+            // The children of a destroyed node become roots
+            Entity entity = pick(nodes);
+            transforms.destroy(entity);
+            meshes.destroy(entity);
+            nodes.erase(entity);
+            for (auto& [other, node] : nodes) {
+                if (node.parent == entity) {
+                    node.parent.reset();
+                }
+            }
+        } else if (operation < 12) {
+            Entity root = pick(nodes);
+            transforms.destroySubtree(root);
+            std::vector<Entity> removed;
+            for (const auto& [entity, node] : nodes) {
+                if (isAncestor(nodes, root, entity)) {
+                    removed.push_back(entity);
+                }
+            }
+            for (Entity entity : removed) {
+                meshes.destroy(entity);
+                nodes.erase(entity);
+            }
+        } else if (operation < 14) {
+            Entity entity = pick(nodes);
+            ReferenceNode moved = randomNode();
+            transforms.setPosition(entity, moved.position);
+            transforms.setRotation(entity, moved.rotation);
+            nodes[entity].position = moved.position;
+            nodes[entity].rotation = moved.rotation;
+        } else if (grouped) {
+            // Joining or leaving the group swaps the transform's slot
+            Entity entity = pick(nodes);
+            if (meshes.getEntitySet().contains(entity)) {
+                meshes.destroy(entity);
+            } else {
+                meshes.create(entity, { Vector3(0.0f, 0.0f, 0.0f) }, { 0 }, { Vector3(0.0f, 1.0f, 0.0f) });
+            }
+        }
+
+        if (step % 5 == 0) {
+            for (const auto& [entity, node] : nodes) {
+                transforms.setPosition(entity, node.position);
+            }
+        }
+        transforms.updateTransforms();
+        for (const auto& [entity, node] : nodes) {
+            if (!nearMatrix(transforms.getWorldTransform(entity), referenceWorld(nodes, entity), 1e-3f)) {
+                mismatches++;
+            }
+        }
+    }
+    VIREALIS_CHECK(mismatches == 0);
+}
+
+} // namespace
+
+int main() {
+    testZeroScaleDecompose();
+    testInterpolatedBasisStaysOrthonormal();
+    testInterpolationKeepsShearedEndpoints();
+    testBatchInterpolationMatchesSingle();
+    testRandomHierarchyEdits(false);
+    testRandomHierarchyEdits(true);
+    return test::result();
+}